@@ -42,5 +42,17 @@ namespace NextGenSpice.Core.BehaviorParams
 				(1 - Math.Exp(-(FallDelay - RiseDelay) / RiseTau)) *
 				Math.Exp(-(timepoint - FallDelay) / FallTau));
 		}
+
+		/// <summary>
+		///   Gets the first timepoint after given timepoint at which the waveform or its derivative is not continuous.
+		/// </summary>
+		/// <param name="timepoint">The time value after which to search.</param>
+		/// <returns>The timepoint or positive infinity if the waveform is smooth after given timepoint.</returns>
+		public override double GetNextBreakpoint(double timepoint)
+		{
+			if (RiseDelay > timepoint) return RiseDelay;
+			if (FallDelay > timepoint) return FallDelay;
+			return double.PositiveInfinity;
+		}
 	}
 }
\ No newline at end of file
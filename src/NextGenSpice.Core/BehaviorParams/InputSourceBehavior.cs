@@ -17,5 +17,15 @@ namespace NextGenSpice.Core.BehaviorParams
 		/// <param name="timepoint">The time value for which to calculate the value.</param>
 		/// <returns></returns>
 		public abstract double GetValue(double timepoint);
+
+		/// <summary>
+		///   Gets the first timepoint after given timepoint at which the waveform or its derivative is not continuous.
+		/// </summary>
+		/// <param name="timepoint">The time value after which to search.</param>
+		/// <returns>The timepoint or positive infinity if the waveform is smooth after given timepoint.</returns>
+		public virtual double GetNextBreakpoint(double timepoint)
+		{
+			return double.PositiveInfinity;
+		}
 	}
 }
\ No newline at end of file
@@ -54,5 +54,39 @@ namespace NextGenSpice.Core.BehaviorParams
 			return MathHelper.LinearInterpolation(values[i - 1], values[i],
 				(time - timepoints[i - 1]) / (timepoints[i] - timepoints[i - 1]));
 		}
+
+		/// <summary>
+		///   Gets the first timepoint after given timepoint at which the waveform or its derivative is not continuous.
+		/// </summary>
+		/// <param name="timepoint">The time value after which to search.</param>
+		/// <returns>The timepoint or positive infinity if the waveform is smooth after given timepoint.</returns>
+		public override double GetNextBreakpoint(double timepoint)
+		{
+			if (timepoints == null || timepoints.Count == 0) return double.PositiveInfinity;
+
+			var last = timepoints[timepoints.Count - 1];
+			if (!RepeatStart.HasValue || timepoint < last)
+			{
+				foreach (var t in timepoints)
+					if (t > timepoint)
+						return t;
+				return double.PositiveInfinity;
+			}
+
+			// the definition points after RepeatStart repeat with the period, the search starts one period earlier in
+			// case the division was rounded up
+			var rs = RepeatStart.Value;
+			var period = last - rs;
+			var first = Math.Floor((timepoint - rs) / period) - 1;
+			for (var i = 0; i < 3; i++)
+			{
+				var offset = (first + i) * period;
+				foreach (var t in timepoints)
+					if (t >= rs && t + offset > timepoint)
+						return t + offset;
+			}
+
+			return double.PositiveInfinity;
+		}
 	}
 }
\ No newline at end of file
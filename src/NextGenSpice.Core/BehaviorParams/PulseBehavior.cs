@@ -1,4 +1,5 @@
-﻿using NextGenSpice.Numerics;
+﻿using System;
+using NextGenSpice.Numerics;
 
 namespace NextGenSpice.Core.BehaviorParams
 {
@@ -48,5 +49,42 @@ namespace NextGenSpice.Core.BehaviorParams
 					phase / TimeFall);
 			return InitialLevel;
 		}
+
+		/// <summary>
+		///   Gets the first timepoint after given timepoint at which the waveform or its derivative is not continuous.
+		/// </summary>
+		/// <param name="timepoint">The time value after which to search.</param>
+		/// <returns>The timepoint or positive infinity if the waveform is smooth after given timepoint.</returns>
+		public override double GetNextBreakpoint(double timepoint)
+		{
+			var corners = new[]
+			{
+				Delay,
+				Delay + TimeRise,
+				Delay + TimeRise + PulseWidth,
+				Delay + TimeRise + PulseWidth + TimeFall
+			};
+
+			if (!(Period > 0))
+			{
+				foreach (var corner in corners)
+					if (corner > timepoint)
+						return corner;
+				return double.PositiveInfinity;
+			}
+
+			// the waveform is cut off at the end of each period, the search starts one period earlier in case the
+			// division was rounded up
+			var first = Math.Floor(timepoint / Period) - 1;
+			for (var i = 0; i < 3; i++)
+			{
+				var start = (first + i) * Period;
+				foreach (var corner in corners)
+					if (start + Math.Min(corner, Period) > timepoint)
+						return start + Math.Min(corner, Period);
+			}
+
+			return double.PositiveInfinity;
+		}
 	}
 }
\ No newline at end of file
@@ -40,5 +40,16 @@ namespace NextGenSpice.Core.BehaviorParams
 
 			return DcOffset + Math.Sin(phase) * amplitude;
 		}
+
+		/// <summary>
+		///   Gets the first timepoint after given timepoint at which the waveform or its derivative is not continuous.
+		/// </summary>
+		/// <param name="timepoint">The time value after which to search.</param>
+		/// <returns>The timepoint or positive infinity if the waveform is smooth after given timepoint.</returns>
+		public override double GetNextBreakpoint(double timepoint)
+		{
+			// the waveform starts after the delay
+			return Delay > timepoint ? Delay : double.PositiveInfinity;
+		}
 	}
 }
\ No newline at end of file
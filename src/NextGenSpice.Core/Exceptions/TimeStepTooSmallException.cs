@@ -0,0 +1,24 @@
+using System;
+using System.Runtime.Serialization;
+
+namespace NextGenSpice.Core.Exceptions
+{
+	[Serializable]
+	public class TimeStepTooSmallException : SimulationException
+	{
+		public TimeStepTooSmallException(double timePoint) : base(
+			$"Timestep too small at time {timePoint}, the step was rejected with the minimum timestep.")
+		{
+			TimePoint = timePoint;
+		}
+
+		protected TimeStepTooSmallException(
+			SerializationInfo info,
+			StreamingContext context) : base(info, context)
+		{
+		}
+
+		/// <summary>Last accepted timepoint of the simulation.</summary>
+		public double TimePoint { get; }
+	}
+}
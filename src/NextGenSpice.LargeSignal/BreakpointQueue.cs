@@ -0,0 +1,88 @@
+using System.Collections.Generic;
+using NextGenSpice.LargeSignal.Devices;
+
+namespace NextGenSpice.LargeSignal
+{
+	/// <summary>
+	///   Priority queue of the next breakpoints of the devices, i.e. timepoints at which the waveforms of the devices are
+	///   not smooth. Each device is queried again only when its breakpoint is passed.
+	/// </summary>
+	internal class BreakpointQueue
+	{
+		private readonly ILargeSignalDevice[] devices;
+
+		// binary min-heap of the breakpoints and indices of the corresponding devices
+		private readonly List<(double time, int device)> heap;
+
+		public BreakpointQueue(ILargeSignalDevice[] devices)
+		{
+			this.devices = devices;
+			heap = new List<(double time, int device)>();
+		}
+
+		/// <summary>The earliest breakpoint in the queue, positive infinity if there is none.</summary>
+		public double Next => heap.Count > 0 ? heap[0].time : double.PositiveInfinity;
+
+		/// <summary>Queries all devices for their first breakpoints after given timepoint.</summary>
+		/// <param name="timepoint"></param>
+		public void Reset(double timepoint)
+		{
+			heap.Clear();
+			for (var i = 0; i < devices.Length; i++) Push(i, timepoint);
+		}
+
+		/// <summary>
+		///   Removes breakpoints not later than given timepoint and replaces them with the following breakpoints of the
+		///   same devices.
+		/// </summary>
+		/// <param name="timepoint"></param>
+		public void Advance(double timepoint)
+		{
+			while (heap.Count > 0 && heap[0].time <= timepoint)
+			{
+				var device = heap[0].device;
+				Pop();
+				Push(device, timepoint);
+			}
+		}
+
+		private void Push(int device, double timepoint)
+		{
+			var time = devices[device].GetNextBreakpoint(timepoint);
+			// breakpoints not after the timepoint would never be removed from the queue
+			if (!(time > timepoint) || double.IsPositiveInfinity(time)) return;
+
+			heap.Add((time, device));
+			var i = heap.Count - 1;
+			while (i > 0)
+			{
+				var parent = (i - 1) / 2;
+				if (heap[parent].time <= time) break;
+				heap[i] = heap[parent];
+				i = parent;
+			}
+
+			heap[i] = (time, device);
+		}
+
+		private void Pop()
+		{
+			var last = heap[heap.Count - 1];
+			heap.RemoveAt(heap.Count - 1);
+			if (heap.Count == 0) return;
+
+			var i = 0;
+			while (true)
+			{
+				var child = 2 * i + 1;
+				if (child >= heap.Count) break;
+				if (child + 1 < heap.Count && heap[child + 1].time < heap[child].time) child++;
+				if (last.time <= heap[child].time) break;
+				heap[i] = heap[child];
+				i = child;
+			}
+
+			heap[i] = last;
+		}
+	}
+}
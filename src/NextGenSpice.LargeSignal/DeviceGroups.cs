@@ -0,0 +1,83 @@
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using NextGenSpice.LargeSignal.Devices;
+using NextGenSpice.Numerics;
+
+namespace NextGenSpice.LargeSignal
+{
+	/// <summary>
+	///   Groups all diodes and bipolar junction transistors of the circuit, including the ones in subcircuits, by their
+	///   kind and evaluates their models for each group in a single native call. The devices then only stamp the
+	///   evaluated values.
+	/// </summary>
+	public class DeviceGroups : IDisposable
+	{
+		private readonly BjtGroupBuffer bjtBuffer;
+		private readonly LargeSignalBjt[] bjts;
+		private readonly DiodeGroupBuffer diodeBuffer;
+		private readonly LargeSignalDiode[] diodes;
+
+		/// <summary>Creates groups of given devices, the devices must be already initialized.</summary>
+		/// <param name="devices">Devices of the circuit.</param>
+		public DeviceGroups(IEnumerable<ILargeSignalDevice> devices)
+		{
+			var all = Flatten(devices).ToList();
+
+			diodes = all.OfType<LargeSignalDiode>().ToArray();
+			if (diodes.Length > 0)
+			{
+				diodeBuffer = new DiodeGroupBuffer(diodes.Length);
+				for (var i = 0; i < diodes.Length; i++) diodes[i].BindToGroup(diodeBuffer, i);
+			}
+
+			bjts = all.OfType<LargeSignalBjt>().ToArray();
+			if (bjts.Length > 0)
+			{
+				bjtBuffer = new BjtGroupBuffer(bjts.Length);
+				for (var i = 0; i < bjts.Length; i++) bjts[i].BindToGroup(bjtBuffer, i);
+			}
+		}
+
+		/// <summary>Number of devices whose models are evaluated in the groups.</summary>
+		public int DeviceCount => diodes.Length + bjts.Length;
+
+		/// <summary>Performs application-defined tasks associated with freeing, releasing, or resetting unmanaged resources.</summary>
+		public void Dispose()
+		{
+			diodeBuffer?.Dispose();
+			bjtBuffer?.Dispose();
+		}
+
+		/// <summary>
+		///   Evaluates models of all grouped devices for their current voltages, including the devices which will be
+		///   bypassed.
+		/// </summary>
+		/// <param name="context">Context of current simulation.</param>
+		public void Evaluate(ISimulationContext context)
+		{
+			if (diodeBuffer != null)
+			{
+				for (var i = 0; i < diodes.Length; i++) diodes[i].WriteGroupInputs(context);
+				diodeBuffer.Evaluate();
+			}
+
+			if (bjtBuffer != null)
+			{
+				for (var i = 0; i < bjts.Length; i++) bjts[i].WriteGroupInputs(context);
+				// capacitances are used only in transient analysis
+				bjtBuffer.Evaluate(context.TimePoint > 0);
+			}
+		}
+
+		private static IEnumerable<ILargeSignalDevice> Flatten(IEnumerable<ILargeSignalDevice> devices)
+		{
+			foreach (var device in devices)
+				if (device is ILargeSignalSubcircuit subcircuit)
+					foreach (var inner in Flatten(subcircuit.Devices))
+						yield return inner;
+				else
+					yield return device;
+		}
+	}
+}
@@ -6,9 +6,16 @@ namespace NextGenSpice.LargeSignal.Devices
 	/// <summary>Defines basic methods and properties for large signal devices.</summary>
 	public interface ILargeSignalDevice : IAnalysisDeviceModel<LargeSignalCircuitModel>
 	{
+		/// <summary>
+		///   Specifies whether the stamped values depend on the solution of the equation system. Circuits consisting only
+		///   of linear devices are solved without Newton-Raphson iterations.
+		/// </summary>
+		bool IsNonlinear { get; }
+
 		/// <summary>Allows devices to register any additional variables.</summary>
 		/// <param name="adapter">The equation system builder.</param>
-		void RegisterAdditionalVariables(IEquationSystemAdapter adapter);
+		/// <param name="context">Context of current simulation.</param>
+		void RegisterAdditionalVariables(IEquationSystemAdapter adapter, ISimulationContext context);
 
 		/// <summary>Performs necessary initialization of the device, like mapping to the equation system.</summary>
 		/// <param name="adapter">The equation system builder.</param>
@@ -32,5 +39,22 @@ namespace NextGenSpice.LargeSignal.Devices
 		/// </summary>
 		/// <param name="context">Context of current simulation.</param>
 		void OnDcBiasEstablished(ISimulationContext context);
+
+		/// <summary>
+		///   Returns the largest timestep for which the local truncation error of the device state at the current
+		///   timepoint would be within tolerance. This method is called after the Newton-Raphson iterations converged and
+		///   before the timepoint is accepted by OnDcBiasEstablished.
+		/// </summary>
+		/// <param name="context">Context of current simulation.</param>
+		/// <returns>The timestep, positive infinity if the device does not limit the timestep.</returns>
+		double GetMaxTimeStep(ISimulationContext context);
+
+		/// <summary>
+		///   Returns the first timepoint after given timepoint at which the behavior of the device is not smooth, e.g. a
+		///   corner of the waveform of an input source. The adaptive timestep control lands exactly on these timepoints.
+		/// </summary>
+		/// <param name="timepoint">The time value after which to search.</param>
+		/// <returns>The timepoint or positive infinity if the device has no such timepoint.</returns>
+		double GetNextBreakpoint(double timepoint);
 	}
 }
\ No newline at end of file
@@ -14,10 +14,10 @@ namespace NextGenSpice.LargeSignal.Devices
 	/// <summary>Large signal model for <see cref="Bjt" /> device.</summary>
 	public class LargeSignalBjt : LargeSignalDeviceBase<Bjt>
 	{
-		private readonly CapacitorStamperWithCurrent capacbc;
+		private ICapacitorStamper capacbc;
 
-		private readonly CapacitorStamperWithCurrent capacbe;
-		private readonly CapacitorStamperWithCurrent capaccs;
+		private ICapacitorStamper capacbe;
+		private ICapacitorStamper capaccs;
 
 		private readonly ConductanceStamper gb;
 		private readonly ConductanceStamper gc;
@@ -41,6 +41,24 @@ namespace NextGenSpice.LargeSignal.Devices
 
 		private double vT; // thermal voltage
 
+		// operating point of the last evaluation of the model, used for bypass
+		private double cachedVbc;
+		private double cachedVbe;
+		private double cachedVcs;
+		private double cbc;
+		private double cbe;
+		private double ccs;
+		private double ceqbc;
+		private double ceqbe;
+		private double gbc;
+		private double gbe;
+		private bool capacitancesEvaluated;
+		private bool junctionsEvaluated;
+
+		// group in which the model is evaluated natively, null if evaluated by the device itself
+		private BjtGroupBuffer group;
+		private int groupIndex;
+
 		public LargeSignalBjt(Bjt definitionDevice) : base(definitionDevice)
 		{
 			stamper = new BjtTransistorStamper();
@@ -48,10 +66,6 @@ namespace NextGenSpice.LargeSignal.Devices
 			voltageBc = new VoltageProxy();
 			voltageCs = new VoltageProxy();
 
-			capacbe = new CapacitorStamperWithCurrent();
-			capacbc = new CapacitorStamperWithCurrent();
-			capaccs = new CapacitorStamperWithCurrent();
-
 			gb = new ConductanceStamper();
 			gc = new ConductanceStamper();
 			ge = new ConductanceStamper();
@@ -108,16 +122,27 @@ namespace NextGenSpice.LargeSignal.Devices
 		/// <summary>Computed conductance between the base and collector terminals.</summary>
 		public double ConductanceMu { get; private set; }
 
+		/// <summary>How many times the cached model values were used instead of evaluating the model.</summary>
+		public int BypassCount { get; private set; }
+
 
 		/// <summary>Allows devices to register any additional variables.</summary>
 		/// <param name="adapter">The equation system builder.</param>
-		public override void RegisterAdditionalVariables(IEquationSystemAdapter adapter)
+		/// <param name="context">Context of current simulation.</param>
+		public override void RegisterAdditionalVariables(IEquationSystemAdapter adapter, ISimulationContext context)
 		{
-			base.RegisterAdditionalVariables(adapter);
+			base.RegisterAdditionalVariables(adapter, context);
 
 			bprimeNode = Parameters.BaseResistance > 0 ? adapter.AddVariable() : Base;
 			cprimeNode = Parameters.CollectorResistance > 0 ? adapter.AddVariable() : Collector;
 			eprimeNode = Parameters.EmitterCapacitance > 0 ? adapter.AddVariable() : Emitter;
+
+			capacbe = CapacitorStamperFactory.Create(context.SimulationParameters);
+			capacbc = CapacitorStamperFactory.Create(context.SimulationParameters);
+			capaccs = CapacitorStamperFactory.Create(context.SimulationParameters);
+			capacbe.RegisterVariable(adapter);
+			capacbc.RegisterVariable(adapter);
+			capaccs.RegisterVariable(adapter);
 		}
 
 		/// <summary>Performs necessary initialization of the device, like mapping to the equation system.</summary>
@@ -148,6 +173,57 @@ namespace NextGenSpice.LargeSignal.Devices
 			     PhysicalConstants.DevicearyCharge;
 
 			VoltageBaseEmitter = DeviceHelpers.PnCriticalVoltage(Parameters.SaturationCurrent, vT);
+			junctionsEvaluated = false;
+			capacitancesEvaluated = false;
+			group = null;
+		}
+
+		/// <summary>Binds the device to the group which evaluates its model and sets the model parameters.</summary>
+		/// <param name="buffer">Values of the group.</param>
+		/// <param name="index">Index of this device in the group.</param>
+		internal void BindToGroup(BjtGroupBuffer buffer, int index)
+		{
+			group = buffer;
+			groupIndex = index;
+
+			buffer[BjtField.SaturationCurrent, index] = Parameters.SaturationCurrent;
+			buffer[BjtField.LeakageSaturationCurrentBe, index] = Parameters.EmitterSaturationCurrent;
+			buffer[BjtField.LeakageSaturationCurrentBc, index] = Parameters.CollectorSaturationCurrent;
+			buffer[BjtField.ThermalVoltageForward, index] = Parameters.ForwardEmissionCoefficient * vT;
+			buffer[BjtField.ThermalVoltageReverse, index] = Parameters.ReverseEmissionCoefficient * vT;
+			buffer[BjtField.ThermalVoltageLeakageBe, index] = Parameters.EmitterSaturationCoefficient * vT;
+			buffer[BjtField.ThermalVoltageLeakageBc, index] = Parameters.CollectorSaturationCoefficient * vT;
+			buffer[BjtField.ForwardBeta, index] = Parameters.ForwardBeta;
+			buffer[BjtField.ReverseBeta, index] = Parameters.ReverseBeta;
+			buffer[BjtField.ForwardEarlyVoltage, index] = Parameters.ForwardEarlyVoltage;
+			buffer[BjtField.ReverseEarlyVoltage, index] = Parameters.ReverseEarlyVoltage;
+			buffer[BjtField.ForwardCurrentCorner, index] = Parameters.ForwardCurrentCorner;
+			buffer[BjtField.ReverseCurrentCorner, index] = Parameters.ReverseCurrentCorner;
+			buffer[BjtField.Polarity, index] = Parameters.IsPnp ? -1 : +1;
+			buffer[BjtField.ForwardTransitTime, index] = Parameters.ForwardTransitTime;
+			buffer[BjtField.ReverseTransitTime, index] = Parameters.ReverseTransitTime;
+			buffer[BjtField.ForwardBiasDepletionCoefficient, index] = Parameters.ForwardBiasDepletionCoefficient;
+			buffer[BjtField.EmitterCapacitance, index] = Parameters.EmitterCapacitance;
+			buffer[BjtField.EmitterExponentialFactor, index] = Parameters.EmitterExponentialFactor;
+			buffer[BjtField.EmitterPotential, index] = Parameters.EmitterPotential;
+			buffer[BjtField.CollectorCapacitance, index] = Parameters.CollectorCapacitance;
+			buffer[BjtField.CollectorExponentialFactor, index] = Parameters.CollectorExponentialFactor;
+			buffer[BjtField.CollectorPotential, index] = Parameters.CollectorPotential;
+			buffer[BjtField.SubstrateCapacitance, index] = Parameters.SubstrateCapacitance;
+			buffer[BjtField.SubstrateExponentialFactor, index] = Parameters.SubstrateExponentialFactor;
+			buffer[BjtField.SubstratePotential, index] = Parameters.SubstratePotential;
+		}
+
+		/// <summary>Sets the values needed for the evaluation of the model in the group.</summary>
+		/// <param name="context">Context of current simulation.</param>
+		internal void WriteGroupInputs(ISimulationContext context)
+		{
+			group[BjtField.MinimalConductance, groupIndex] =
+				Parameters.MinimalResistance ?? context.SimulationParameters.MinimalResistance;
+			group[BjtField.VoltageBaseEmitter, groupIndex] = VoltageBaseEmitter;
+			group[BjtField.VoltageBaseCollector, groupIndex] = VoltageBaseCollector;
+			if (context.TimePoint > 0)
+				group[BjtField.VoltageCollectorSubstrate, groupIndex] = voltageCs.GetValue();
 		}
 
 		/// <summary>
@@ -162,6 +238,94 @@ namespace NextGenSpice.LargeSignal.Devices
 			     PhysicalConstants.CelsiusToKelvin(Parameters.NominalTemperature) /
 			     PhysicalConstants.DevicearyCharge;
 
+			var bypass = CanBypass(context, VoltageBaseEmitter, VoltageBaseCollector);
+			if (bypass)
+			{
+				BypassCount++;
+				context.ReportBypass(this);
+			}
+			else if (group != null)
+			{
+				LoadFromGroup(context);
+			}
+			else
+			{
+				EvaluateJunctions(context, VoltageBaseEmitter, VoltageBaseCollector);
+			}
+
+			var ggb = Parameters.BaseResistance > 0 ? 1 / Parameters.BaseResistance : 0;
+			var ggc = Parameters.CollectorResistance > 0 ? 1 / Parameters.CollectorResistance : 0;
+			var gge = Parameters.EmitterCapacitance > 0 ? 1 / Parameters.EmitterCapacitance : 0;
+
+			stamper.Stamp(ConductancePi, ConductanceMu, Transconductance, -OutputConductance, ceqbe, ceqbc);
+			gb.Stamp(ggb);
+			ge.Stamp(gge);
+			gc.Stamp(ggc);
+
+			if (!(context.TimePoint > 0))
+			{
+				// capacitors are open circuits at the operating point
+				capacbe.Stamp(0, 0);
+				capacbc.Stamp(0, 0);
+				capaccs.Stamp(0, 0);
+				return;
+			}
+
+			var vcs = voltageCs.GetValue();
+			var vntol = context.SimulationParameters.BypassVoltageTolerance;
+			var reltol = context.SimulationParameters.RelativeTolerance;
+			var vcsChanged = bypass ? !MathHelper.InTollerance(vcs, cachedVcs, vntol, reltol) : vcs != cachedVcs;
+			if (!capacitancesEvaluated || vcsChanged) EvaluateCapacitances(vcs);
+
+			// stamp capacitors
+
+			double cieq;
+			(cieq, cgeqbe) = chargebe.GetEquivalents(cbe / context.TimeStep, context.TimeStepHistory);
+			capacbe.Stamp(cieq, cgeqbe);
+
+			(cieq, cgeqbc) = chargebc.GetEquivalents(cbc / context.TimeStep, context.TimeStepHistory);
+			capacbc.Stamp(cieq, cgeqbc);
+
+			(cieq, cgeqcs) = chargecs.GetEquivalents(ccs / context.TimeStep, context.TimeStepHistory);
+			capaccs.Stamp(cieq, cgeqcs);
+		}
+
+		/// <summary>
+		///   Returns whether the values from the last evaluation of the junctions can be used, i.e. the junction voltages
+		///   and the linearly predicted terminal currents are within tolerance of the cached operating point.
+		/// </summary>
+		/// <param name="context">Context of current simulation.</param>
+		/// <param name="vbe">Voltage across the base-emitter junction.</param>
+		/// <param name="vbc">Voltage across the base-collector junction.</param>
+		/// <returns></returns>
+		private bool CanBypass(ISimulationContext context, double vbe, double vbc)
+		{
+			var parameters = context.SimulationParameters;
+			if (!parameters.UseDeviceBypass || !junctionsEvaluated) return false;
+
+			var reltol = parameters.RelativeTolerance;
+			var abstol = parameters.AbsoluteTolerance;
+			var vntol = parameters.BypassVoltageTolerance;
+			if (!MathHelper.InTollerance(vbe, cachedVbe, vntol, reltol) ||
+			    !MathHelper.InTollerance(vbc, cachedVbc, vntol, reltol))
+				return false;
+
+			var delvbe = vbe - cachedVbe;
+			var delvbc = vbc - cachedVbc;
+			var cchat = CurrentCollector + (Transconductance + OutputConductance) * delvbe -
+			            (OutputConductance + ConductanceMu) * delvbc;
+			var cbhat = CurrentBase + ConductancePi * delvbe + ConductanceMu * delvbc;
+
+			return MathHelper.InTollerance(cchat, CurrentCollector, abstol, reltol) &&
+			       MathHelper.InTollerance(cbhat, CurrentBase, abstol, reltol);
+		}
+
+		/// <summary>Evaluates currents and conductances of the transistor junctions for given voltages.</summary>
+		/// <param name="context">Context of current simulation.</param>
+		/// <param name="vbe">Voltage across the base-emitter junction.</param>
+		/// <param name="vbc">Voltage across the base-collector junction.</param>
+		private void EvaluateJunctions(ISimulationContext context, double vbe, double vbc)
+		{
 			var iS = Parameters.SaturationCurrent;
 			var iSe = Parameters.EmitterSaturationCurrent;
 			var iSc = Parameters.CollectorSaturationCurrent;
@@ -184,19 +348,12 @@ namespace NextGenSpice.LargeSignal.Devices
 
 			var polarity = Parameters.IsPnp ? -1 : +1;
 
-			var ggb = Parameters.BaseResistance > 0 ? 1 / Parameters.BaseResistance : 0;
-			var ggc = Parameters.CollectorResistance > 0 ? 1 / Parameters.CollectorResistance : 0;
-			var gge = Parameters.EmitterCapacitance > 0 ? 1 / Parameters.EmitterCapacitance : 0;
-
-
-			var vbe = VoltageBaseEmitter;
-			var vbc = VoltageBaseCollector;
-
 			// calculate junction currents
-			var (ibe, gbe) = DeviceHelpers.PnBJT(iS, vbe, nF * vT, gmin);
+			double ibe, ibc;
+			(ibe, gbe) = DeviceHelpers.PnBJT(iS, vbe, nF * vT, gmin);
 			var (iben, gben) = DeviceHelpers.PnBJT(iSe, vbe, nE * vT, 0);
 
-			var (ibc, gbc) = DeviceHelpers.PnBJT(iS, vbc, nR * vT, gmin);
+			(ibc, gbc) = DeviceHelpers.PnBJT(iS, vbc, nR * vT, gmin);
 			var (ibcn, gbcn) = DeviceHelpers.PnBJT(iSc, vbc, nC * vT, 0);
 
 			// base charge calculation
@@ -218,8 +375,8 @@ namespace NextGenSpice.LargeSignal.Devices
 			var gm = (gbe - (ibe - ibc) * dQdbUbe / qB) / qB - go;
 
 			// terminal currents
-			var ceqbe = polarity * (ic + ib - vbe * (gm + go + gpi) + vbc * go);
-			var ceqbc = polarity * (-ic + vbe * (gm + go) - vbc * (gmu + go));
+			ceqbe = polarity * (ic + ib - vbe * (gm + go + gpi) + vbc * go);
+			ceqbc = polarity * (-ic + vbe * (gm + go) - vbc * (gmu + go));
 
 			CurrentBase = ib;
 			CurrentCollector = ic;
@@ -231,15 +388,48 @@ namespace NextGenSpice.LargeSignal.Devices
 			ConductancePi = gpi;
 			ConductanceMu = gmu;
 
-			stamper.Stamp(gpi, gmu, gm, -go, ceqbe, ceqbc);
-			gb.Stamp(ggb);
-			ge.Stamp(gge);
-			gc.Stamp(ggc);
-
-			if (!(context.TimePoint > 0)) return;
+			cachedVbe = vbe;
+			cachedVbc = vbc;
+			junctionsEvaluated = true;
+			capacitancesEvaluated = false;
+		}
 
-			var vcs = voltageCs.GetValue();
+		/// <summary>Loads the values evaluated in the group.</summary>
+		/// <param name="context">Context of current simulation.</param>
+		private void LoadFromGroup(ISimulationContext context)
+		{
+			CurrentBase = group[BjtField.CurrentBase, groupIndex];
+			CurrentCollector = group[BjtField.CurrentCollector, groupIndex];
+			CurrentEmitter = -CurrentBase - CurrentCollector;
+			CurrentBaseEmitter = group[BjtField.CurrentBaseEmitter, groupIndex];
+			CurrentBaseCollector = group[BjtField.CurrentBaseCollector, groupIndex];
+			Transconductance = group[BjtField.Transconductance, groupIndex];
+			OutputConductance = group[BjtField.OutputConductance, groupIndex];
+			ConductancePi = group[BjtField.ConductancePi, groupIndex];
+			ConductanceMu = group[BjtField.ConductanceMu, groupIndex];
+			ceqbe = group[BjtField.EquivalentCurrentBe, groupIndex];
+			ceqbc = group[BjtField.EquivalentCurrentBc, groupIndex];
+			gbe = group[BjtField.ConductanceBaseEmitter, groupIndex];
+			gbc = group[BjtField.ConductanceBaseCollector, groupIndex];
+
+			cachedVbe = group[BjtField.VoltageBaseEmitter, groupIndex];
+			cachedVbc = group[BjtField.VoltageBaseCollector, groupIndex];
+			junctionsEvaluated = true;
+
+			// capacitances are evaluated by the group only in transient analysis
+			capacitancesEvaluated = context.TimePoint > 0;
+			if (!capacitancesEvaluated) return;
+
+			cbe = group[BjtField.CapacitanceBaseEmitter, groupIndex];
+			cbc = group[BjtField.CapacitanceBaseCollector, groupIndex];
+			ccs = group[BjtField.CapacitanceCollectorSubstrate, groupIndex];
+			cachedVcs = group[BjtField.VoltageCollectorSubstrate, groupIndex];
+		}
 
+		/// <summary>Evaluates the junction capacitances at the operating point of the last junction evaluation.</summary>
+		/// <param name="vcs">Voltage across the collector-substrate junction.</param>
+		private void EvaluateCapacitances(double vcs)
+		{
 			var tf = Parameters.ForwardTransitTime;
 			var tr = Parameters.ReverseTransitTime;
 
@@ -257,22 +447,12 @@ namespace NextGenSpice.LargeSignal.Devices
 			var mjs = Parameters.SubstrateExponentialFactor;
 			var vjs = Parameters.SubstratePotential;
 
+			cbe = DeviceHelpers.JunctionCapacitance(cachedVbe, cje, mje, vje, gbe * tf, fc);
+			cbc = DeviceHelpers.JunctionCapacitance(cachedVbc, cjc, mjc, vjc, gbc * tr, fc);
+			ccs = DeviceHelpers.JunctionCapacitance(vcs, cjs, mjs, vjs, 0, fc);
 
-			var cbe = DeviceHelpers.JunctionCapacitance(vbe, cje, mje, vje, gbe * tf, fc);
-			var cbc = DeviceHelpers.JunctionCapacitance(vbc, cjc, mjc, vjc, gbc * tr, fc);
-			var ccs = DeviceHelpers.JunctionCapacitance(vcs, cjs, mjs, vjs, 0, fc);
-
-			// stamp capacitors
-
-			double cieq;
-			(cieq, cgeqbe) = chargebe.GetEquivalents(cbe / context.TimeStep);
-			capacbe.Stamp(cieq, cgeqbe);
-
-			(cieq, cgeqbc) = chargebe.GetEquivalents(cbc / context.TimeStep);
-			capacbc.Stamp(cieq, cgeqbc);
-
-			(cieq, cgeqcs) = chargebe.GetEquivalents(ccs / context.TimeStep);
-			capaccs.Stamp(cieq, cgeqcs);
+			cachedVcs = vcs;
+			capacitancesEvaluated = true;
 		}
 
 
@@ -331,13 +511,29 @@ namespace NextGenSpice.LargeSignal.Devices
 
 			// update capacitances
 			var vbe = voltageBe.GetValue();
-			chargebe.SetState(vbe * cgeqbe, vbe);
+			chargebe.SetState(capacbe.GetCurrent(), vbe);
 
 			var vbc = voltageBc.GetValue();
-			chargebc.SetState(vbc * cgeqbc, vbc);
+			chargebc.SetState(capacbc.GetCurrent(), vbc);
 
 			var vcs = voltageCs.GetValue();
-			chargecs.SetState(vcs * cgeqcs, vcs);
+			chargecs.SetState(capaccs.GetCurrent(), vcs);
+		}
+
+		/// <summary>
+		///   Returns the largest timestep for which the local truncation error of the device state at the current
+		///   timepoint would be within tolerance. This method is called after the Newton-Raphson iterations converged and
+		///   before the timepoint is accepted by OnDcBiasEstablished.
+		/// </summary>
+		/// <param name="context">Context of current simulation.</param>
+		/// <returns>The timestep, positive infinity if the device does not limit the timestep.</returns>
+		public override double GetMaxTimeStep(ISimulationContext context)
+		{
+			var timestep = double.PositiveInfinity;
+			if (cbe > 0) timestep = Math.Min(timestep, chargebe.GetMaxTimeStep(voltageBe.GetValue(), context));
+			if (cbc > 0) timestep = Math.Min(timestep, chargebc.GetMaxTimeStep(voltageBc.GetValue(), context));
+			if (ccs > 0) timestep = Math.Min(timestep, chargecs.GetMaxTimeStep(voltageCs.GetValue(), context));
+			return timestep;
 		}
 
 		/// <summary>
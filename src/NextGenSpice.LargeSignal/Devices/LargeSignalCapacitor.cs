@@ -8,15 +8,14 @@ namespace NextGenSpice.LargeSignal.Devices
 	/// <summary>Large signal model for <see cref="Capacitor" /> device.</summary>
 	public class LargeSignalCapacitor : TwoTerminalLargeSignalDevice<Capacitor>
 	{
-		private readonly CapacitorStamperWithCurrent stamper;
 		private readonly VoltageProxy voltage;
 
 		private bool firtDcPoint;
+		private ICapacitorStamper stamper;
 
 		public LargeSignalCapacitor(Capacitor definitionDevice) : base(definitionDevice)
 		{
 			voltage = new VoltageProxy();
-			stamper = new CapacitorStamperWithCurrent();
 		}
 
 		/// <summary>Integration method used for modifying inner state of the device.</summary>
@@ -24,12 +23,16 @@ namespace NextGenSpice.LargeSignal.Devices
 
 		/// <summary>Allows devices to register any additional variables.</summary>
 		/// <param name="adapter">The equation system builder.</param>
-		public override void RegisterAdditionalVariables(IEquationSystemAdapter adapter)
+		/// <param name="context">Context of current simulation.</param>
+		public override void RegisterAdditionalVariables(IEquationSystemAdapter adapter, ISimulationContext context)
 		{
-			base.RegisterAdditionalVariables(adapter);
+			base.RegisterAdditionalVariables(adapter, context);
+			stamper = CapacitorStamperFactory.Create(context.SimulationParameters);
 			stamper.RegisterVariable(adapter);
 		}
 
+		public override bool IsNonlinear => false;
+
 		/// <summary>Performs necessary initialization of the device, like mapping to the equation system.</summary>
 		/// <param name="adapter">The equation system builder.</param>
 		/// <param name="context">Context of current simulation.</param>
@@ -63,7 +66,8 @@ namespace NextGenSpice.LargeSignal.Devices
 			}
 			else
 			{
-				(ieq, geq) = IntegrationMethod.GetEquivalents(DefinitionDevice.Capacity / context.TimeStep);
+				(ieq, geq) = IntegrationMethod.GetEquivalents(DefinitionDevice.Capacity / context.TimeStep,
+					context.TimeStepHistory);
 			}
 
 			stamper.Stamp(ieq, geq);
@@ -88,5 +92,17 @@ namespace NextGenSpice.LargeSignal.Devices
 			firtDcPoint = false;
 			IntegrationMethod.SetState(Current, Voltage);
 		}
+
+		/// <summary>
+		///   Returns the largest timestep for which the local truncation error of the device state at the current
+		///   timepoint would be within tolerance. This method is called after the Newton-Raphson iterations converged and
+		///   before the timepoint is accepted by OnDcBiasEstablished.
+		/// </summary>
+		/// <param name="context">Context of current simulation.</param>
+		/// <returns>The timestep, positive infinity if the device does not limit the timestep.</returns>
+		public override double GetMaxTimeStep(ISimulationContext context)
+		{
+			return IntegrationMethod.GetMaxTimeStep(Voltage, context);
+		}
 	}
 }
\ No newline at end of file
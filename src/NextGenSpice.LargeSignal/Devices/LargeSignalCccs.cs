@@ -20,6 +20,8 @@ namespace NextGenSpice.LargeSignal.Devices
 
 		public double ReferenceCurrent => ampermeter.Current;
 
+		public override bool IsNonlinear => false;
+
 		/// <summary>Performs necessary initialization of the device, like mapping to the equation system.</summary>
 		/// <param name="adapter">The equation system builder.</param>
 		/// <param name="context">Context of current simulation.</param>
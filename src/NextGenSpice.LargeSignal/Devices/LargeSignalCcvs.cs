@@ -20,12 +20,15 @@ namespace NextGenSpice.LargeSignal.Devices
 
 		/// <summary>Allows devices to register any additional variables.</summary>
 		/// <param name="adapter">The equation system builder.</param>
-		public override void RegisterAdditionalVariables(IEquationSystemAdapter adapter)
+		/// <param name="context">Context of current simulation.</param>
+		public override void RegisterAdditionalVariables(IEquationSystemAdapter adapter, ISimulationContext context)
 		{
-			base.RegisterAdditionalVariables(adapter);
+			base.RegisterAdditionalVariables(adapter, context);
 			stamper.RegisterVariable(adapter);
 		}
 
+		public override bool IsNonlinear => false;
+
 		/// <summary>Performs necessary initialization of the device, like mapping to the equation system.</summary>
 		/// <param name="adapter">The equation system builder.</param>
 		/// <param name="context">Context of current simulation.</param>
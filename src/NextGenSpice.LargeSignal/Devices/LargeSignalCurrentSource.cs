@@ -29,6 +29,8 @@ namespace NextGenSpice.LargeSignal.Devices
 			Voltage = voltage.GetValue();
 		}
 
+		public override bool IsNonlinear => false;
+
 		/// <summary>Performs necessary initialization of the device, like mapping to the equation system.</summary>
 		/// <param name="adapter">The equation system builder.</param>
 		/// <param name="context">Context of current simulation.</param>
@@ -48,5 +50,16 @@ namespace NextGenSpice.LargeSignal.Devices
 			Current = Behavior.GetValue(context.TimePoint);
 			stamper.Stamp(Current);
 		}
+
+		/// <summary>
+		///   Returns the first timepoint after given timepoint at which the behavior of the device is not smooth, e.g. a
+		///   corner of the waveform of an input source. The adaptive timestep control lands exactly on these timepoints.
+		/// </summary>
+		/// <param name="timepoint">The time value after which to search.</param>
+		/// <returns>The timepoint or positive infinity if the device has no such timepoint.</returns>
+		public override double GetNextBreakpoint(double timepoint)
+		{
+			return Behavior.GetNextBreakpoint(timepoint);
+		}
 	}
 }
\ No newline at end of file
@@ -20,9 +20,16 @@ namespace NextGenSpice.LargeSignal.Devices
 
 		ICircuitDefinitionDevice IAnalysisDeviceModel<LargeSignalCircuitModel>.DefinitionDevice => DefinitionDevice;
 
+		/// <summary>
+		///   Specifies whether the stamped values depend on the solution of the equation system. Circuits consisting only
+		///   of linear devices are solved without Newton-Raphson iterations.
+		/// </summary>
+		public virtual bool IsNonlinear => true;
+
 		/// <summary>Allows devices to register any additional variables.</summary>
 		/// <param name="adapter">The equation system builder.</param>
-		public virtual void RegisterAdditionalVariables(IEquationSystemAdapter adapter)
+		/// <param name="context">Context of current simulation.</param>
+		public virtual void RegisterAdditionalVariables(IEquationSystemAdapter adapter, ISimulationContext context)
 		{
 			// no registration default
 		}
@@ -52,6 +59,29 @@ namespace NextGenSpice.LargeSignal.Devices
 		{
 		}
 
+		/// <summary>
+		///   Returns the largest timestep for which the local truncation error of the device state at the current
+		///   timepoint would be within tolerance. This method is called after the Newton-Raphson iterations converged and
+		///   before the timepoint is accepted by OnDcBiasEstablished.
+		/// </summary>
+		/// <param name="context">Context of current simulation.</param>
+		/// <returns>The timestep, positive infinity if the device does not limit the timestep.</returns>
+		public virtual double GetMaxTimeStep(ISimulationContext context)
+		{
+			return double.PositiveInfinity;
+		}
+
+		/// <summary>
+		///   Returns the first timepoint after given timepoint at which the behavior of the device is not smooth, e.g. a
+		///   corner of the waveform of an input source. The adaptive timestep control lands exactly on these timepoints.
+		/// </summary>
+		/// <param name="timepoint">The time value after which to search.</param>
+		/// <returns>The timepoint or positive infinity if the device has no such timepoint.</returns>
+		public virtual double GetNextBreakpoint(double timepoint)
+		{
+			return double.PositiveInfinity;
+		}
+
 		/// <summary>
 		///   Gets provider instance for specified attribute value or null if no provider for requested parameter exists.
 		///   For example "I" for the current flowing throught the two terminal device.
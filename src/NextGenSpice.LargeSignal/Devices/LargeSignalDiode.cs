@@ -12,10 +12,21 @@ namespace NextGenSpice.LargeSignal.Devices
 	/// <summary>Large signal model for <see cref="Diode" /> device.</summary>
 	public class LargeSignalDiode : TwoTerminalLargeSignalDevice<Diode>
 	{
-		private readonly CapacitorStamperWithCurrent capacitorStamper;
 		private readonly DiodeStamper stamper;
 		private readonly VoltageProxy voltage;
 		private double capacitanceTreshold; // cached treshold values based by model.
+		private ICapacitorStamper capacitorStamper;
+
+		// operating point of the last evaluation of the model, used for bypass
+		private double cachedCd;
+		private double cachedGeq;
+		private double cachedId;
+		private double cachedVd;
+		private bool evaluated;
+
+		// group in which the model is evaluated natively, null if evaluated by the device itself
+		private DiodeGroupBuffer group;
+		private int groupIndex;
 
 		private double gmin; // minimal slope of the I-V characteristic of the diode.
 		private double ic; // current through the capacitor that models junction capacitance
@@ -30,7 +41,6 @@ namespace NextGenSpice.LargeSignal.Devices
 		public LargeSignalDiode(Diode definitionDevice) : base(definitionDevice)
 		{
 			stamper = new DiodeStamper();
-			capacitorStamper = new CapacitorStamperWithCurrent();
 			voltage = new VoltageProxy();
 		}
 
@@ -43,11 +53,16 @@ namespace NextGenSpice.LargeSignal.Devices
 		/// <summary>Equivalent conductance of the diode</summary>
 		public double Conductance { get; set; }
 
+		/// <summary>How many times the cached model values were used instead of evaluating the model.</summary>
+		public int BypassCount { get; private set; }
+
 		/// <summary>Allows devices to register any additional variables.</summary>
 		/// <param name="adapter">The equation system builder.</param>
-		public override void RegisterAdditionalVariables(IEquationSystemAdapter adapter)
+		/// <param name="context">Context of current simulation.</param>
+		public override void RegisterAdditionalVariables(IEquationSystemAdapter adapter, ISimulationContext context)
 		{
-			base.RegisterAdditionalVariables(adapter);
+			base.RegisterAdditionalVariables(adapter, context);
+			capacitorStamper = CapacitorStamperFactory.Create(context.SimulationParameters);
 			capacitorStamper.RegisterVariable(adapter);
 		}
 
@@ -71,6 +86,36 @@ namespace NextGenSpice.LargeSignal.Devices
 			var n = Parameters.EmissionCoefficient;
 
 			Voltage = DefinitionDevice.VoltageHint ?? 0;
+			evaluated = false;
+			group = null;
+		}
+
+		/// <summary>Binds the device to the group which evaluates its model and sets the model parameters.</summary>
+		/// <param name="buffer">Values of the group.</param>
+		/// <param name="index">Index of this device in the group.</param>
+		internal void BindToGroup(DiodeGroupBuffer buffer, int index)
+		{
+			group = buffer;
+			groupIndex = index;
+
+			group[DiodeField.SaturationCurrent, index] = Parameters.SaturationCurrent;
+			group[DiodeField.ThermalVoltage, index] = vt;
+			group[DiodeField.ReverseBreakdownVoltage, index] = Parameters.ReverseBreakdownVoltage;
+			group[DiodeField.TransitTime, index] = Parameters.TransitTime;
+			group[DiodeField.JunctionCapacitance, index] = Parameters.JunctionCapacitance;
+			group[DiodeField.JunctionPotential, index] = Parameters.JunctionPotential;
+			group[DiodeField.JunctionGradingCoefficient, index] = Parameters.JunctionGradingCoefficient;
+			group[DiodeField.ForwardBiasDepletionCapacitanceCoefficient, index] =
+				Parameters.ForwardBiasDepletionCapacitanceCoefficient;
+		}
+
+		/// <summary>Sets the values needed for the evaluation of the model in the group.</summary>
+		/// <param name="context">Context of current simulation.</param>
+		internal void WriteGroupInputs(ISimulationContext context)
+		{
+			group[DiodeField.MinimalConductance, groupIndex] =
+				Parameters.MinimalResistance ?? context.SimulationParameters.MinimalResistance;
+			group[DiodeField.Voltage, groupIndex] = Voltage - Parameters.SeriesResistance * Current;
 		}
 
 		/// <summary>
@@ -89,14 +134,30 @@ namespace NextGenSpice.LargeSignal.Devices
 			capacitanceTreshold = Parameters.ForwardBiasDepletionCapacitanceCoefficient * Parameters.JunctionPotential;
 
 			var vd = Voltage - Parameters.SeriesResistance * Current;
-			var (id, geq, cd) = GetModelValues(vd);
+			double id, geq, cd;
+			if (CanBypass(context, vd))
+			{
+				(vd, id, geq, cd) = (cachedVd, cachedId, cachedGeq, cachedCd);
+				BypassCount++;
+				context.ReportBypass(this);
+			}
+			else
+			{
+				(id, geq, cd) = group != null
+					? (group[DiodeField.Current, groupIndex], group[DiodeField.Conductance, groupIndex],
+						group[DiodeField.Capacitance, groupIndex])
+					: GetModelValues(vd);
+				(cachedVd, cachedId, cachedGeq, cachedCd) = (vd, id, geq, cd);
+				evaluated = true;
+			}
+
 			var ieq = id - geq * vd;
 
 			// Diode
 			stamper.Stamp(geq, -ieq);
 
 			// Capacitance
-			var (cieq, cgeq) = IntegrationMethod.GetEquivalents(cd / context.TimeStep);
+			var (cieq, cgeq) = IntegrationMethod.GetEquivalents(cd / context.TimeStep, context.TimeStepHistory);
 
 			if (initialConditionCapacitor) // initial condition
 				capacitorStamper.Stamp(0, 0);
@@ -142,6 +203,38 @@ namespace NextGenSpice.LargeSignal.Devices
 			initialConditionCapacitor = false; // capacitor no longer needs initial condition
 		}
 
+		/// <summary>
+		///   Returns the largest timestep for which the local truncation error of the device state at the current
+		///   timepoint would be within tolerance. This method is called after the Newton-Raphson iterations converged and
+		///   before the timepoint is accepted by OnDcBiasEstablished.
+		/// </summary>
+		/// <param name="context">Context of current simulation.</param>
+		/// <returns>The timestep, positive infinity if the device does not limit the timestep.</returns>
+		public override double GetMaxTimeStep(ISimulationContext context)
+		{
+			// the junction voltage is integrated only if the junction has some capacitance
+			return cachedCd > 0 ? IntegrationMethod.GetMaxTimeStep(Voltage, context) : double.PositiveInfinity;
+		}
+
+		/// <summary>
+		///   Returns whether the cached model values can be used, i.e. the voltage and the linearly predicted current
+		///   are within tolerance of the cached operating point.
+		/// </summary>
+		/// <param name="context">Context of current simulation.</param>
+		/// <param name="vd">Voltage across the diode.</param>
+		/// <returns></returns>
+		private bool CanBypass(ISimulationContext context, double vd)
+		{
+			var parameters = context.SimulationParameters;
+			if (!parameters.UseDeviceBypass || !evaluated) return false;
+
+			var reltol = parameters.RelativeTolerance;
+			if (!MathHelper.InTollerance(vd, cachedVd, parameters.BypassVoltageTolerance, reltol)) return false;
+
+			var predicted = cachedId + cachedGeq * (vd - cachedVd);
+			return MathHelper.InTollerance(predicted, cachedId, parameters.AbsoluteTolerance, reltol);
+		}
+
 		/// <summary>Gets values for the device model based on voltage across the diode.</summary>
 		/// <param name="vd">Voltage across the diode.</param>
 		/// <returns></returns>
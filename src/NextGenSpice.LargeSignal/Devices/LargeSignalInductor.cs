@@ -25,12 +25,15 @@ namespace NextGenSpice.LargeSignal.Devices
 
 		/// <summary>Allows devices to register any additional variables.</summary>
 		/// <param name="adapter">The equation system builder.</param>
-		public override void RegisterAdditionalVariables(IEquationSystemAdapter adapter)
+		/// <param name="context">Context of current simulation.</param>
+		public override void RegisterAdditionalVariables(IEquationSystemAdapter adapter, ISimulationContext context)
 		{
-			base.RegisterAdditionalVariables(adapter);
+			base.RegisterAdditionalVariables(adapter, context);
 			stamper.RegisterVariable(adapter);
 		}
 
+		public override bool IsNonlinear => false;
+
 		/// <summary>Performs necessary initialization of the device, like mapping to the equation system.</summary>
 		/// <param name="adapter">The equation system builder.</param>
 		/// <param name="context">Context of current simulation.</param>
@@ -55,7 +58,8 @@ namespace NextGenSpice.LargeSignal.Devices
 			}
 			else
 			{
-				var (veq, req) = IntegrationMethod.GetEquivalents(DefinitionDevice.Inductance / context.TimeStep);
+				var (veq, req) = IntegrationMethod.GetEquivalents(DefinitionDevice.Inductance / context.TimeStep,
+					context.TimeStepHistory);
 				stamper.Stamp(-veq, req);
 			}
 		}
@@ -79,5 +83,17 @@ namespace NextGenSpice.LargeSignal.Devices
 			IntegrationMethod.SetState(Voltage, Current);
 			firstDcPoint = false;
 		}
+
+		/// <summary>
+		///   Returns the largest timestep for which the local truncation error of the device state at the current
+		///   timepoint would be within tolerance. This method is called after the Newton-Raphson iterations converged and
+		///   before the timepoint is accepted by OnDcBiasEstablished.
+		/// </summary>
+		/// <param name="context">Context of current simulation.</param>
+		/// <returns>The timestep, positive infinity if the device does not limit the timestep.</returns>
+		public override double GetMaxTimeStep(ISimulationContext context)
+		{
+			return IntegrationMethod.GetMaxTimeStep(Current, context);
+		}
 	}
 }
\ No newline at end of file
@@ -19,6 +19,8 @@ namespace NextGenSpice.LargeSignal.Devices
 		/// <summary>Resistance of the device in ohms.</summary>
 		public double Resistance => DefinitionDevice.Resistance;
 
+		public override bool IsNonlinear => false;
+
 		/// <summary>Performs necessary initialization of the device, like mapping to the equation system.</summary>
 		/// <param name="adapter">The equation system builder.</param>
 		/// <param name="context">Context of current simulation.</param>
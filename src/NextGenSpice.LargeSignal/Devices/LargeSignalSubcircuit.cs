@@ -1,4 +1,5 @@
-﻿using System.Collections.Generic;
+﻿using System;
+using System.Collections.Generic;
 using System.Linq;
 using NextGenSpice.Core.Devices;
 using NextGenSpice.Core.Representation;
@@ -24,6 +25,9 @@ namespace NextGenSpice.LargeSignal.Devices
 		/// <summary>Set of classes that model this subcircuit.</summary>
 		public IReadOnlyList<ILargeSignalDevice> Devices => devices;
 
+		/// <summary>The subcircuit is nonlinear if any of its devices is.</summary>
+		public override bool IsNonlinear => devices.Any(d => d.IsNonlinear);
+
 		/// <summary>This method is called each time an equation is solved.</summary>
 		/// <param name="context">Context of current simulation.</param>
 		public override void OnEquationSolution(ISimulationContext context)
@@ -45,6 +49,35 @@ namespace NextGenSpice.LargeSignal.Devices
 				model.OnDcBiasEstablished(context);
 		}
 
+		/// <summary>
+		///   Returns the largest timestep for which the local truncation error of the device state at the current
+		///   timepoint would be within tolerance. This method is called after the Newton-Raphson iterations converged and
+		///   before the timepoint is accepted by OnDcBiasEstablished.
+		/// </summary>
+		/// <param name="context">Context of current simulation.</param>
+		/// <returns>The timestep, positive infinity if the device does not limit the timestep.</returns>
+		public override double GetMaxTimeStep(ISimulationContext context)
+		{
+			var timeStep = double.PositiveInfinity;
+			foreach (var model in devices)
+				timeStep = Math.Min(timeStep, model.GetMaxTimeStep(context));
+			return timeStep;
+		}
+
+		/// <summary>
+		///   Returns the first timepoint after given timepoint at which the behavior of the device is not smooth, e.g. a
+		///   corner of the waveform of an input source. The adaptive timestep control lands exactly on these timepoints.
+		/// </summary>
+		/// <param name="timepoint">The time value after which to search.</param>
+		/// <returns>The timepoint or positive infinity if the device has no such timepoint.</returns>
+		public override double GetNextBreakpoint(double timepoint)
+		{
+			var breakpoint = double.PositiveInfinity;
+			foreach (var model in devices)
+				breakpoint = Math.Min(breakpoint, model.GetNextBreakpoint(timepoint));
+			return breakpoint;
+		}
+
 		/// <summary>
 		///   Gets provider instance for specified attribute value or null if no provider for requested parameter exists.
 		///   For example "I" for the current flowing throught the two terminal device.
@@ -58,12 +91,13 @@ namespace NextGenSpice.LargeSignal.Devices
 
 		/// <summary>Allows devices to register any additional variables.</summary>
 		/// <param name="adapter">The equation system builder.</param>
-		public override void RegisterAdditionalVariables(IEquationSystemAdapter adapter)
+		/// <param name="context">Context of current simulation.</param>
+		public override void RegisterAdditionalVariables(IEquationSystemAdapter adapter, ISimulationContext context)
 		{
-			base.RegisterAdditionalVariables(adapter);
+			base.RegisterAdditionalVariables(adapter, context);
 
 			foreach (var model in devices)
-				model.RegisterAdditionalVariables(adapter);
+				model.RegisterAdditionalVariables(adapter, context);
 		}
 
 		/// <summary>Performs necessary initialization of the device, like mapping to the equation system.</summary>
@@ -44,6 +44,8 @@ namespace NextGenSpice.LargeSignal.Devices
 		public double Current { get; private set; }
 
 
+		public override bool IsNonlinear => false;
+
 		/// <summary>Performs necessary initialization of the device, like mapping to the equation system.</summary>
 		/// <param name="adapter">The equation system builder.</param>
 		/// <param name="context">Context of current simulation.</param>
@@ -25,12 +25,15 @@ namespace NextGenSpice.LargeSignal.Devices
 
 		/// <summary>Allows devices to register any additional variables.</summary>
 		/// <param name="adapter">The equation system builder.</param>
-		public override void RegisterAdditionalVariables(IEquationSystemAdapter adapter)
+		/// <param name="context">Context of current simulation.</param>
+		public override void RegisterAdditionalVariables(IEquationSystemAdapter adapter, ISimulationContext context)
 		{
-			base.RegisterAdditionalVariables(adapter);
+			base.RegisterAdditionalVariables(adapter, context);
 			stamper.RegisterVariable(adapter);
 		}
 
+		public override bool IsNonlinear => false;
+
 		/// <summary>Performs necessary initialization of the device, like mapping to the equation system.</summary>
 		/// <param name="adapter">The equation system builder.</param>
 		/// <param name="context">Context of current simulation.</param>
@@ -56,5 +59,16 @@ namespace NextGenSpice.LargeSignal.Devices
 		{
 			Current = stamper.GetCurrent();
 		}
+
+		/// <summary>
+		///   Returns the first timepoint after given timepoint at which the behavior of the device is not smooth, e.g. a
+		///   corner of the waveform of an input source. The adaptive timestep control lands exactly on these timepoints.
+		/// </summary>
+		/// <param name="timepoint">The time value after which to search.</param>
+		/// <returns>The timepoint or positive infinity if the device has no such timepoint.</returns>
+		public override double GetNextBreakpoint(double timepoint)
+		{
+			return Behavior.GetNextBreakpoint(timepoint);
+		}
 	}
 }
\ No newline at end of file
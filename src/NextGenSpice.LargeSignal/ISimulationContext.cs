@@ -1,4 +1,5 @@
-﻿using NextGenSpice.LargeSignal.Devices;
+﻿using System.Collections.Generic;
+using NextGenSpice.LargeSignal.Devices;
 
 namespace NextGenSpice.LargeSignal
 {
@@ -11,6 +12,13 @@ namespace NextGenSpice.LargeSignal
 		/// <summary>Last timestep that was used to advance the timepoint.</summary>
 		double TimeStep { get; }
 
+		/// <summary>
+		///   Lengths of the recent timesteps. The first one is <see cref="TimeStep" />, the following ones led to the
+		///   previously accepted timepoints. The timestep leading from the operating point or to a breakpoint, after which
+		///   the integration is restarted, is 0.
+		/// </summary>
+		IReadOnlyList<double> TimeStepHistory { get; }
+
 		/// <summary>General parameters of the circuit that is simulated.</summary>
 		SimulationParameters SimulationParameters { get; }
 
@@ -23,5 +31,11 @@ namespace NextGenSpice.LargeSignal
 		/// </summary>
 		/// <param name="device"></param>
 		void ReportNotConverged(ILargeSignalDevice device);
+
+		/// <summary>
+		///   Reports that the device stamped values cached from a previous iteration instead of evaluating its model.
+		/// </summary>
+		/// <param name="device"></param>
+		void ReportBypass(ILargeSignalDevice device);
 	}
 }
\ No newline at end of file
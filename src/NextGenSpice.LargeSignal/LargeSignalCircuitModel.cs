@@ -1,17 +1,19 @@
 ﻿using System;
 using System.Collections.Generic;
 using System.Linq;
+using System.Threading;
 using NextGenSpice.Core.Devices;
 using NextGenSpice.Core.Exceptions;
 using NextGenSpice.Core.Representation;
 using NextGenSpice.LargeSignal.Devices;
+using NextGenSpice.LargeSignal.NumIntegration;
 using NextGenSpice.Numerics;
 using NextGenSpice.Numerics.Equations;
 
 namespace NextGenSpice.LargeSignal
 {
 	/// <summary>Main class for performing large signal analysis on electrical circuits.</summary>
-	public class LargeSignalCircuitModel : IAnalysisCircuitModel<ILargeSignalDevice>
+	public class LargeSignalCircuitModel : IAnalysisCircuitModel<ILargeSignalDevice>, IDisposable
 	{
 		private readonly Dictionary<ICircuitDefinitionDevice, ILargeSignalDevice> deviceLookup;
 		private readonly ILargeSignalDevice[] devices;
@@ -24,8 +26,38 @@ namespace NextGenSpice.LargeSignal
 		private double[] currentSolution;
 
 		private IEquationSystemAdapterWide equationSystemAdapter;
+		private IReusableFactorizationAdapter reusableFactorization;
+		private ISolutionSeedingAdapter solutionSeeding;
+		private bool isLinear;
+		private ILargeSignalDevice[] nonlinearDevices;
+		private ILargeSignalDevice[] linearDevices;
 		private double[] previousSolution;
 
+		private StampCache stampCache;
+		private bool stampCacheValid;
+		private DeviceGroups deviceGroups;
+		private ParallelAssembly parallelAssembly;
+		private BreakpointQueue breakpoints;
+
+		// coefficients shared by the devices when integrating by the variable-order BDF and the order chosen for the
+		// adaptive timesteps
+		private BdfCoefficients bdf;
+		private int integrationOrder;
+		private int stepsAtOrder;
+
+		// state of the modified Newton iterations
+		private IModifiedNewtonEquationSystemAdapter modifiedNewton;
+		private bool refactorNext;
+		private int reuseCount;
+		private double lastUpdateNorm;
+
+		// node voltages at the last accepted timepoint for rolling back rejected steps
+		private double[] acceptedVoltages;
+
+		// extrapolation of the starting point of the Newton-Raphson iterations
+		private SolutionPredictor predictor;
+		private double[] predictedSolution;
+
 		public LargeSignalCircuitModel(IEnumerable<double?> initialVoltages, List<ILargeSignalDevice> devices)
 		{
 			this.initialVoltages = initialVoltages.ToArray();
@@ -58,6 +90,31 @@ namespace NextGenSpice.LargeSignal
 		/// <summary>How many Newton-Raphson iterations were needed in total.</summary>
 		public int TotalNonLinearIterationCount { get; private set; }
 
+		/// <summary>How many of the Newton-Raphson iterations reused LU factors of an older equation matrix.</summary>
+		public int TotalModifiedNewtonIterationCount { get; private set; }
+
+		/// <summary>Maximumum number of Newton-Raphson iterations before a step is rejected when the timestep is adaptive.</summary>
+		public int MaxTimePointIterations { get; set; } = 50;
+
+		/// <summary>
+		///   Timestep which will be tried by the next call to <see cref="AdvanceInTimeAdaptively" />. It is updated after
+		///   each adaptive step and may be set before the first one to choose the initial timestep.
+		/// </summary>
+		public double NextTimeStep { get; set; } = double.PositiveInfinity;
+
+		/// <summary>
+		///   Largest difference between the predicted and the computed solution at the last timepoint relative to the
+		///   Newton-Raphson tolerance, NaN if the solution was not predicted. When the predictor has the same order as
+		///   the integration method, the difference is proportional to the local truncation error.
+		/// </summary>
+		public double LastPredictorDistance { get; private set; } = double.NaN;
+
+		/// <summary>How many timesteps were rejected and retried with shorter timestep.</summary>
+		public int RejectedTimeStepCount { get; private set; }
+
+		/// <summary>How many times nonlinear devices used cached values instead of evaluating their model.</summary>
+		public int TotalDeviceBypassCount => context?.BypassCount ?? 0;
+
 		/// <summary>Current timepoint of the transient analysis in seconds.</summary>
 		public double CurrentTimePoint => context?.TimePoint ?? 0.0;
 
@@ -95,13 +152,99 @@ namespace NextGenSpice.LargeSignal
 
 			if (timestep > 0)
 			{
-				context.TimePoint = context.TimePoint + timestep;
-				context.TimeStep = timestep;
-				EstablishDcBias_Internal();
+				// without the error control, the highest order allowed by the history is used
+				SetTimePoint(context.TimePoint, timestep, int.MaxValue);
+				var predicted = PredictSolution();
+				EstablishDcBias_Internal(MaxDcPointIterations);
+				UpdatePredictorDistance(predicted);
 				OnDcBiasEstablished();
 			}
 		}
 
+		/// <summary>
+		///   Advances transient simulation of the circuit by a timestep chosen by the local truncation error control. Steps
+		///   whose error exceeds the tolerance or whose Newton-Raphson iterations do not converge are rolled back and
+		///   retried with shorter timestep. The steps land exactly on the breakpoints of the devices, where the
+		///   integration is restarted from the first order.
+		/// </summary>
+		/// <param name="maxTimeStep">Upper bound on the timestep, e.g. distance to the end of the simulation.</param>
+		/// <returns>The accepted timestep.</returns>
+		public double AdvanceInTimeAdaptively(double maxTimeStep)
+		{
+			if (!(maxTimeStep > 0)) throw new ArgumentOutOfRangeException(nameof(maxTimeStep));
+			if (context == null) EstablishDcBias();
+
+			var timePoint = context.TimePoint;
+			var timestep = Math.Min(Math.Min(NextTimeStep, SimulationParameters.MaximumTimeStep), maxTimeStep);
+			Array.Copy(NodeVoltages, acceptedVoltages, NodeVoltages.Length);
+
+			breakpoints.Advance(timePoint + SimulationParameters.MinimumTimeStep);
+			var breakpoint = breakpoints.Next;
+			bool landing;
+
+			while (true)
+			{
+				landing = timePoint + timestep >= breakpoint;
+				if (landing)
+					timestep = breakpoint - timePoint;
+				else if (timePoint + 2 * timestep > breakpoint)
+					timestep = (breakpoint - timePoint) / 2; // avoid very short step right before the breakpoint
+
+				SetTimePoint(timePoint, timestep, integrationOrder);
+				if (landing) context.TimePoint = breakpoint; // avoid rounding errors
+
+				double maxAccurateTimeStep;
+				try
+				{
+					var predicted = PredictSolution();
+					EstablishDcBias_Internal(MaxTimePointIterations);
+					UpdatePredictorDistance(predicted);
+					maxAccurateTimeStep = GetMaxTimeStep();
+				}
+				catch (SimulationException)
+				{
+					// Newton-Raphson iterations failed, retry with much shorter step
+					maxAccurateTimeStep = timestep / 8;
+					refactorNext = true;
+				}
+
+				// allow slightly larger error than requested to avoid rejecting steps due to small fluctuations
+				if (maxAccurateTimeStep >= 0.9 * timestep)
+				{
+					if (bdf != null) maxAccurateTimeStep = SelectIntegrationOrder(maxAccurateTimeStep);
+					NextTimeStep = Math.Min(maxAccurateTimeStep, 2 * timestep);
+					break;
+				}
+
+				// roll back to the last accepted timepoint, the devices did not commit their state yet
+				RejectedTimeStepCount++;
+				Array.Copy(acceptedVoltages, NodeVoltages, NodeVoltages.Length);
+				stampCacheValid = false;
+
+				if (timestep <= SimulationParameters.MinimumTimeStep)
+				{
+					context.TimePoint = timePoint;
+					throw new TimeStepTooSmallException(timePoint);
+				}
+
+				timestep = Math.Max(maxAccurateTimeStep, SimulationParameters.MinimumTimeStep);
+			}
+
+			OnDcBiasEstablished();
+
+			if (landing)
+			{
+				// values before the breakpoint must not be used by the integration methods, start with short step
+				context.RestartIntegration();
+				integrationOrder = 1;
+				stepsAtOrder = 0;
+				breakpoints.Advance(breakpoint);
+				NextTimeStep = 0.1 * Math.Min(NextTimeStep, breakpoints.Next - breakpoint);
+			}
+
+			return timestep;
+		}
+
 		/// <summary>Establishes initial operating point for the transient analysis.</summary>
 		public void EstablishDcBias(bool initCond = false)
 		{
@@ -116,23 +259,35 @@ namespace NextGenSpice.LargeSignal
 					initVoltProxies[2 * i + 1].Add(initialVoltages[i].Value);
 				}
 
-			EstablishDcBias_Internal();
+			EstablishDcBias_Internal(MaxDcPointIterations);
 
 			var iterCount = LastNonLinearIterationCount;
 			LastNonLinearIterationCount = 0;
 
 			// rerun without initial voltages
-			if (!initCond) EstablishDcBias_Internal();
+			if (!initCond) EstablishDcBias_Internal(MaxDcPointIterations);
 
 			LastNonLinearIterationCount += iterCount;
 			OnDcBiasEstablished();
 		}
 
+		/// <summary>
+		///   Releases the native resources held by the equation system and the device groups. The model cannot be used for
+		///   further simulation afterwards.
+		/// </summary>
+		public void Dispose()
+		{
+			(equationSystemAdapter as IDisposable)?.Dispose();
+			deviceGroups?.Dispose();
+		}
+
 		private void EnsureInitialized()
 		{
 			if (context != null) return;
 			context = new SimulationContext(SimulationParameters);
 			TotalNonLinearIterationCount = 0;
+			TotalModifiedNewtonIterationCount = 0;
+			RejectedTimeStepCount = 0;
 
 			// build equation system
 			equationSystemAdapter = EquationSystemAdapterFactory.GetEquationSystemAdapter();
@@ -140,10 +295,34 @@ namespace NextGenSpice.LargeSignal
 			for (var i = 0; i < NodeCount; i++) equationSystemAdapter.AddVariable();
 
 			foreach (var device in Devices)
-				device.RegisterAdditionalVariables(equationSystemAdapter);
+				device.RegisterAdditionalVariables(equationSystemAdapter, context);
+
+			isLinear = devices.All(d => !d.IsNonlinear);
+			linearDevices = devices.Where(d => !d.IsNonlinear).ToArray();
+			nonlinearDevices = devices.Where(d => d.IsNonlinear).ToArray();
+
+			// stamps of linear devices do not change during Newton-Raphson iterations, linear circuits need only one
+			stampCache = SimulationParameters.CacheLinearStamps && !isLinear && linearDevices.Length > 0
+				? new StampCache(equationSystemAdapter)
+				: null;
+			stampCacheValid = false;
+
+			// devices stamped in every iteration are evaluated in parallel
+			parallelAssembly = SimulationParameters.UseParallelAssembly
+				? new ParallelAssembly(equationSystemAdapter, SimulationParameters.AssemblyThreadCount)
+				: null;
 
 			foreach (var device in Devices)
-				device.Initialize(equationSystemAdapter, context);
+			{
+				IEquationSystemAdapter adapter = equationSystemAdapter;
+				if (stampCache != null && !device.IsNonlinear) adapter = stampCache;
+				else if (parallelAssembly != null) adapter = parallelAssembly.Buffer;
+				device.Initialize(adapter, context);
+			}
+
+			// models of the semiconductor devices are evaluated natively for all instances at once
+			deviceGroups = SimulationParameters.UseNativeDeviceEvaluation ? new DeviceGroups(nonlinearDevices) : null;
+			if (deviceGroups?.DeviceCount == 0) deviceGroups = null;
 
 			// get proxies for initial conditions
 			initVoltProxies.Clear();
@@ -162,18 +341,138 @@ namespace NextGenSpice.LargeSignal
 			// finalize making changes
 			equationSystemAdapter.Freeze();
 
+			modifiedNewton = SimulationParameters.UseModifiedNewton && !isLinear
+				? equationSystemAdapter as IModifiedNewtonEquationSystemAdapter
+				: null;
+			refactorNext = false;
+			reuseCount = 0;
+			reusableFactorization = equationSystemAdapter as IReusableFactorizationAdapter;
+			if (reusableFactorization != null)
+				reusableFactorization.ReuseFactorization = isLinear || modifiedNewton != null;
+
 			// allocate temporary arrays
 			currentSolution = new double[equationSystemAdapter.VariableCount];
 			previousSolution = new double[equationSystemAdapter.VariableCount];
+			acceptedVoltages = new double[NodeCount];
+
+			// the predicted solution can be used only if the adapter allows setting its solution
+			solutionSeeding = equationSystemAdapter as ISolutionSeedingAdapter;
+			predictor = SimulationParameters.UseNewtonPredictor && solutionSeeding != null
+				? new SolutionPredictor(currentSolution.Length, SimulationParameters.PredictorOrder)
+				: null;
+			predictedSolution = predictor != null ? new double[currentSolution.Length] : null;
+			LastPredictorDistance = double.NaN;
+
+			breakpoints = new BreakpointQueue(devices);
+			breakpoints.Reset(0);
+
+			bdf = (SimulationParameters.IntegrationMethodFactory as BdfIntegrationMethodFactory)?.Coefficients;
+			integrationOrder = 1;
+			stepsAtOrder = 0;
+		}
+
+		private void SetTimePoint(double previousTimePoint, double timestep, int order)
+		{
+			// the equation matrix of a linear circuit stays the same as long as the timestep does not change,
+			// modified Newton iterations need the LU factors of the previous matrices
+			if (reusableFactorization != null)
+				reusableFactorization.ReuseFactorization =
+					isLinear && timestep == context.TimeStep || modifiedNewton != null;
+
+			context.TimePoint = previousTimePoint + timestep;
+			context.TimeStep = timestep;
+
+			// once per timestep for all devices
+			bdf?.Update(context.TimeStepHistory, order);
 		}
 
-		private void EstablishDcBias_Internal()
+		private bool PredictSolution()
+		{
+			if (predictor == null || !predictor.Predict(context.TimeStepHistory, predictedSolution)) return false;
+
+			// devices linearize their models around the predicted solution in the first iteration
+			Array.Copy(predictedSolution, currentSolution, currentSolution.Length);
+			solutionSeeding.SetSolution(currentSolution);
+			Array.Copy(currentSolution, NodeVoltages, NodeVoltages.Length);
+			for (var i = 0; i < devices.Length; i++) devices[i].OnEquationSolution(context);
+
+			return true;
+		}
+
+		private void UpdatePredictorDistance(bool predicted)
+		{
+			if (!predicted)
+			{
+				LastPredictorDistance = double.NaN;
+				return;
+			}
+
+			var abstol = SimulationParameters.AbsoluteTolerance;
+			var reltol = SimulationParameters.RelativeTolerance;
+
+			var distance = 0.0;
+			for (var i = 0; i < currentSolution.Length; i++)
+			{
+				var tolerance = reltol * Math.Abs(currentSolution[i]) + abstol;
+				distance = Math.Max(distance, Math.Abs(currentSolution[i] - predictedSolution[i]) / tolerance);
+			}
+
+			LastPredictorDistance = distance;
+		}
+
+		private double SelectIntegrationOrder(double maxAccurateTimeStep)
+		{
+			var order = bdf.Order;
+			integrationOrder = order;
+
+			// the order is changed only after enough steps were taken with the current one
+			if (++stepsAtOrder <= order) return maxAccurateTimeStep;
+
+			// choose the order allowing the longest next timestep
+			var best = maxAccurateTimeStep;
+			if (order > 1)
+			{
+				bdf.ErrorOrder = order - 1;
+				var lower = GetMaxTimeStep();
+				if (lower > best)
+				{
+					best = lower;
+					integrationOrder = order - 1;
+				}
+			}
+
+			if (order < bdf.MaxOrder && order < bdf.MaxErrorOrder)
+			{
+				bdf.ErrorOrder = order + 1;
+				var higher = GetMaxTimeStep();
+				if (higher > best)
+				{
+					best = higher;
+					integrationOrder = order + 1;
+				}
+			}
+
+			bdf.ErrorOrder = order;
+			if (integrationOrder != order) stepsAtOrder = 0;
+			return best;
+		}
+
+		private double GetMaxTimeStep()
+		{
+			var timestep = double.PositiveInfinity;
+			for (var i = 0; i < devices.Length; i++)
+				timestep = Math.Min(timestep, devices[i].GetMaxTimeStep(context));
+			return timestep;
+		}
+
+		private void EstablishDcBias_Internal(int maxIterations)
 		{
 			LastNonLinearIterationCount = 0;
+			lastUpdateNorm = double.NaN; // convergence rate is not known at the start of a timepoint
 
 			do
 			{
-				if (LastNonLinearIterationCount++ == MaxDcPointIterations)
+				if (LastNonLinearIterationCount++ == maxIterations)
 					throw new IterationCountExceededException();
 
 				// clear flag;
@@ -181,15 +480,19 @@ namespace NextGenSpice.LargeSignal
 
 				UpdateEquationSystem();
 				SolveAndUpdateVoltages();
-			} while (!context.Converged);
+			} while (!context.Converged && !isLinear); // linear circuits need only one solution
 		}
 
 		private void OnDcBiasEstablished()
 		{
 			for (var i = 0; i < devices.Length; i++)
 				devices[i].OnDcBiasEstablished(context);
+			predictor?.Add(currentSolution);
 
+			// linear devices may change their stamps for the next timepoint
+			stampCacheValid = false;
 			TotalNonLinearIterationCount += LastNonLinearIterationCount;
+			context.AcceptTimeStep();
 		}
 
 		private void SolveAndUpdateVoltages()
@@ -201,23 +504,62 @@ namespace NextGenSpice.LargeSignal
 			currentSolution = previousSolution;
 			previousSolution = tmp;
 
+			var abstol = SimulationParameters.AbsoluteTolerance;
+			var reltol = SimulationParameters.RelativeTolerance;
+
+			var chord = modifiedNewton != null && !refactorNext && modifiedNewton.HasFactors;
+			if (chord)
+				modifiedNewton.SolveChord(currentSolution);
+			else
+				equationSystemAdapter.Solve(currentSolution);
+
+			// check for NaN, copy solution and check tollerances in single pass
+			var status = SolutionUpdate.Apply(currentSolution, NodeVoltages, abstol, reltol, out var updateNorm);
 
-			equationSystemAdapter.Solve(currentSolution);
+			if (chord && (status == SolutionStatus.NotFinite || updateNorm > lastUpdateNorm))
+			{
+				// the old factors are not usable for the current matrix, retry from the previous iterate with full
+				// Newton step
+				chord = false;
+				Array.Copy(previousSolution, NodeVoltages, NodeVoltages.Length);
+				equationSystemAdapter.Solve(currentSolution);
+				status = SolutionUpdate.Apply(currentSolution, NodeVoltages, abstol, reltol, out updateNorm);
+			}
 
-			if (currentSolution.Any(d => double.IsNaN(d)))
+			if (status == SolutionStatus.NotFinite)
 				throw new NaNInEquationSystemSolutionException();
+			if (status == SolutionStatus.NotConverged)
+				context.Converged = false;
+			if (modifiedNewton != null)
+				UpdateModifiedNewtonState(chord, updateNorm);
 
 			for (var i = 0; i < devices.Length; i++) devices[i].OnEquationSolution(context);
+		}
 
-			// copy solution and check tollerances
-			var abstol = SimulationParameters.AbsoluteTolerance;
-			var reltol = SimulationParameters.RelativeTolerance;
-			for (var i = 0; i < NodeCount; i++)
+		private void UpdateModifiedNewtonState(bool chord, double updateNorm)
+		{
+			if (!chord)
 			{
-				if (!MathHelper.InTollerance(NodeVoltages[i], currentSolution[i], abstol, reltol))
-					context.Converged = false;
-				NodeVoltages[i] = currentSolution[i];
+				refactorNext = false;
+				reuseCount = 0;
+				lastUpdateNorm = updateNorm;
+				return;
 			}
+
+			TotalModifiedNewtonIterationCount++;
+
+			// slow contraction means that the old factors are too far from the current Jacobian, the rate is NaN at the
+			// start of a timepoint
+			var rate = updateNorm == 0 ? 0 : updateNorm / lastUpdateNorm;
+			if (rate >= SimulationParameters.ModifiedNewtonContractionThreshold)
+			{
+				refactorNext = true;
+				// small update does not imply convergence when the iterations converge slowly
+				context.Converged = false;
+			}
+
+			if (++reuseCount >= SimulationParameters.ModifiedNewtonMaxReuseCount) refactorNext = true;
+			lastUpdateNorm = updateNorm;
 		}
 
 		private void UpdateEquationSystem()
@@ -226,7 +568,23 @@ namespace NextGenSpice.LargeSignal
 
 			try
 			{
-				for (var i = 0; i < devices.Length; i++) devices[i].ApplyModelValues(context);
+				deviceGroups?.Evaluate(context);
+
+				if (stampCache == null)
+				{
+					Stamp(devices);
+					return;
+				}
+
+				if (!stampCacheValid)
+				{
+					stampCache.Reset();
+					for (var i = 0; i < linearDevices.Length; i++) linearDevices[i].ApplyModelValues(context);
+					stampCacheValid = true;
+				}
+
+				stampCache.Apply();
+				Stamp(nonlinearDevices);
 			}
 			catch (ArgumentNaNException e)
 			{
@@ -234,6 +592,14 @@ namespace NextGenSpice.LargeSignal
 			}
 		}
 
+		private void Stamp(ILargeSignalDevice[] stampedDevices)
+		{
+			if (parallelAssembly != null)
+				parallelAssembly.Stamp(stampedDevices, context);
+			else
+				for (var i = 0; i < stampedDevices.Length; i++) stampedDevices[i].ApplyModelValues(context);
+		}
+
 		private class SimulationContext : ISimulationContext
 		{
 			public SimulationContext(SimulationParameters parameters)
@@ -241,17 +607,49 @@ namespace NextGenSpice.LargeSignal
 				SimulationParameters = parameters;
 			}
 
+			// timesteps leading to the current and the previously accepted timepoints
+			private readonly double[] timeSteps = new double[8];
+
 			public double TimePoint { get; set; }
-			public double TimeStep { get; set; }
+
+			public double TimeStep
+			{
+				get => timeSteps[0];
+				set => timeSteps[0] = value;
+			}
+
+			public IReadOnlyList<double> TimeStepHistory => timeSteps;
 
 			public SimulationParameters SimulationParameters { get; }
 
 			public bool Converged { get; set; }
 
+			private int bypassCount;
+
+			public int BypassCount => bypassCount;
+
+			/// <summary>Shifts the timestep history after the timepoint was accepted.</summary>
+			public void AcceptTimeStep()
+			{
+				Array.Copy(timeSteps, 0, timeSteps, 1, timeSteps.Length - 1);
+			}
+
+			/// <summary>Clears the timestep history so that the next timestep is integrated from the first order.</summary>
+			public void RestartIntegration()
+			{
+				Array.Clear(timeSteps, 1, timeSteps.Length - 1);
+			}
+
 			public void ReportNotConverged(ILargeSignalDevice device)
 			{
 				Converged = false;
 			}
+
+			public void ReportBypass(ILargeSignalDevice device)
+			{
+				// devices may be evaluated in parallel
+				Interlocked.Increment(ref bypassCount);
+			}
 		}
 	}
 }
\ No newline at end of file
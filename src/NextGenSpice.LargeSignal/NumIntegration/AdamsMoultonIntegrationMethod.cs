@@ -1,14 +1,22 @@
 ﻿using System;
+using System.Collections.Generic;
 using System.Linq;
 using NextGenSpice.Numerics.Equations;
 
 namespace NextGenSpice.LargeSignal.NumIntegration
 {
-	/// <summary>Class performing Adams-Moulton integration method of given order.</summary>
+	/// <summary>
+	///   Class performing Adams-Moulton integration method of given order. The coefficients assume constant
+	///   timestep.
+	/// </summary>
 	public class AdamsMoultonIntegrationMethod : IIntegrationMethod
 	{
 		private readonly double[] coefficients;
 		private readonly double derivativeCoeff;
+		private readonly double errorConstant;
+
+		// values for the error estimate
+		private readonly IntegrationHistory history;
 		private readonly double[] states;
 
 		private int baseIndex;
@@ -23,8 +31,13 @@ namespace NextGenSpice.LargeSignal.NumIntegration
 			derivativeCoeff = coef[0];
 
 			states = new double[order - 1];
+			history = new IntegrationHistory(order + 1);
+			errorConstant = GetErrorConstant(order);
 		}
 
+		/// <summary>Order of accuracy of the method.</summary>
+		public int Order => states.Length + 1;
+
 		/// <summary>Adds state and derivative of current timepoint to history.</summary>
 		/// <param name="state">Value of current state variable</param>
 		/// <param name="derivative">Derivative of current state variable</param>
@@ -34,22 +47,39 @@ namespace NextGenSpice.LargeSignal.NumIntegration
 			baseIndex = (baseIndex - 1 + states.Length) % states.Length;
 			states[baseIndex] = state;
 			stateCount++;
+			history.Add(derivative);
 		}
 
 
 		/// <summary>Gets next values of state and derivative based on history and current timepoint.</summary>
 		/// <param name="dx">How far to predict values of state and derivative.</param>
+		/// <param name="timeSteps">
+		///   Lengths of the recent timesteps, the first one leads to the new timepoint, the second one to the last
+		///   accepted timepoint and so on.
+		/// </param>
 		/// <returns></returns>
-		public (double state, double derivative) GetEquivalents(double dx)
+		public (double state, double derivative) GetEquivalents(double dx, IReadOnlyList<double> timeSteps)
 		{
 			if (dx <= 0) throw new ArgumentOutOfRangeException(nameof(dx));
 
-			if (stateCount < states.Length)
+			// the states before the operating point or a breakpoint are not used
+			var count = Math.Min(stateCount, states.Length);
+			for (var i = 1; i <= count; i++)
+				if (i >= timeSteps.Count || !(timeSteps[i] > 0))
+				{
+					count = i - 1;
+					break;
+				}
+
+			if (count == 0 && states.Length > 0)
+				return (dx * derivative, dx);
+
+			if (count < states.Length)
 			{
-				var rec = new AdamsMoultonIntegrationMethod(stateCount + 1);
-				for (var i = 0; i < stateCount; i++)
-					rec.SetState(states[states.Length - 1 - i], derivative);
-				return rec.GetEquivalents(dx);
+				var rec = new AdamsMoultonIntegrationMethod(count + 1);
+				for (var i = count - 1; i >= 0; i--)
+					rec.SetState(states[(baseIndex + i) % states.Length], derivative);
+				return rec.GetEquivalents(dx, timeSteps);
 			}
 
 			var dy = dx / derivativeCoeff;
@@ -61,6 +91,38 @@ namespace NextGenSpice.LargeSignal.NumIntegration
 			return (y, dy);
 		}
 
+		/// <summary>
+		///   Estimates local truncation error of the integrated variable at the new timepoint from the history of its
+		///   values.
+		/// </summary>
+		/// <param name="derivative">Value of the integrated variable at the new timepoint.</param>
+		/// <param name="timeSteps">
+		///   Lengths of the recent timesteps, the first one leads to the new timepoint, the second one to the last
+		///   accepted timepoint and so on.
+		/// </param>
+		/// <returns>Absolute value of the estimated error or NaN if the history is too short for the estimate.</returns>
+		public double GetTruncationError(double derivative, IReadOnlyList<double> timeSteps)
+		{
+			return history.GetTruncationError(derivative, timeSteps, Order, errorConstant);
+		}
+
+		/// <summary>Gets error constant of the Adams-Moulton integration of given order.</summary>
+		/// <param name="order">Order of the integration method</param>
+		/// <returns></returns>
+		public static double GetErrorConstant(int order)
+		{
+			if (order <= 0) throw new ArgumentOutOfRangeException(nameof(order));
+
+			// g[k] = -sum(g[k - j] / (j + 1)) for j = 1..k, g[0] = 1; the error constant of k-th order method is |g[k]|
+			var g = new double[order + 1];
+			g[0] = 1;
+			for (var k = 1; k <= order; k++)
+			for (var j = 1; j <= k; j++)
+				g[k] -= g[k - j] / (j + 1);
+
+			return Math.Abs(g[order]);
+		}
+
 		/// <summary>Gets coefficients for the Adams-Moulton integration of given order.</summary>
 		/// <param name="order">Order of the integration method</param>
 		/// <returns></returns>
@@ -1,27 +1,54 @@
-﻿namespace NextGenSpice.LargeSignal.NumIntegration
+﻿using System.Collections.Generic;
+
+namespace NextGenSpice.LargeSignal.NumIntegration
 {
 	/// <summary>Class implementing basic backward euler integration method.</summary>
 	public class BackwardEulerIntegrationMethod : IIntegrationMethod
 	{
+		// values for the error estimate
+		private readonly IntegrationHistory history = new IntegrationHistory(2);
 		private double derivative;
 
+		/// <summary>Order of accuracy of the method.</summary>
+		public int Order => 1;
+
 		/// <summary>Adds state and derivative of current timepoint to history.</summary>
 		/// <param name="state">Value of current state variable</param>
 		/// <param name="derivative">Derivative of current state variable</param>
 		public void SetState(double state, double derivative)
 		{
 			this.derivative = derivative;
+			history.Add(derivative);
 		}
 
 		/// <summary>Gets next values of state and derivative based on history and current timepoint.</summary>
 		/// <param name="dx">How far to predict values of state and derivative.</param>
+		/// <param name="timeSteps">
+		///   Lengths of the recent timesteps, the first one leads to the new timepoint, the second one to the last
+		///   accepted timepoint and so on.
+		/// </param>
 		/// <returns></returns>
-		public (double state, double derivative) GetEquivalents(double dx)
+		public (double state, double derivative) GetEquivalents(double dx, IReadOnlyList<double> timeSteps)
 		{
 			var dy = dx;
 			var y = dx * derivative;
 
 			return (y, dy);
 		}
+
+		/// <summary>
+		///   Estimates local truncation error of the integrated variable at the new timepoint from the history of its
+		///   values.
+		/// </summary>
+		/// <param name="derivative">Value of the integrated variable at the new timepoint.</param>
+		/// <param name="timeSteps">
+		///   Lengths of the recent timesteps, the first one leads to the new timepoint, the second one to the last
+		///   accepted timepoint and so on.
+		/// </param>
+		/// <returns>Absolute value of the estimated error or NaN if the history is too short for the estimate.</returns>
+		public double GetTruncationError(double derivative, IReadOnlyList<double> timeSteps)
+		{
+			return history.GetTruncationError(derivative, timeSteps, Order, 0.5);
+		}
 	}
 }
\ No newline at end of file
@@ -0,0 +1,144 @@
+using System;
+using System.Collections.Generic;
+
+namespace NextGenSpice.LargeSignal.NumIntegration
+{
+	/// <summary>
+	///   Coefficients of the variable-step backward differentiation formulas (Gear methods) shared by all devices of a
+	///   circuit. The coefficients depend only on the lengths of the recent timesteps, so they are computed once per
+	///   timestep and the devices only combine them with the history of their integrated variables.
+	/// </summary>
+	public class BdfCoefficients
+	{
+		/// <summary>Highest order of the backward differentiation formulas supported.</summary>
+		public const int MaxSupportedOrder = 6;
+
+		// distances of the past timepoints from the new one in multiples of the timestep
+		private readonly double[] distances;
+
+		// errorWeights[k][i] multiplies i-th value (0-th being the new one) in the error estimate of k-th order method
+		private readonly double[][] errorWeights;
+
+		// weights[j] multiplies the value at j-th most recent accepted timepoint
+		private readonly double[] weights;
+
+		/// <summary>Creates coefficients for the methods up to given order.</summary>
+		/// <param name="maxOrder">Highest order of the method that will be used.</param>
+		public BdfCoefficients(int maxOrder)
+		{
+			if (maxOrder < 1 || maxOrder > MaxSupportedOrder) throw new ArgumentOutOfRangeException(nameof(maxOrder));
+
+			MaxOrder = maxOrder;
+			distances = new double[maxOrder + 2];
+			weights = new double[maxOrder + 1];
+			errorWeights = new double[maxOrder + 1][];
+			for (var k = 1; k <= maxOrder; k++) errorWeights[k] = new double[k + 2];
+		}
+
+		/// <summary>Highest order of the method that will be used.</summary>
+		public int MaxOrder { get; }
+
+		/// <summary>Order of the method used for the current timestep.</summary>
+		public int Order { get; private set; }
+
+		/// <summary>
+		///   Order of the method for which the truncation error is estimated. It is the same as <see cref="Order" /> unless
+		///   the order selection evaluates the error of other orders.
+		/// </summary>
+		public int ErrorOrder { get; set; }
+
+		/// <summary>Highest order for which the truncation error can be estimated from the current timestep history.</summary>
+		public int MaxErrorOrder { get; private set; }
+
+		/// <summary>Coefficient of the value at the new timepoint in the approximation of the derivative.</summary>
+		public double DerivativeCoefficient { get; private set; }
+
+		/// <summary>
+		///   Computes the coefficients for the current timestep. The order is lowered when the timestep history does not
+		///   reach far enough into the past, i.e. at the beginning of the simulation and after breakpoints.
+		/// </summary>
+		/// <param name="timeSteps">
+		///   Lengths of the recent timesteps, the first one leads to the new timepoint, the second one to the last
+		///   accepted timepoint and so on.
+		/// </param>
+		/// <param name="order">Requested order of the method.</param>
+		public void Update(IReadOnlyList<double> timeSteps, int order)
+		{
+			var h = timeSteps[0];
+			if (!(h > 0)) throw new ArgumentOutOfRangeException(nameof(timeSteps));
+
+			// timesteps leading from the operating point or to a breakpoint are 0
+			var count = 0;
+			while (count < MaxOrder && count + 1 < timeSteps.Count && timeSteps[count + 1] > 0) count++;
+
+			Order = Math.Max(1, Math.Min(Math.Min(order, MaxOrder), count + 1));
+			ErrorOrder = Order;
+			MaxErrorOrder = count;
+
+			distances[0] = 0;
+			for (var i = 1; i <= count + 1; i++)
+				distances[i] = distances[i - 1] + timeSteps[i - 1] / h;
+
+			DerivativeCoefficient = GetDerivativeWeights(Order);
+
+			// error constant of the k-th order method is 1 / ((k + 1) * a0), the (k + 1)-th derivative is
+			// approximated by (k + 1)! times the divided difference over the new value and k + 1 past values
+			for (var k = 1; k <= count; k++)
+			{
+				var factor = 1.0 / (k + 1) / GetDerivativeCoefficient(k);
+				for (var i = 2; i <= k + 1; i++) factor *= i;
+
+				var w = errorWeights[k];
+				for (var i = 0; i <= k + 1; i++)
+				{
+					var product = 1.0;
+					for (var m = 0; m <= k + 1; m++)
+						if (m != i)
+							product *= distances[m] - distances[i];
+					w[i] = factor / product;
+				}
+			}
+		}
+
+		/// <summary>Gets coefficient of the value at j-th most recent accepted timepoint, j being 1 to Order.</summary>
+		/// <param name="j"></param>
+		/// <returns></returns>
+		public double GetWeight(int j)
+		{
+			return weights[j];
+		}
+
+		/// <summary>
+		///   Gets coefficient of i-th value in the truncation error estimate of the method of the <see cref="ErrorOrder" />,
+		///   the 0-th value being the one at the new timepoint.
+		/// </summary>
+		/// <param name="i"></param>
+		/// <returns></returns>
+		public double GetErrorWeight(int i)
+		{
+			return errorWeights[ErrorOrder][i];
+		}
+
+		private double GetDerivativeCoefficient(int order)
+		{
+			var a0 = 0.0;
+			for (var j = 1; j <= order; j++) a0 += 1 / distances[j];
+			return a0;
+		}
+
+		private double GetDerivativeWeights(int order)
+		{
+			// derivative of the polynomial interpolating the new and the past values, scaled by the timestep
+			for (var j = 1; j <= order; j++)
+			{
+				var weight = 1 / distances[j];
+				for (var m = 1; m <= order; m++)
+					if (m != j)
+						weight *= distances[m] / (distances[m] - distances[j]);
+				weights[j] = weight;
+			}
+
+			return GetDerivativeCoefficient(order);
+		}
+	}
+}
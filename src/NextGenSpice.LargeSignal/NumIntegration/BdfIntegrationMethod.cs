@@ -0,0 +1,73 @@
+using System;
+using System.Collections.Generic;
+
+namespace NextGenSpice.LargeSignal.NumIntegration
+{
+	/// <summary>
+	///   Class implementing the variable-step variable-order backward differentiation formula for a single integrated
+	///   variable. The coefficients and the order are shared by all instances created by the same
+	///   <see cref="BdfIntegrationMethodFactory" />, the instance only keeps the history of the variable.
+	/// </summary>
+	public class BdfIntegrationMethod : IIntegrationMethod
+	{
+		private readonly BdfCoefficients coefficients;
+
+		// one more value than needed by the formula is kept for the error estimate
+		private readonly IntegrationHistory derivatives;
+
+		public BdfIntegrationMethod(BdfCoefficients coefficients)
+		{
+			this.coefficients = coefficients;
+			derivatives = new IntegrationHistory(coefficients.MaxOrder + 1);
+		}
+
+		/// <summary>Order of accuracy of the method.</summary>
+		public int Order => coefficients.ErrorOrder;
+
+		/// <summary>Adds state and derivative of current timepoint to history.</summary>
+		/// <param name="state">Value of current state variable</param>
+		/// <param name="derivative">Derivative of current state variable</param>
+		public void SetState(double state, double derivative)
+		{
+			derivatives.Add(derivative);
+		}
+
+		/// <summary>Gets next values of state and derivative based on history and current timepoint.</summary>
+		/// <param name="dx">How far to predict values of state and derivative.</param>
+		/// <param name="timeSteps">
+		///   Lengths of the recent timesteps, the first one leads to the new timepoint, the second one to the last
+		///   accepted timepoint and so on. The shared coefficients are already computed from them.
+		/// </param>
+		/// <returns></returns>
+		public (double state, double derivative) GetEquivalents(double dx, IReadOnlyList<double> timeSteps)
+		{
+			var y = 0.0;
+			for (var j = 1; j <= coefficients.Order; j++)
+				y += coefficients.GetWeight(j) * derivatives[j - 1];
+
+			return (y * dx, coefficients.DerivativeCoefficient * dx);
+		}
+
+		/// <summary>
+		///   Estimates local truncation error of the integrated variable at the new timepoint from the history of its
+		///   values.
+		/// </summary>
+		/// <param name="derivative">Value of the integrated variable at the new timepoint.</param>
+		/// <param name="timeSteps">
+		///   Lengths of the recent timesteps, the first one leads to the new timepoint, the second one to the last
+		///   accepted timepoint and so on. The shared coefficients are already computed from them.
+		/// </param>
+		/// <returns>Absolute value of the estimated error or NaN if the history is too short for the estimate.</returns>
+		public double GetTruncationError(double derivative, IReadOnlyList<double> timeSteps)
+		{
+			var order = coefficients.ErrorOrder;
+			if (order > coefficients.MaxErrorOrder || derivatives.Count <= order) return double.NaN;
+
+			var error = coefficients.GetErrorWeight(0) * derivative;
+			for (var i = 1; i <= order + 1; i++)
+				error += coefficients.GetErrorWeight(i) * derivatives[i - 1];
+
+			return Math.Abs(error);
+		}
+	}
+}
@@ -0,0 +1,27 @@
+namespace NextGenSpice.LargeSignal.NumIntegration
+{
+	/// <summary>
+	///   Factory for the variable-order backward differentiation formula. All created instances share a single set of
+	///   coefficients which the circuit model updates once per timestep, so the factory must not be shared by multiple
+	///   circuit models.
+	/// </summary>
+	public class BdfIntegrationMethodFactory : IIntegrationMethodFactory
+	{
+		/// <summary>Creates factory for the methods of order 1 to given maximum order.</summary>
+		/// <param name="maxOrder">Highest order of the method, at most <see cref="BdfCoefficients.MaxSupportedOrder" />.</param>
+		public BdfIntegrationMethodFactory(int maxOrder)
+		{
+			Coefficients = new BdfCoefficients(maxOrder);
+		}
+
+		/// <summary>Coefficients shared by the created integration methods.</summary>
+		public BdfCoefficients Coefficients { get; }
+
+		/// <summary>Creates new instance of the integration method implementation.</summary>
+		/// <returns></returns>
+		public IIntegrationMethod CreateInstance()
+		{
+			return new BdfIntegrationMethod(Coefficients);
+		}
+	}
+}
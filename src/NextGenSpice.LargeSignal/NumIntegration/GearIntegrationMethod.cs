@@ -1,18 +1,24 @@
 ﻿using System;
+using System.Collections.Generic;
 using System.Linq;
 using NextGenSpice.Numerics.Equations;
 
 namespace NextGenSpice.LargeSignal.NumIntegration
 {
-	/// <summary>Class implementing the Gear integration method of given order.</summary>
+	/// <summary>
+	///   Class implementing the Gear integration method of given order. When the timestep changes, the coefficients are
+	///   computed from the lengths of the recent timesteps.
+	/// </summary>
 	public class GearIntegrationMethod : IIntegrationMethod
 	{
 		private readonly double[] coefficients;
-		private readonly double[] derivatives;
+
+		// one more value than needed by the formula is kept for the error estimate
+		private readonly IntegrationHistory derivatives;
 		private readonly double normalizingCoeff;
-		private int baseIndex;
 
-		private int stateCount;
+		// distances of the past timepoints from the new one for the variable step coefficients
+		private readonly double[] distances;
 
 		public GearIntegrationMethod(int order)
 		{
@@ -20,41 +26,104 @@ namespace NextGenSpice.LargeSignal.NumIntegration
 			coefficients = coef.Skip(1).ToArray();
 			normalizingCoeff = coef[0];
 
-			derivatives = new double[order];
+			derivatives = new IntegrationHistory(order + 1);
+			distances = new double[order + 1];
 		}
 
+		/// <summary>Order of accuracy of the method.</summary>
+		public int Order => coefficients.Length;
+
 		/// <summary>Adds state and derivative of current timepoint to history.</summary>
 		/// <param name="state">Value of current state variable</param>
 		/// <param name="derivative">Derivative of current state variable</param>
 		public void SetState(double state, double derivative)
 		{
-			baseIndex = (baseIndex - 1 + derivatives.Length) % derivatives.Length;
-			derivatives[baseIndex] = derivative;
-			stateCount++;
+			derivatives.Add(derivative);
 		}
 
 		/// <summary>Gets next values of state and derivative based on history and current timepoint.</summary>
 		/// <param name="dx">How far to predict values of state and derivative.</param>
+		/// <param name="timeSteps">
+		///   Lengths of the recent timesteps, the first one leads to the new timepoint, the second one to the last
+		///   accepted timepoint and so on.
+		/// </param>
 		/// <returns></returns>
-		public (double state, double derivative) GetEquivalents(double dx)
+		public (double state, double derivative) GetEquivalents(double dx, IReadOnlyList<double> timeSteps)
+		{
+			// the history is shorter at the beginning of the simulation and after breakpoints
+			var order = Math.Min(Math.Min(coefficients.Length, derivatives.Count), timeSteps.Count);
+			for (var i = 1; i < order; i++)
+				if (!(timeSteps[i] > 0))
+				{
+					order = i;
+					break;
+				}
+
+			var h = timeSteps[0];
+
+			var uniform = order == coefficients.Length;
+			for (var i = 1; i < order && uniform; i++)
+				uniform = timeSteps[i] == h;
+
+			// precomputed coefficients are valid only for constant timestep
+			if (uniform || !(h > 0)) return GetEquivalents(dx);
+
+			// differentiate the polynomial interpolating the new and the past values, the weights are scaled by h
+			distances[0] = 0;
+			for (var i = 1; i <= order; i++)
+				distances[i] = distances[i - 1] + timeSteps[i - 1] / h;
+
+			var dy = 0.0;
+			var y = 0.0;
+			for (var j = 1; j <= order; j++)
+			{
+				dy += 1 / distances[j];
+
+				var weight = -1 / distances[j];
+				for (var m = 1; m <= order; m++)
+					if (m != j)
+						weight *= distances[m] / (distances[m] - distances[j]);
+				y -= weight * derivatives[j - 1];
+			}
+
+			return (y * dx, dy * dx);
+		}
+
+		private (double state, double derivative) GetEquivalents(double dx)
 		{
-			if (stateCount < derivatives.Length)
+			if (derivatives.Count < coefficients.Length)
 			{
-				var rec = new GearIntegrationMethod(stateCount);
-				for (var i = 0; i < stateCount; i++)
-					rec.SetState(0, derivatives[derivatives.Length - 1 - i]);
+				var rec = new GearIntegrationMethod(derivatives.Count);
+				for (var i = derivatives.Count - 1; i >= 0; i--)
+					rec.SetState(0, derivatives[i]);
 				return rec.GetEquivalents(dx);
 			}
 
 			var dy = dx / normalizingCoeff;
 			var y = 0.0;
-			for (var i = 0; i < derivatives.Length; i++)
-				y += coefficients[i] * dx * derivatives[(baseIndex + i) % derivatives.Length];
+			for (var i = 0; i < coefficients.Length; i++)
+				y += coefficients[i] * dx * derivatives[i];
 			y /= normalizingCoeff;
 
 			return (y, dy);
 		}
 
+		/// <summary>
+		///   Estimates local truncation error of the integrated variable at the new timepoint from the history of its
+		///   values.
+		/// </summary>
+		/// <param name="derivative">Value of the integrated variable at the new timepoint.</param>
+		/// <param name="timeSteps">
+		///   Lengths of the recent timesteps, the first one leads to the new timepoint, the second one to the last
+		///   accepted timepoint and so on.
+		/// </param>
+		/// <returns>Absolute value of the estimated error or NaN if the history is too short for the estimate.</returns>
+		public double GetTruncationError(double derivative, IReadOnlyList<double> timeSteps)
+		{
+			// error constant of the k-th order BDF is beta / (k + 1), beta being the normalizing coefficient
+			return derivatives.GetTruncationError(derivative, timeSteps, Order, normalizingCoeff / (Order + 1));
+		}
+
 		/// <summary>Gets coeffitients for Gear integration method of given order.</summary>
 		/// <param name="order"></param>
 		/// <returns></returns>
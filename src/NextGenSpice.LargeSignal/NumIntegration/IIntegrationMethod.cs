@@ -1,8 +1,13 @@
-﻿namespace NextGenSpice.LargeSignal.NumIntegration
+﻿using System.Collections.Generic;
+
+namespace NextGenSpice.LargeSignal.NumIntegration
 {
 	/// <summary>Defines basic interface for numeric integration methods to be used in model classes.</summary>
 	public interface IIntegrationMethod
 	{
+		/// <summary>Order of accuracy of the method.</summary>
+		int Order { get; }
+
 		/// <summary>Adds state and derivative of current timepoint to history.</summary>
 		/// <param name="state">Value of current state variable</param>
 		/// <param name="derivative">Derivative of current state variable</param>
@@ -10,7 +15,23 @@
 
 		/// <summary>Gets next values of state and derivative based on history and current timepoint.</summary>
 		/// <param name="dx">How far to predict values of state and derivative.</param>
+		/// <param name="timeSteps">
+		///   Lengths of the recent timesteps, the first one leads to the new timepoint, the second one to the last
+		///   accepted timepoint and so on.
+		/// </param>
 		/// <returns></returns>
-		(double state, double derivative) GetEquivalents(double dx);
+		(double state, double derivative) GetEquivalents(double dx, IReadOnlyList<double> timeSteps);
+
+		/// <summary>
+		///   Estimates local truncation error of the integrated variable at the new timepoint from the history of its
+		///   values.
+		/// </summary>
+		/// <param name="derivative">Value of the integrated variable at the new timepoint.</param>
+		/// <param name="timeSteps">
+		///   Lengths of the recent timesteps, the first one leads to the new timepoint, the second one to the last
+		///   accepted timepoint and so on.
+		/// </param>
+		/// <returns>Absolute value of the estimated error or NaN if the history is too short for the estimate.</returns>
+		double GetTruncationError(double derivative, IReadOnlyList<double> timeSteps);
 	}
 }
\ No newline at end of file
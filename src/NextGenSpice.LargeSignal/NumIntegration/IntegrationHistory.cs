@@ -0,0 +1,79 @@
+using System;
+using System.Collections.Generic;
+
+namespace NextGenSpice.LargeSignal.NumIntegration
+{
+	/// <summary>
+	///   Values of an integrated variable at the last accepted timepoints. Besides providing the history for the
+	///   integration formulas, it estimates the local truncation error of a new value from the divided differences over
+	///   the stored values.
+	/// </summary>
+	internal class IntegrationHistory
+	{
+		private readonly double[] differences;
+		private readonly double[] times;
+		private readonly double[] values;
+		private int baseIndex;
+
+		public IntegrationHistory(int capacity)
+		{
+			values = new double[capacity];
+			differences = new double[capacity + 1];
+			times = new double[capacity + 1];
+		}
+
+		/// <summary>Number of stored values, at most the capacity of the history.</summary>
+		public int Count { get; private set; }
+
+		/// <summary>Gets i-th most recent value, the 0-th being the last added one.</summary>
+		/// <param name="i"></param>
+		/// <returns></returns>
+		public double this[int i] => values[(baseIndex + i) % values.Length];
+
+		/// <summary>Adds value at the newly accepted timepoint, the oldest value is discarded if the history is full.</summary>
+		/// <param name="value"></param>
+		public void Add(double value)
+		{
+			baseIndex = (baseIndex - 1 + values.Length) % values.Length;
+			values[baseIndex] = value;
+			if (Count < values.Length) Count++;
+		}
+
+		/// <summary>
+		///   Estimates local truncation error of the new value of the variable integrated by a method of given order. The
+		///   (order + 1)-th derivative is approximated by the divided difference over the new value and order + 1 most
+		///   recent values.
+		/// </summary>
+		/// <param name="value">Value of the integrated variable at the new timepoint.</param>
+		/// <param name="timeSteps">Lengths of the timesteps leading to the new timepoint and the stored values.</param>
+		/// <param name="order">Order of the integration method.</param>
+		/// <param name="errorConstant">Error constant of the integration method.</param>
+		/// <returns>The estimated error or NaN if there is not enough values in the history.</returns>
+		public double GetTruncationError(double value, IReadOnlyList<double> timeSteps, int order, double errorConstant)
+		{
+			var n = order + 1;
+			if (Count < n || timeSteps.Count < n) return double.NaN;
+
+			times[0] = 0;
+			differences[0] = value;
+			for (var i = 0; i < n; i++)
+			{
+				var step = timeSteps[i];
+				if (!(step > 0)) return double.NaN; // the history reaches the operating point
+
+				times[i + 1] = times[i] - step;
+				differences[i + 1] = this[i];
+			}
+
+			for (var level = 1; level <= n; level++)
+			for (var i = 0; i <= n - level; i++)
+				differences[i] = (differences[i] - differences[i + 1]) / (times[i] - times[i + level]);
+
+			// error constant * h^(k+1) * y^(k+1), where y^(k+1) = (k+1)! times the divided difference
+			var error = errorConstant * differences[0];
+			for (var i = 1; i <= n; i++) error *= i * timeSteps[0];
+
+			return Math.Abs(error);
+		}
+	}
+}
@@ -0,0 +1,29 @@
+using System;
+
+namespace NextGenSpice.LargeSignal.NumIntegration
+{
+	public static class IntegrationMethodExtensions
+	{
+		/// <summary>
+		///   Computes the largest timestep for which the local truncation error of the integrated variable would be within
+		///   the tolerance given by the simulation parameters.
+		/// </summary>
+		/// <param name="method">The integration method.</param>
+		/// <param name="derivative">Value of the integrated variable at the new timepoint.</param>
+		/// <param name="context">Context of current simulation.</param>
+		/// <returns>The timestep, positive infinity if the history is too short for the error estimate.</returns>
+		public static double GetMaxTimeStep(this IIntegrationMethod method, double derivative,
+			ISimulationContext context)
+		{
+			var error = method.GetTruncationError(derivative, context.TimeStepHistory);
+			if (double.IsNaN(error)) return double.PositiveInfinity;
+
+			var parameters = context.SimulationParameters;
+			var tolerance = parameters.TruncationErrorTolerance *
+			                (parameters.RelativeTolerance * Math.Abs(derivative) + parameters.AbsoluteTolerance);
+
+			// the error grows with (order + 1)-th power of the timestep
+			return context.TimeStep * Math.Pow(tolerance / error, 1.0 / (method.Order + 1));
+		}
+	}
+}
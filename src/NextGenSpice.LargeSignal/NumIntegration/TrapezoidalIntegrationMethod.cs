@@ -1,11 +1,18 @@
-﻿namespace NextGenSpice.LargeSignal.NumIntegration
+﻿using System.Collections.Generic;
+
+namespace NextGenSpice.LargeSignal.NumIntegration
 {
 	/// <summary>Class implementing implicit trapezoidal integration method.</summary>
 	public class TrapezoidalIntegrationMethod : IIntegrationMethod
 	{
+		// values for the error estimate
+		private readonly IntegrationHistory history = new IntegrationHistory(3);
 		private double derivative;
 		private double state;
 
+		/// <summary>Order of accuracy of the method.</summary>
+		public int Order => 2;
+
 		/// <summary>Adds state and derivative of current timepoint to history.</summary>
 		/// <param name="state">Value of current state variable</param>
 		/// <param name="derivative">Derivative of current state variable</param>
@@ -13,17 +20,41 @@
 		{
 			this.derivative = derivative;
 			this.state = state;
+			history.Add(derivative);
 		}
 
 		/// <summary>Gets next values of state and derivative based on history and current timepoint.</summary>
 		/// <param name="dx">How far to predict values of state and derivative.</param>
+		/// <param name="timeSteps">
+		///   Lengths of the recent timesteps, the first one leads to the new timepoint, the second one to the last
+		///   accepted timepoint and so on.
+		/// </param>
 		/// <returns></returns>
-		public (double state, double derivative) GetEquivalents(double dx)
+		public (double state, double derivative) GetEquivalents(double dx, IReadOnlyList<double> timeSteps)
 		{
+			// the state may be discontinuous at a breakpoint, restart by a backward Euler step
+			if (timeSteps.Count < 2 || !(timeSteps[1] > 0))
+				return (dx * derivative, dx);
+
 			var dy = 2 * dx;
 			var y = dy * derivative + state;
 
 			return (y, dy);
 		}
+
+		/// <summary>
+		///   Estimates local truncation error of the integrated variable at the new timepoint from the history of its
+		///   values.
+		/// </summary>
+		/// <param name="derivative">Value of the integrated variable at the new timepoint.</param>
+		/// <param name="timeSteps">
+		///   Lengths of the recent timesteps, the first one leads to the new timepoint, the second one to the last
+		///   accepted timepoint and so on.
+		/// </param>
+		/// <returns>Absolute value of the estimated error or NaN if the history is too short for the estimate.</returns>
+		public double GetTruncationError(double derivative, IReadOnlyList<double> timeSteps)
+		{
+			return history.GetTruncationError(derivative, timeSteps, Order, 1.0 / 12);
+		}
 	}
 }
\ No newline at end of file
@@ -0,0 +1,83 @@
+using System;
+using System.Runtime.ExceptionServices;
+using System.Threading.Tasks;
+using NextGenSpice.LargeSignal.Devices;
+using NextGenSpice.Numerics.Equations;
+
+namespace NextGenSpice.LargeSignal
+{
+	/// <summary>
+	///   Stamps devices onto the equation system by multiple threads. The devices stamp into private accumulators of a
+	///   <see cref="StampBuffer" />, which are added to the equation system in the order of the devices once all devices
+	///   are evaluated. The resulting equation system is therefore deterministic regardless of thread count and
+	///   scheduling, although it may differ in the last bits from the serial assembly.
+	/// </summary>
+	public class ParallelAssembly
+	{
+		/// <summary>Creates parallel assembly stamping through a new buffer over given adapter.</summary>
+		/// <param name="adapter">The equation system adapter to which the stamps are added.</param>
+		/// <param name="threadCount">Number of threads, 0 means number of processors.</param>
+		public ParallelAssembly(IEquationSystemAdapter adapter, int threadCount)
+		{
+			if (threadCount < 0) throw new ArgumentOutOfRangeException(nameof(threadCount));
+
+			Buffer = new StampBuffer(adapter);
+			ThreadCount = threadCount == 0 ? Environment.ProcessorCount : threadCount;
+		}
+
+		/// <summary>The buffer through which the devices evaluated in parallel must be initialized.</summary>
+		public StampBuffer Buffer { get; }
+
+		/// <summary>Number of threads stamping the devices.</summary>
+		public int ThreadCount { get; }
+
+		/// <summary>
+		///   Evaluates given devices in contiguous partitions, one per thread, and adds their stamps to the equation
+		///   system.
+		/// </summary>
+		/// <param name="devices">Devices initialized with <see cref="Buffer" />.</param>
+		/// <param name="context">Context of current simulation.</param>
+		public void Stamp(ILargeSignalDevice[] devices, ISimulationContext context)
+		{
+			try
+			{
+				Evaluate(devices, context);
+			}
+			catch
+			{
+				// discard the stamps of the devices evaluated before the failure, the assembly may be retried
+				Buffer.Clear();
+				throw;
+			}
+
+			Buffer.Apply();
+		}
+
+		private void Evaluate(ILargeSignalDevice[] devices, ISimulationContext context)
+		{
+			var partitions = Math.Min(ThreadCount, devices.Length);
+
+			if (partitions <= 1)
+			{
+				for (var i = 0; i < devices.Length; i++) devices[i].ApplyModelValues(context);
+			}
+			else
+			{
+				try
+				{
+					Parallel.For(0, partitions, p =>
+					{
+						var end = (int) ((long) devices.Length * (p + 1) / partitions);
+						for (var i = (int) ((long) devices.Length * p / partitions); i < end; i++)
+							devices[i].ApplyModelValues(context);
+					});
+				}
+				catch (AggregateException e)
+				{
+					// rethrow the original exception so that it is handled the same way as in the serial evaluation
+					ExceptionDispatchInfo.Capture(e.InnerExceptions[0]).Throw();
+				}
+			}
+		}
+	}
+}
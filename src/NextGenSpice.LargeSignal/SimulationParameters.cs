@@ -1,5 +1,6 @@
 ﻿using System;
 using NextGenSpice.LargeSignal.NumIntegration;
+using NextGenSpice.Numerics.Equations;
 
 namespace NextGenSpice.LargeSignal
 {
@@ -7,7 +8,8 @@ namespace NextGenSpice.LargeSignal
 	public class SimulationParameters
 	{
 		private IIntegrationMethodFactory integrationMethodFactory =
-			new SimpleIntegrationMethodFactory(() => new GearIntegrationMethod(2));
+			new BdfIntegrationMethodFactory(2);
+//            new SimpleIntegrationMethodFactory(() => new GearIntegrationMethod(2));
 //            new SimpleIntegrationMethodFactory(() => new BackwardEulerIntegrationMethod());
 //            new SimpleIntegrationMethodFactory(() => new TrapezoidalIntegrationMethod());
 
@@ -20,6 +22,88 @@ namespace NextGenSpice.LargeSignal
 		/// <summary>Absolute tolerance for Newton-Raphson iterations convergence check.</summary>
 		public double AbsoluteTolerance { get; set; } = 1e-9;
 
+		/// <summary>
+		///   If true, stamps of linear devices in a nonlinear circuit are computed once per timepoint and reused in all
+		///   Newton-Raphson iterations, only the nonlinear devices are stamped in every iteration.
+		/// </summary>
+		public bool CacheLinearStamps { get; set; } = true;
+
+		/// <summary>
+		///   If true, capacitors and junction capacitances are stamped with an additional branch variable holding their
+		///   current. Otherwise they are stamped as a conductance in parallel with a current source and the current is
+		///   computed from the integration state, which keeps the equation system smaller.
+		/// </summary>
+		public bool UseCapacitorBranchCurrents { get; set; }
+
+		/// <summary>
+		///   If true, Newton-Raphson iterations of nonlinear circuits reuse LU factors of an older equation matrix
+		///   (modified Newton or chord method) as long as they converge fast enough. Requires equation system adapter
+		///   implementing IModifiedNewtonEquationSystemAdapter, otherwise it has no effect.
+		/// </summary>
+		public bool UseModifiedNewton { get; set; }
+
+		/// <summary>
+		///   Maximum ratio of the sizes of two successive updates of the solution for which the LU factors are kept. Slower
+		///   convergence causes refactorization in the next iteration.
+		/// </summary>
+		public double ModifiedNewtonContractionThreshold { get; set; } = 0.3;
+
+		/// <summary>Maximum number of successive iterations which reuse the same LU factors.</summary>
+		public int ModifiedNewtonMaxReuseCount { get; set; } = 20;
+
+		/// <summary>
+		///   If true, Newton-Raphson iterations at each timepoint of the transient analysis start from the solution
+		///   extrapolated from the last accepted timepoints instead of from the solution at the last timepoint. Has no
+		///   effect if the equation system adapter does not implement <see cref="ISolutionSeedingAdapter" />.
+		/// </summary>
+		public bool UseNewtonPredictor { get; set; }
+
+		/// <summary>Degree of the polynomial extrapolating the starting point of the Newton-Raphson iterations.</summary>
+		public int PredictorOrder { get; set; } = 2;
+
+		/// <summary>
+		///   If true, models of all diodes and bipolar junction transistors are evaluated in a single native call per
+		///   device kind in each Newton-Raphson iteration instead of by each device separately. The native exponential
+		///   may differ from the managed one in the last bits, so the results may differ slightly.
+		/// </summary>
+		public bool UseNativeDeviceEvaluation { get; set; }
+
+		/// <summary>
+		///   If true, nonlinear devices whose controlling voltages changed less than the bypass tolerance since the last
+		///   evaluation of the device model stamp the cached values instead of evaluating the model again. The model
+		///   evaluation is saved only by devices evaluated separately, with <see cref="UseNativeDeviceEvaluation" /> the
+		///   grouped models are evaluated for all devices and the bypassed devices only ignore the new values.
+		/// </summary>
+		public bool UseDeviceBypass { get; set; }
+
+		/// <summary>
+		///   Absolute tolerance of the controlling voltages of nonlinear devices for the device bypass, the
+		///   <see cref="RelativeTolerance" /> is used as the relative part.
+		/// </summary>
+		public double BypassVoltageTolerance { get; set; } = 1e-6;
+
+		/// <summary>
+		///   If true, devices stamped in each Newton-Raphson iteration are evaluated by multiple threads. Each device
+		///   stamps into private accumulators which are summed in a fixed order, so the results are deterministic
+		///   regardless of thread count. They may differ in the last bits from the serial assembly.
+		/// </summary>
+		public bool UseParallelAssembly { get; set; }
+
+		/// <summary>Number of threads used by the parallel assembly, 0 means number of processors.</summary>
+		public int AssemblyThreadCount { get; set; }
+
+		/// <summary>
+		///   Ratio of the allowed local truncation error to the Newton-Raphson tolerance of the integrated variable, used
+		///   when the timestep is controlled by the truncation error.
+		/// </summary>
+		public double TruncationErrorTolerance { get; set; } = 7;
+
+		/// <summary>Smallest timestep to which a step may be shortened after it was rejected.</summary>
+		public double MinimumTimeStep { get; set; } = 1e-15;
+
+		/// <summary>Largest timestep chosen by the truncation error control.</summary>
+		public double MaximumTimeStep { get; set; } = double.PositiveInfinity;
+
 		/// <summary>Factory for preffered integration method for circuit devices.</summary>
 		public IIntegrationMethodFactory IntegrationMethodFactory
 		{
@@ -0,0 +1,92 @@
+using System;
+using System.Collections.Generic;
+
+namespace NextGenSpice.LargeSignal
+{
+	/// <summary>
+	///   Extrapolates the solution of the equation system at the new timepoint by the polynomial interpolating the
+	///   solutions at the last accepted timepoints. The prediction is used as the starting point of the Newton-Raphson
+	///   iterations.
+	/// </summary>
+	internal class SolutionPredictor
+	{
+		// distances of the past timepoints from the new one in multiples of the timestep
+		private readonly double[] distances;
+
+		// ring buffer of the solutions at the last accepted timepoints
+		private readonly double[][] solutions;
+
+		private readonly double[] weights;
+		private int baseIndex;
+		private int count;
+
+		/// <summary>Creates predictor of given maximum order for equation system with given number of variables.</summary>
+		/// <param name="variableCount">Number of variables of the equation system.</param>
+		/// <param name="maxOrder">Degree of the extrapolation polynomial, uses maxOrder + 1 past solutions.</param>
+		public SolutionPredictor(int variableCount, int maxOrder)
+		{
+			if (maxOrder < 1) throw new ArgumentOutOfRangeException(nameof(maxOrder));
+
+			solutions = new double[maxOrder + 1][];
+			for (var i = 0; i < solutions.Length; i++) solutions[i] = new double[variableCount];
+			distances = new double[maxOrder + 2];
+			weights = new double[maxOrder + 1];
+		}
+
+		/// <summary>Degree of the polynomial used in the last prediction.</summary>
+		public int LastOrder { get; private set; }
+
+		/// <summary>Adds solution at the newly accepted timepoint.</summary>
+		/// <param name="solution"></param>
+		public void Add(double[] solution)
+		{
+			baseIndex = (baseIndex - 1 + solutions.Length) % solutions.Length;
+			Array.Copy(solution, solutions[baseIndex], solution.Length);
+			if (count < solutions.Length) count++;
+		}
+
+		/// <summary>
+		///   Extrapolates the solution at the new timepoint. Only the solutions after the operating point or the last
+		///   breakpoint are used.
+		/// </summary>
+		/// <param name="timeSteps">
+		///   Lengths of the recent timesteps, the first one leads to the new timepoint, the second one to the last
+		///   accepted timepoint and so on.
+		/// </param>
+		/// <param name="target">Array to which the predicted solution is stored.</param>
+		/// <returns>False if there is not enough history for the extrapolation, target is not modified.</returns>
+		public bool Predict(IReadOnlyList<double> timeSteps, double[] target)
+		{
+			var order = 0;
+			while (order + 1 < count && order + 1 < timeSteps.Count && timeSteps[order + 1] > 0) order++;
+
+			LastOrder = order;
+			var h = timeSteps[0];
+			if (order == 0 || !(h > 0)) return false;
+
+			distances[0] = 0;
+			for (var i = 1; i <= order + 1; i++)
+				distances[i] = distances[i - 1] + timeSteps[i - 1] / h;
+
+			// Lagrange basis polynomials at the new timepoint
+			for (var j = 0; j <= order; j++)
+			{
+				var weight = 1.0;
+				for (var m = 0; m <= order; m++)
+					if (m != j)
+						weight *= distances[m + 1] / (distances[m + 1] - distances[j + 1]);
+				weights[j] = weight;
+			}
+
+			Array.Clear(target, 0, target.Length);
+			for (var j = 0; j <= order; j++)
+			{
+				var solution = solutions[(baseIndex + j) % solutions.Length];
+				var weight = weights[j];
+				for (var i = 0; i < target.Length; i++) target[i] += weight * solution[i];
+			}
+
+			return true;
+		}
+	}
+}
@@ -0,0 +1,51 @@
+using NextGenSpice.Numerics.Equations;
+
+namespace NextGenSpice.LargeSignal.Stamping
+{
+	/// <summary>
+	///   Helper class for stamping capacitor devices onto the equation system as a conductance in parallel with a current
+	///   source. No branch variable is needed, the current is computed from the voltage and the last stamped values.
+	/// </summary>
+	public class CapacitorStamper : ICapacitorStamper
+	{
+		private readonly ConductanceStamper cond = new ConductanceStamper();
+		private readonly CurrentStamper current = new CurrentStamper();
+		private readonly VoltageProxy voltage = new VoltageProxy();
+
+		private double geq;
+		private double ieq;
+
+		/// <summary>The companion model needs no additional variables.</summary>
+		/// <param name="adapter">The equation system adapter.</param>
+		public void RegisterVariable(IEquationSystemAdapter adapter)
+		{
+		}
+
+		/// <summary>Registeres the equation system coefficient proxies into the stamper.</summary>
+		/// <param name="adapter">The equation system adapter.</param>
+		/// <param name="anode">Index of anode terminal.</param>
+		/// <param name="cathode">Index of cathode terminal.</param>
+		public void Register(IEquationSystemAdapter adapter, int anode, int cathode)
+		{
+			cond.Register(adapter, anode, cathode);
+			current.Register(adapter, anode, cathode); // current faces the other way
+			voltage.Register(adapter, anode, cathode);
+		}
+
+		/// <summary>Stamps the device characteristics onto the equation system through the registered proxies.</summary>
+		public void Stamp(double ieq, double geq)
+		{
+			this.ieq = ieq;
+			this.geq = geq;
+
+			cond.Stamp(geq);
+			current.Stamp(-ieq);
+		}
+
+		/// <summary>Gets the current through the capacitor corresponding to the last stamped values.</summary>
+		public double GetCurrent()
+		{
+			return geq * voltage.GetValue() - ieq;
+		}
+	}
+}
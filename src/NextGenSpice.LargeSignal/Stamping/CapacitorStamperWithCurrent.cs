@@ -2,39 +2,16 @@
 
 namespace NextGenSpice.LargeSignal.Stamping
 {
-	public class CapacitorStamper
-	{
-		private readonly ConductanceStamper cond = new ConductanceStamper();
-		private readonly CurrentStamper current = new CurrentStamper();
-
-		/// <summary>Registeres the equation system coefficient proxies into the stamper.</summary>
-		/// <param name="adapter">The equation system adapter.</param>
-		/// <param name="anode">Index of anode terminal.</param>
-		/// <param name="cathode">Index of cathode terminal.</param>
-		public void Register(IEquationSystemAdapter adapter, int anode, int cathode)
-		{
-			cond.Register(adapter, anode, cathode);
-			current.Register(adapter, anode, cathode); // current faces the other way
-		}
-
-		/// <summary>Stamps the device characteristics onto the equation system through the registered proxies.</summary>
-		public void Stamp(double geq, double ieq)
-		{
-			cond.Stamp(geq);
-			current.Stamp(ieq);
-		}
-	}
-
 	/// <summary>Helper class for stamping capacitor devices onto the equation system.</summary>
-	public class CapacitorStamperWithCurrent
+	public class CapacitorStamperWithCurrent : ICapacitorStamper
 	{
-		private IEquationSystemCoefficientProxy nab;
+		private CoefficientSlot nab;
 
-		private IEquationSystemCoefficientProxy nb;
-		private IEquationSystemCoefficientProxy nba;
-		private IEquationSystemCoefficientProxy nbb;
-		private IEquationSystemCoefficientProxy nbc;
-		private IEquationSystemCoefficientProxy ncb;
+		private CoefficientSlot nb;
+		private CoefficientSlot nba;
+		private CoefficientSlot nbb;
+		private CoefficientSlot nbc;
+		private CoefficientSlot ncb;
 
 		private IEquationSystemSolutionProxy sol;
 
@@ -56,13 +33,13 @@ namespace NextGenSpice.LargeSignal.Stamping
 		/// <param name="cathode">Index of cathode terminal.</param>
 		public void Register(IEquationSystemAdapter adapter, int anode, int cathode)
 		{
-			nba = adapter.GetMatrixCoefficientProxy(BranchVariable, anode);
-			nbc = adapter.GetMatrixCoefficientProxy(BranchVariable, cathode);
-			nab = adapter.GetMatrixCoefficientProxy(anode, BranchVariable);
-			ncb = adapter.GetMatrixCoefficientProxy(cathode, BranchVariable);
-			nbb = adapter.GetMatrixCoefficientProxy(BranchVariable, BranchVariable);
+			nba = adapter.GetMatrixCoefficientSlot(BranchVariable, anode);
+			nbc = adapter.GetMatrixCoefficientSlot(BranchVariable, cathode);
+			nab = adapter.GetMatrixCoefficientSlot(anode, BranchVariable);
+			ncb = adapter.GetMatrixCoefficientSlot(cathode, BranchVariable);
+			nbb = adapter.GetMatrixCoefficientSlot(BranchVariable, BranchVariable);
 
-			nb = adapter.GetRightHandSideCoefficientProxy(BranchVariable);
+			nb = adapter.GetRightHandSideCoefficientSlot(BranchVariable);
 
 			sol = adapter.GetSolutionProxy(BranchVariable);
 		}
@@ -5,8 +5,8 @@ namespace NextGenSpice.LargeSignal.Stamping
 	/// <summary>Helper class for stamping current controlled current source devices onto the equation system.</summary>
 	public class CccsStamper
 	{
-		private IEquationSystemCoefficientProxy na;
-		private IEquationSystemCoefficientProxy nc;
+		private CoefficientSlot na;
+		private CoefficientSlot nc;
 
 		/// <summary>Registeres the equation system coefficient proxies into the stamper.</summary>
 		/// <param name="adapter">The equation system adapter.</param>
@@ -15,8 +15,8 @@ namespace NextGenSpice.LargeSignal.Stamping
 		/// <param name="branch">Index of variable containing the reference current.</param>
 		public void Register(IEquationSystemAdapter adapter, int anode, int cathode, int branch)
 		{
-			na = adapter.GetMatrixCoefficientProxy(anode, branch);
-			nc = adapter.GetMatrixCoefficientProxy(cathode, branch);
+			na = adapter.GetMatrixCoefficientSlot(anode, branch);
+			nc = adapter.GetMatrixCoefficientSlot(cathode, branch);
 		}
 
 		/// <summary>Stamps the device characteristics onto the equation system through the registered proxies.</summary>
@@ -5,11 +5,11 @@ namespace NextGenSpice.LargeSignal.Stamping
 	/// <summary>Helper class for stamping current controlled voltage source devices onto the equation system.</summary>
 	public class CcvsStamper
 	{
-		private IEquationSystemCoefficientProxy n14;
-		private IEquationSystemCoefficientProxy n24;
-		private IEquationSystemCoefficientProxy n41;
-		private IEquationSystemCoefficientProxy n42;
-		private IEquationSystemCoefficientProxy n43;
+		private CoefficientSlot n14;
+		private CoefficientSlot n24;
+		private CoefficientSlot n41;
+		private CoefficientSlot n42;
+		private CoefficientSlot n43;
 
 		private IEquationSystemSolutionProxy solution;
 
@@ -31,11 +31,11 @@ namespace NextGenSpice.LargeSignal.Stamping
 		/// <param name="cathode">Index of cathode terminal.</param>
 		public void Register(IEquationSystemAdapter adapter, int anode, int cathode, int refBranch)
 		{
-			n14 = adapter.GetMatrixCoefficientProxy(anode, BranchVariable);
-			n24 = adapter.GetMatrixCoefficientProxy(cathode, BranchVariable);
-			n41 = adapter.GetMatrixCoefficientProxy(BranchVariable, anode);
-			n42 = adapter.GetMatrixCoefficientProxy(BranchVariable, cathode);
-			n43 = adapter.GetMatrixCoefficientProxy(BranchVariable, refBranch);
+			n14 = adapter.GetMatrixCoefficientSlot(anode, BranchVariable);
+			n24 = adapter.GetMatrixCoefficientSlot(cathode, BranchVariable);
+			n41 = adapter.GetMatrixCoefficientSlot(BranchVariable, anode);
+			n42 = adapter.GetMatrixCoefficientSlot(BranchVariable, cathode);
+			n43 = adapter.GetMatrixCoefficientSlot(BranchVariable, refBranch);
 
 			solution = adapter.GetSolutionProxy(BranchVariable);
 		}
@@ -5,10 +5,10 @@ namespace NextGenSpice.LargeSignal.Stamping
 	/// <summary>Helper class for stamping resistor devices onto the equation system.</summary>
 	public class ConductanceStamper
 	{
-		private IEquationSystemCoefficientProxy n11;
-		private IEquationSystemCoefficientProxy n12;
-		private IEquationSystemCoefficientProxy n21;
-		private IEquationSystemCoefficientProxy n22;
+		private CoefficientSlot n11;
+		private CoefficientSlot n12;
+		private CoefficientSlot n21;
+		private CoefficientSlot n22;
 
 		/// <summary>Registeres the equation system coefficient proxies into the stamper.</summary>
 		/// <param name="adapter">The equation system adapter.</param>
@@ -16,10 +16,10 @@ namespace NextGenSpice.LargeSignal.Stamping
 		/// <param name="cathode">Index of cathode terminal.</param>
 		public void Register(IEquationSystemAdapter adapter, int anode, int cathode)
 		{
-			n11 = adapter.GetMatrixCoefficientProxy(anode, anode);
-			n12 = adapter.GetMatrixCoefficientProxy(anode, cathode);
-			n21 = adapter.GetMatrixCoefficientProxy(cathode, anode);
-			n22 = adapter.GetMatrixCoefficientProxy(cathode, cathode);
+			n11 = adapter.GetMatrixCoefficientSlot(anode, anode);
+			n12 = adapter.GetMatrixCoefficientSlot(anode, cathode);
+			n21 = adapter.GetMatrixCoefficientSlot(cathode, anode);
+			n22 = adapter.GetMatrixCoefficientSlot(cathode, cathode);
 		}
 
 		/// <summary>Stamps the device characteristics onto the equation system through the registered proxies.</summary>
@@ -5,8 +5,8 @@ namespace NextGenSpice.LargeSignal.Stamping
 	/// <summary>Helper class for stamping current source devices onto the equation system.</summary>
 	public class CurrentStamper
 	{
-		private IEquationSystemCoefficientProxy anode;
-		private IEquationSystemCoefficientProxy cathode;
+		private CoefficientSlot anode;
+		private CoefficientSlot cathode;
 
 		/// <summary>Registeres the equation system coefficient proxies into the stamper.</summary>
 		/// <param name="adapter">The equation system adapter.</param>
@@ -14,8 +14,8 @@ namespace NextGenSpice.LargeSignal.Stamping
 		/// <param name="cathode">Index of cathode terminal.</param>
 		public void Register(IEquationSystemAdapter adapter, int anode, int cathode)
 		{
-			this.anode = adapter.GetRightHandSideCoefficientProxy(anode);
-			this.cathode = adapter.GetRightHandSideCoefficientProxy(cathode);
+			this.anode = adapter.GetRightHandSideCoefficientSlot(anode);
+			this.cathode = adapter.GetRightHandSideCoefficientSlot(cathode);
 		}
 
 		/// <summary>Stamps the device characteristics onto the equation system through the registered proxies.</summary>
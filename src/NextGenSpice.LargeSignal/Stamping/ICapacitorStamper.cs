@@ -0,0 +1,43 @@
+using NextGenSpice.Numerics.Equations;
+
+namespace NextGenSpice.LargeSignal.Stamping
+{
+	/// <summary>
+	///   Common interface of the helpers stamping the companion models of capacitors, i.e. the equivalent conductance
+	///   and current source given by the integration method.
+	/// </summary>
+	public interface ICapacitorStamper
+	{
+		/// <summary>Registers additional variables needed by the stamper, if any.</summary>
+		/// <param name="adapter">The equation system adapter.</param>
+		void RegisterVariable(IEquationSystemAdapter adapter);
+
+		/// <summary>Registeres the equation system coefficient proxies into the stamper.</summary>
+		/// <param name="adapter">The equation system adapter.</param>
+		/// <param name="anode">Index of anode terminal.</param>
+		/// <param name="cathode">Index of cathode terminal.</param>
+		void Register(IEquationSystemAdapter adapter, int anode, int cathode);
+
+		/// <summary>Stamps the device characteristics onto the equation system through the registered proxies.</summary>
+		/// <param name="ieq">Equivalent current given by the integration method.</param>
+		/// <param name="geq">Equivalent conductance given by the integration method.</param>
+		void Stamp(double ieq, double geq);
+
+		/// <summary>Gets the current through the capacitor in the last solution of the equation system.</summary>
+		/// <returns></returns>
+		double GetCurrent();
+	}
+
+	/// <summary>Helper class for creating the capacitor stampers requested by the simulation parameters.</summary>
+	public static class CapacitorStamperFactory
+	{
+		/// <summary>Creates the capacitor stamper for the simulation with given parameters.</summary>
+		/// <param name="parameters">Parameters of the simulation.</param>
+		/// <returns></returns>
+		public static ICapacitorStamper Create(SimulationParameters parameters)
+		{
+			if (parameters.UseCapacitorBranchCurrents) return new CapacitorStamperWithCurrent();
+			return new CapacitorStamper();
+		}
+	}
+}
@@ -8,11 +8,11 @@ namespace NextGenSpice.LargeSignal.Stamping
 		private readonly CurrentStamper currentStamper;
 		private readonly VoltageStamper voltage;
 
-		private IEquationSystemCoefficientProxy n13;
-		private IEquationSystemCoefficientProxy n23;
-		private IEquationSystemCoefficientProxy n33;
+		private CoefficientSlot n13;
+		private CoefficientSlot n23;
+		private CoefficientSlot n33;
 
-		private IEquationSystemCoefficientProxy r3;
+		private CoefficientSlot r3;
 
 
 		public InductorStamper()
@@ -42,11 +42,11 @@ namespace NextGenSpice.LargeSignal.Stamping
 		{
 			voltage.Register(adapter, anode, cathode);
 			currentStamper.Register(adapter, anode, cathode);
-			n13 = adapter.GetMatrixCoefficientProxy(anode, BranchVariable);
-			n23 = adapter.GetMatrixCoefficientProxy(cathode, BranchVariable);
-			n33 = adapter.GetMatrixCoefficientProxy(BranchVariable, BranchVariable);
+			n13 = adapter.GetMatrixCoefficientSlot(anode, BranchVariable);
+			n23 = adapter.GetMatrixCoefficientSlot(cathode, BranchVariable);
+			n33 = adapter.GetMatrixCoefficientSlot(BranchVariable, BranchVariable);
 
-			r3 = adapter.GetRightHandSideCoefficientProxy(BranchVariable);
+			r3 = adapter.GetRightHandSideCoefficientSlot(BranchVariable);
 		}
 
 		/// <summary>Stamps the device characteristics onto the equation system through the registered proxies.</summary>
@@ -5,10 +5,10 @@ namespace NextGenSpice.LargeSignal.Stamping
 	/// <summary>Helper class for stamping voltage controlled current source devices onto the equation system.</summary>
 	public class VccsStamper
 	{
-		private IEquationSystemCoefficientProxy nara;
-		private IEquationSystemCoefficientProxy narc;
-		private IEquationSystemCoefficientProxy ncra;
-		private IEquationSystemCoefficientProxy ncrc;
+		private CoefficientSlot nara;
+		private CoefficientSlot narc;
+		private CoefficientSlot ncra;
+		private CoefficientSlot ncrc;
 
 		/// <summary>Registeres the equation system coefficient proxies into the stamper.</summary>
 		/// <param name="adapter">The equation system adapter.</param>
@@ -18,10 +18,10 @@ namespace NextGenSpice.LargeSignal.Stamping
 		/// <param name="rcathode">Index of reference cathode terminal.</param>
 		public void Register(IEquationSystemAdapter adapter, int anode, int cathode, int ranode, int rcathode)
 		{
-			nara = adapter.GetMatrixCoefficientProxy(anode, ranode);
-			ncra = adapter.GetMatrixCoefficientProxy(cathode, ranode);
-			narc = adapter.GetMatrixCoefficientProxy(anode, rcathode);
-			ncrc = adapter.GetMatrixCoefficientProxy(cathode, rcathode);
+			nara = adapter.GetMatrixCoefficientSlot(anode, ranode);
+			ncra = adapter.GetMatrixCoefficientSlot(cathode, ranode);
+			narc = adapter.GetMatrixCoefficientSlot(anode, rcathode);
+			ncrc = adapter.GetMatrixCoefficientSlot(cathode, rcathode);
 		}
 
 		/// <summary>Stamps the device characteristics onto the equation system through the registered proxies.</summary>
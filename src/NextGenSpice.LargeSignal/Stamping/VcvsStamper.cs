@@ -7,12 +7,12 @@ namespace NextGenSpice.LargeSignal.Stamping
 	{
 		private IEquationSystemSolutionProxy cur;
 
-		private IEquationSystemCoefficientProxy nab;
-		private IEquationSystemCoefficientProxy nba;
-		private IEquationSystemCoefficientProxy nbc;
-		private IEquationSystemCoefficientProxy nbra;
-		private IEquationSystemCoefficientProxy nbrc;
-		private IEquationSystemCoefficientProxy ncb;
+		private CoefficientSlot nab;
+		private CoefficientSlot nba;
+		private CoefficientSlot nbc;
+		private CoefficientSlot nbra;
+		private CoefficientSlot nbrc;
+		private CoefficientSlot ncb;
 
 		public int BranchVariable { get; private set; }
 
@@ -33,12 +33,12 @@ namespace NextGenSpice.LargeSignal.Stamping
 		/// <param name="rcathode">Index of reference cathode terminal.</param>
 		public void Register(IEquationSystemAdapter adapter, int anode, int cathode, int ranode, int rcathode)
 		{
-			nab = adapter.GetMatrixCoefficientProxy(anode, BranchVariable);
-			ncb = adapter.GetMatrixCoefficientProxy(cathode, BranchVariable);
-			nba = adapter.GetMatrixCoefficientProxy(BranchVariable, anode);
-			nbc = adapter.GetMatrixCoefficientProxy(BranchVariable, cathode);
-			nbra = adapter.GetMatrixCoefficientProxy(BranchVariable, ranode);
-			nbrc = adapter.GetMatrixCoefficientProxy(BranchVariable, rcathode);
+			nab = adapter.GetMatrixCoefficientSlot(anode, BranchVariable);
+			ncb = adapter.GetMatrixCoefficientSlot(cathode, BranchVariable);
+			nba = adapter.GetMatrixCoefficientSlot(BranchVariable, anode);
+			nbc = adapter.GetMatrixCoefficientSlot(BranchVariable, cathode);
+			nbra = adapter.GetMatrixCoefficientSlot(BranchVariable, ranode);
+			nbrc = adapter.GetMatrixCoefficientSlot(BranchVariable, rcathode);
 
 			cur = adapter.GetSolutionProxy(BranchVariable);
 		}
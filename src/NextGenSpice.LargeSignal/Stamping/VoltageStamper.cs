@@ -5,11 +5,11 @@ namespace NextGenSpice.LargeSignal.Stamping
 	/// <summary>Helper class for stamping voltage source devices onto the equation system.</summary>
 	public class VoltageStamper
 	{
-		private IEquationSystemCoefficientProxy br;
-		private IEquationSystemCoefficientProxy n13;
-		private IEquationSystemCoefficientProxy n23;
-		private IEquationSystemCoefficientProxy n31;
-		private IEquationSystemCoefficientProxy n32;
+		private CoefficientSlot br;
+		private CoefficientSlot n13;
+		private CoefficientSlot n23;
+		private CoefficientSlot n31;
+		private CoefficientSlot n32;
 
 		private IEquationSystemSolutionProxy solution;
 
@@ -31,12 +31,12 @@ namespace NextGenSpice.LargeSignal.Stamping
 		/// <param name="cathode">Index of cathode terminal.</param>
 		public void Register(IEquationSystemAdapter adapter, int anode, int cathode)
 		{
-			n13 = adapter.GetMatrixCoefficientProxy(anode, BranchVariable);
-			n23 = adapter.GetMatrixCoefficientProxy(cathode, BranchVariable);
-			n31 = adapter.GetMatrixCoefficientProxy(BranchVariable, anode);
-			n32 = adapter.GetMatrixCoefficientProxy(BranchVariable, cathode);
+			n13 = adapter.GetMatrixCoefficientSlot(anode, BranchVariable);
+			n23 = adapter.GetMatrixCoefficientSlot(cathode, BranchVariable);
+			n31 = adapter.GetMatrixCoefficientSlot(BranchVariable, anode);
+			n32 = adapter.GetMatrixCoefficientSlot(BranchVariable, cathode);
 
-			br = adapter.GetRightHandSideCoefficientProxy(BranchVariable);
+			br = adapter.GetRightHandSideCoefficientSlot(BranchVariable);
 
 			solution = adapter.GetSolutionProxy(BranchVariable);
 		}
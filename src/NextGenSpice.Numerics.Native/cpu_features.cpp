@@ -0,0 +1,39 @@
+#include "cpu_features.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+namespace
+{
+	bool detect_avx2_fma()
+	{
+#ifdef _MSC_VER
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7) return false;
+
+		__cpuid(info, 1);
+		const auto fma = (info[2] & (1 << 12)) != 0;
+		const auto osxsave = (info[2] & (1 << 27)) != 0;
+		const auto avx = (info[2] & (1 << 28)) != 0;
+		if (!fma || !osxsave || !avx) return false;
+
+		// the operating system must save the ymm registers on context switch
+		if ((_xgetbv(0) & 0x6) != 0x6) return false;
+
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+#else
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+	}
+}
+
+bool cpu_supports_avx2_fma()
+{
+	static const auto supported = detect_avx2_fma();
+	return supported;
+}
@@ -0,0 +1,8 @@
+#ifndef CPU_FEATURES_H
+#define CPU_FEATURES_H
+
+// Returns true if the processor and the operating system support AVX2 and FMA3 instructions. The result is
+// detected once and cached.
+bool cpu_supports_avx2_fma();
+
+#endif // CPU_FEATURES_H
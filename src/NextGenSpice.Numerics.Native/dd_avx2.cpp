@@ -0,0 +1,172 @@
+#include "dd_avx2.h"
+
+#include <immintrin.h>
+
+// This file is compiled with AVX2 code generation. It must not instantiate any templates or inline functions from
+// headers (e.g. the dd_real operators), because the linker could pick their AVX2 versions for the rest of the
+// library. The algorithms below therefore mirror dd_inline.h instead of calling it.
+//
+// The error-free transformations rely on the separate multiplications and additions not being contracted into FMA
+// instructions, the only FMAs are the explicit ones in two_prod.
+
+namespace
+{
+	// four double-double numbers, the high and low parts in separate registers
+	struct dd4
+	{
+		__m256d hi;
+		__m256d lo;
+	};
+
+	// Loads four consecutive (hi, lo) pairs. The numbers end up in the lanes in order 0, 2, 1, 3, which does not
+	// matter for elementwise operations as long as store reverses it.
+	dd4 load(const double* p)
+	{
+		const auto a = _mm256_loadu_pd(p);
+		const auto b = _mm256_loadu_pd(p + 4);
+		return {_mm256_unpacklo_pd(a, b), _mm256_unpackhi_pd(a, b)};
+	}
+
+	void store(double* p, const dd4& v)
+	{
+		_mm256_storeu_pd(p, _mm256_unpacklo_pd(v.hi, v.lo));
+		_mm256_storeu_pd(p + 4, _mm256_unpackhi_pd(v.hi, v.lo));
+	}
+
+	dd4 broadcast(const double* p)
+	{
+		return {_mm256_set1_pd(p[0]), _mm256_set1_pd(p[1])};
+	}
+
+	// s + e = a + b exactly
+	__m256d two_sum(__m256d a, __m256d b, __m256d& e)
+	{
+		const auto s = _mm256_add_pd(a, b);
+		const auto bb = _mm256_sub_pd(s, a);
+		e = _mm256_add_pd(_mm256_sub_pd(a, _mm256_sub_pd(s, bb)), _mm256_sub_pd(b, bb));
+		return s;
+	}
+
+	// s + e = a + b exactly, requires |a| >= |b|
+	__m256d quick_two_sum(__m256d a, __m256d b, __m256d& e)
+	{
+		const auto s = _mm256_add_pd(a, b);
+		e = _mm256_sub_pd(b, _mm256_sub_pd(s, a));
+		return s;
+	}
+
+	// p + e = a * b exactly
+	__m256d two_prod(__m256d a, __m256d b, __m256d& e)
+	{
+		const auto p = _mm256_mul_pd(a, b);
+		e = _mm256_fmsub_pd(a, b, p);
+		return p;
+	}
+
+	// dd_real::operator+= without QD_IEEE_ADD
+	dd4 add(const dd4& a, const dd4& b)
+	{
+		__m256d e;
+		const auto s = two_sum(a.hi, b.hi, e);
+		e = _mm256_add_pd(e, a.lo);
+		e = _mm256_add_pd(e, b.lo);
+		dd4 r;
+		r.hi = quick_two_sum(s, e, r.lo);
+		return r;
+	}
+
+	// operator*(const dd_real&, const dd_real&)
+	dd4 mul(const dd4& a, const dd4& b)
+	{
+		__m256d p2;
+		const auto p1 = two_prod(a.hi, b.hi, p2);
+		p2 = _mm256_add_pd(p2, _mm256_add_pd(_mm256_mul_pd(a.hi, b.lo), _mm256_mul_pd(a.lo, b.hi)));
+		dd4 r;
+		r.hi = quick_two_sum(p1, p2, r.lo);
+		return r;
+	}
+
+	// dd_real::operator*=, differs from mul in the order of the additions
+	dd4 mul_assign(const dd4& self, const dd4& a)
+	{
+		__m256d p2;
+		const auto p1 = two_prod(self.hi, a.hi, p2);
+		p2 = _mm256_add_pd(p2, _mm256_mul_pd(a.lo, self.hi));
+		p2 = _mm256_add_pd(p2, _mm256_mul_pd(a.hi, self.lo));
+		dd4 r;
+		r.hi = quick_two_sum(p1, p2, r.lo);
+		return r;
+	}
+
+	// Copies the remaining count < 4 numbers to a buffer padded by zeros so that the tail can be processed by the
+	// same vector code.
+	struct tail
+	{
+		double data[8];
+
+		tail(const double* p, int count)
+		{
+			for (auto i = 0; i < 8; ++i) data[i] = i < 2 * count ? p[i] : 0;
+		}
+
+		void copy_to(double* p, int count) const
+		{
+			for (auto i = 0; i < 2 * count; ++i) p[i] = data[i];
+		}
+	};
+}
+
+void dd_add_avx2(double* self, const double* val, int count)
+{
+	auto i = 0;
+	for (; i + 4 <= count; i += 4)
+		store(self + 2 * i, add(load(self + 2 * i), load(val + 2 * i)));
+
+	if (i == count) return;
+	tail s(self + 2 * i, count - i);
+	const tail v(val + 2 * i, count - i);
+	store(s.data, add(load(s.data), load(v.data)));
+	s.copy_to(self + 2 * i, count - i);
+}
+
+void dd_mul_avx2(double* self, const double* val, int count)
+{
+	auto i = 0;
+	for (; i + 4 <= count; i += 4)
+		store(self + 2 * i, mul_assign(load(self + 2 * i), load(val + 2 * i)));
+
+	if (i == count) return;
+	tail s(self + 2 * i, count - i);
+	const tail v(val + 2 * i, count - i);
+	store(s.data, mul_assign(load(s.data), load(v.data)));
+	s.copy_to(self + 2 * i, count - i);
+}
+
+void dd_fma_avx2(double* self, const double* x, const double* y, int count)
+{
+	auto i = 0;
+	for (; i + 4 <= count; i += 4)
+		store(self + 2 * i, add(load(self + 2 * i), mul(load(x + 2 * i), load(y + 2 * i))));
+
+	if (i == count) return;
+	tail s(self + 2 * i, count - i);
+	const tail tx(x + 2 * i, count - i);
+	const tail ty(y + 2 * i, count - i);
+	store(s.data, add(load(s.data), mul(load(tx.data), load(ty.data))));
+	s.copy_to(self + 2 * i, count - i);
+}
+
+void dd_axpy_avx2(const double* a, const double* x, double* y, int count)
+{
+	const auto va = broadcast(a);
+
+	auto i = 0;
+	for (; i + 4 <= count; i += 4)
+		store(y + 2 * i, add(load(y + 2 * i), mul(va, load(x + 2 * i))));
+
+	if (i == count) return;
+	tail s(y + 2 * i, count - i);
+	const tail tx(x + 2 * i, count - i);
+	store(s.data, add(load(s.data), mul(va, load(tx.data))));
+	s.copy_to(y + 2 * i, count - i);
+}
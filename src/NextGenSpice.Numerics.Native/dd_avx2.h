@@ -0,0 +1,21 @@
+#ifndef DD_AVX2_H
+#define DD_AVX2_H
+
+// Kernels over arrays of double-double numbers stored as (hi, lo) pairs, which is the memory layout of dd_real.
+// Four numbers are processed in one AVX2 register and the exact products are computed with FMA. The operations
+// are evaluated in the same order as the inline dd_real operators, so the results are bitwise equal to the scalar
+// code. They may be called only if cpu_supports_avx2_fma returns true.
+
+// self[i] += val[i]
+void dd_add_avx2(double* self, const double* val, int count);
+
+// self[i] *= val[i]
+void dd_mul_avx2(double* self, const double* val, int count);
+
+// self[i] += x[i] * y[i]
+void dd_fma_avx2(double* self, const double* x, const double* y, int count);
+
+// y[i] += a * x[i], this is also the row update of Gaussian elimination
+void dd_axpy_avx2(const double* a, const double* x, double* y, int count);
+
+#endif // DD_AVX2_H
@@ -7,6 +7,8 @@
 
 #include <qd/dd_real.h>
 
+#include "precision_array.h"
+
 NUMERICSNATIVE_API void dd_add(dd_real& self, dd_real& val)
 {
 	self += val;
@@ -32,6 +34,41 @@ NUMERICSNATIVE_API void dd_sqrt(dd_real& self)
 	self = sqrt(self);
 }
 
+NUMERICSNATIVE_API void dd_array_axpy(dd_real& a, const dd_real* x, dd_real* y, int count)
+{
+	array_axpy(a, x, y, count);
+}
+
+NUMERICSNATIVE_API void dd_array_dot(const dd_real* x, const dd_real* y, int count, dd_real& result)
+{
+	result = array_dot(x, y, count);
+}
+
+NUMERICSNATIVE_API void dd_array_add(dd_real* self, const dd_real* val, int count)
+{
+	array_add(self, val, count);
+}
+
+NUMERICSNATIVE_API void dd_array_mul(dd_real* self, const dd_real* val, int count)
+{
+	array_mul(self, val, count);
+}
+
+NUMERICSNATIVE_API void dd_array_fma(dd_real* self, const dd_real* x, const dd_real* y, int count)
+{
+	array_fma(self, x, y, count);
+}
+
+NUMERICSNATIVE_API void dd_array_div(dd_real* self, const dd_real* val, int count)
+{
+	array_div(self, val, count);
+}
+
+NUMERICSNATIVE_API void dd_array_row_update(dd_real* row, const dd_real* pivot_row, int count, dd_real& factor)
+{
+	factor = array_row_update(row, pivot_row, count);
+}
+
 NUMERICSNATIVE_API BSTR dd_to_string(dd_real& self)
 {
 	std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
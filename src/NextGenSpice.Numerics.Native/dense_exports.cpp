@@ -0,0 +1,161 @@
+#include "numerics.native.h"
+#include "cpu_features.h"
+#include "dense_lu.h"
+#include "iterative_refinement.h"
+#include "parallel_lu.h"
+
+#include <qd/qd_real.h>
+
+NUMERICSNATIVE_API DenseLu<double>* __stdcall dense_create_double(int size)
+{
+	return size > 0 ? new DenseLu<double>(size) : nullptr;
+}
+
+NUMERICSNATIVE_API int __stdcall dense_factor_double(DenseLu<double>* lu, const double* mat)
+{
+	return lu->factor(mat, cpu_supports_avx2_fma()) ? 1 : 0;
+}
+
+NUMERICSNATIVE_API void __stdcall dense_solve_factored_double(DenseLu<double>* lu, double* b)
+{
+	lu->solve(b, cpu_supports_avx2_fma());
+}
+
+NUMERICSNATIVE_API double __stdcall dense_condition_double(const DenseLu<double>* lu)
+{
+	return lu->condition_estimate();
+}
+
+NUMERICSNATIVE_API double __stdcall dense_backward_error_double(const DenseLu<double>* lu, const double* b,
+                                                                const double* x)
+{
+	return lu->backward_error(b, x);
+}
+
+NUMERICSNATIVE_API void __stdcall dense_chord_step_double(DenseLu<double>* lu, const double* mat, const double* b,
+                                                          const double* x, double* result)
+{
+	lu->chord_step(mat, b, x, result, cpu_supports_avx2_fma());
+}
+
+NUMERICSNATIVE_API void __stdcall dense_free_double(DenseLu<double>* lu)
+{
+	delete lu;
+}
+
+NUMERICSNATIVE_API ParallelLu* __stdcall parallel_lu_create(int size, int threads, int serial_cutoff)
+{
+	return size > 0 ? new ParallelLu(size, threads, serial_cutoff) : nullptr;
+}
+
+NUMERICSNATIVE_API int __stdcall parallel_lu_factor(ParallelLu* lu, const double* mat)
+{
+	return lu->factor(mat, cpu_supports_avx2_fma()) ? 1 : 0;
+}
+
+NUMERICSNATIVE_API void __stdcall parallel_lu_solve_factored(ParallelLu* lu, double* b)
+{
+	lu->solve(b, cpu_supports_avx2_fma());
+}
+
+NUMERICSNATIVE_API int __stdcall parallel_lu_thread_count(ParallelLu* lu)
+{
+	return lu->thread_count();
+}
+
+NUMERICSNATIVE_API void __stdcall parallel_lu_free(ParallelLu* lu)
+{
+	delete lu;
+}
+
+NUMERICSNATIVE_API DenseLu<dd_real>* __stdcall dense_create_dd(int size)
+{
+	return size > 0 ? new DenseLu<dd_real>(size) : nullptr;
+}
+
+NUMERICSNATIVE_API int __stdcall dense_factor_dd(DenseLu<dd_real>* lu, const dd_real* mat)
+{
+	return lu->factor(mat, false) ? 1 : 0;
+}
+
+NUMERICSNATIVE_API void __stdcall dense_solve_factored_dd(DenseLu<dd_real>* lu, dd_real* b)
+{
+	lu->solve(b, false);
+}
+
+NUMERICSNATIVE_API void __stdcall dense_chord_step_dd(DenseLu<dd_real>* lu, const dd_real* mat, const dd_real* b,
+                                                      const dd_real* x, dd_real* result)
+{
+	lu->chord_step(mat, b, x, result, false);
+}
+
+NUMERICSNATIVE_API void __stdcall dense_free_dd(DenseLu<dd_real>* lu)
+{
+	delete lu;
+}
+
+NUMERICSNATIVE_API DenseLu<qd_real>* __stdcall dense_create_qd(int size)
+{
+	return size > 0 ? new DenseLu<qd_real>(size) : nullptr;
+}
+
+NUMERICSNATIVE_API int __stdcall dense_factor_qd(DenseLu<qd_real>* lu, const qd_real* mat)
+{
+	return lu->factor(mat, false) ? 1 : 0;
+}
+
+NUMERICSNATIVE_API void __stdcall dense_solve_factored_qd(DenseLu<qd_real>* lu, qd_real* b)
+{
+	lu->solve(b, false);
+}
+
+NUMERICSNATIVE_API void __stdcall dense_chord_step_qd(DenseLu<qd_real>* lu, const qd_real* mat, const qd_real* b,
+                                                      const qd_real* x, qd_real* result)
+{
+	lu->chord_step(mat, b, x, result, false);
+}
+
+NUMERICSNATIVE_API void __stdcall dense_free_qd(DenseLu<qd_real>* lu)
+{
+	delete lu;
+}
+
+NUMERICSNATIVE_API IterativeRefinement<double>* __stdcall refine_create_double(int size)
+{
+	return size > 0 ? new IterativeRefinement<double>(size) : nullptr;
+}
+
+NUMERICSNATIVE_API int __stdcall refine_solve_double(IterativeRefinement<double>* solver, const dd_real* mat,
+                                                  const dd_real* b, dd_real* x, int max_steps, double tolerance,
+                                                  int* steps, double* backward_error)
+{
+	const auto status = solver->solve(mat, b, x, max_steps, tolerance);
+	*steps = solver->last_steps();
+	*backward_error = solver->last_backward_error();
+	return status;
+}
+
+NUMERICSNATIVE_API void __stdcall refine_free_double(IterativeRefinement<double>* solver)
+{
+	delete solver;
+}
+
+NUMERICSNATIVE_API IterativeRefinement<float>* __stdcall refine_create_float(int size)
+{
+	return size > 0 ? new IterativeRefinement<float>(size) : nullptr;
+}
+
+NUMERICSNATIVE_API int __stdcall refine_solve_float(IterativeRefinement<float>* solver, const dd_real* mat,
+                                                  const dd_real* b, dd_real* x, int max_steps, double tolerance,
+                                                  int* steps, double* backward_error)
+{
+	const auto status = solver->solve(mat, b, x, max_steps, tolerance);
+	*steps = solver->last_steps();
+	*backward_error = solver->last_backward_error();
+	return status;
+}
+
+NUMERICSNATIVE_API void __stdcall refine_free_float(IterativeRefinement<float>* solver)
+{
+	delete solver;
+}
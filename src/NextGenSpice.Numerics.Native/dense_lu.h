@@ -0,0 +1,282 @@
+#ifndef DENSE_LU_H
+#define DENSE_LU_H
+
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+
+#include "dense_lu_avx2.h"
+
+// Factorizes the dense matrix stored by rows in place into P * A = L * U using partial pivoting. Row swapped with
+// row i is stored in ipiv[i].
+template <typename Prec>
+void dense_lu_factor(Prec* a, int* ipiv, int n)
+{
+	using std::abs;
+
+	for (auto j = 0; j < n; ++j)
+	{
+		auto p = j;
+		auto maxabs = abs(a[j * n + j]);
+		for (auto i = j + 1; i < n; ++i)
+		{
+			const auto v = abs(a[i * n + j]);
+			if (v > maxabs)
+			{
+				maxabs = v;
+				p = i;
+			}
+		}
+
+		ipiv[j] = p;
+		if (p != j) std::swap_ranges(a + j * n, a + j * n + n, a + p * n);
+
+		const auto pivot = a[j * n + j];
+		if (pivot == Prec()) continue; // the whole column is zero
+
+		for (auto i = j + 1; i < n; ++i)
+		{
+			const auto row = a + i * n;
+			if (row[j] == Prec()) continue;
+
+			row[j] /= pivot;
+			const auto l = row[j];
+			for (auto k = j + 1; k < n; ++k) row[k] -= l * a[j * n + k];
+		}
+	}
+}
+
+// Solves the system using factors computed by dense_lu_factor, b is overwritten by the solution.
+template <typename Prec>
+void dense_lu_solve_factored(const Prec* a, const int* ipiv, Prec* b, int n)
+{
+	for (auto i = 0; i < n; ++i)
+		if (ipiv[i] != i) std::swap(b[i], b[ipiv[i]]);
+
+	for (auto i = 1; i < n; ++i)
+	{
+		auto s = b[i];
+		for (auto k = 0; k < i; ++k) s -= a[i * n + k] * b[k];
+		b[i] = s;
+	}
+
+	for (auto i = n - 1; i >= 0; --i)
+	{
+		auto s = b[i];
+		for (auto k = i + 1; k < n; ++k) s -= a[i * n + k] * b[k];
+		b[i] = s == Prec() ? Prec() : s / a[i * n + i];
+	}
+}
+
+// Solves the transposed system A^T * x = b using factors computed by dense_lu_factor, b is overwritten by the
+// solution. Since A^T = U^T * L^T * P, the permutation is applied last and in reverse order.
+template <typename Prec>
+void dense_lu_solve_transposed(const Prec* a, const int* ipiv, Prec* b, int n)
+{
+	for (auto i = 0; i < n; ++i)
+	{
+		auto s = b[i];
+		for (auto k = 0; k < i; ++k) s -= a[k * n + i] * b[k];
+		b[i] = s == Prec() ? Prec() : s / a[i * n + i];
+	}
+
+	for (auto i = n - 1; i >= 0; --i)
+	{
+		auto s = b[i];
+		for (auto k = i + 1; k < n; ++k) s -= a[k * n + i] * b[k];
+		b[i] = s;
+	}
+
+	for (auto i = n - 1; i >= 0; --i)
+		if (ipiv[i] != i) std::swap(b[i], b[ipiv[i]]);
+}
+
+// Estimates 1-norm of the inverse of the factored matrix using Hager's method with Higham's modifications (as in
+// LAPACK's xLACN2). Needs only a few solves with the factors instead of O(n^3) operations for the explicit inverse.
+inline double dense_lu_inverse_norm1(const double* a, const int* ipiv, int n)
+{
+	auto norm1 = [](const std::vector<double>& v)
+	{
+		auto sum = 0.0;
+		for (auto e : v) sum += std::fabs(e);
+		return sum;
+	};
+
+	std::vector<double> x(n, 1.0 / n);
+	std::vector<double> y(n);
+	auto estimate = 0.0;
+
+	for (auto k = 0; k < 5; ++k)
+	{
+		y = x;
+		dense_lu_solve_factored(a, ipiv, y.data(), n);
+		const auto norm = norm1(y);
+		if (!std::isfinite(norm)) return HUGE_VAL;
+		if (k > 0 && norm <= estimate) break; // no improvement
+		estimate = norm;
+		if (n == 1) return estimate;
+
+		// gradient of the norm at x, the next x is the unit vector in the steepest direction
+		for (auto i = 0; i < n; ++i) y[i] = y[i] >= 0 ? 1.0 : -1.0;
+		dense_lu_solve_transposed(a, ipiv, y.data(), n);
+
+		auto j = 0;
+		auto ztx = 0.0;
+		for (auto i = 0; i < n; ++i)
+		{
+			ztx += y[i] * x[i];
+			if (std::fabs(y[i]) > std::fabs(y[j])) j = i;
+		}
+		if (std::fabs(y[j]) <= ztx) break; // local maximum reached
+
+		std::fill(x.begin(), x.end(), 0.0);
+		x[j] = 1;
+	}
+
+	// Higham's alternative estimate guards against the matrices for which the iteration above is fooled
+	for (auto i = 0; i < n; ++i) x[i] = (i % 2 == 0 ? 1 : -1) * (1 + static_cast<double>(i) / (n - 1));
+	dense_lu_solve_factored(a, ipiv, x.data(), n);
+	return std::max(estimate, 2 * norm1(x) / (3 * n));
+}
+
+// Solves the dense system mat * x = b in place using blocked LU factorization with partial pivoting. The matrix is
+// stored by rows and is overwritten by its factors, b is overwritten by the solution. Requires AVX2 and FMA
+// support, see cpu_supports_avx2_fma.
+inline void dense_lu_solve_avx2(double* mat, double* b, int size)
+{
+	std::vector<int> ipiv(size);
+	dense_lu_factor_avx2(mat, ipiv.data(), size);
+	dense_lu_solve_factored_avx2(mat, ipiv.data(), b, size);
+}
+
+// LU factors of a dense matrix together with a copy of the factored matrix, so that the factorization can be
+// skipped when the same matrix is passed again.
+template <typename Prec>
+class DenseLu
+{
+public:
+	explicit DenseLu(int size) : n{size}, matrix(size * size), factors(size * size), ipiv(size), work(size),
+	                             factored{false}
+	{
+	}
+
+	// Factorizes given matrix unless it is the same as the last factored one. Returns true if the factorization
+	// was recomputed.
+	bool factor(const Prec* mat, bool use_avx2)
+	{
+		const auto count = static_cast<size_t>(n) * n;
+		if (factored && std::memcmp(mat, matrix.data(), count * sizeof(Prec)) == 0) return false;
+
+		std::copy(mat, mat + count, matrix.begin());
+		std::copy(mat, mat + count, factors.begin());
+		do_factor(use_avx2);
+		factored = true;
+		return true;
+	}
+
+	// Solves the system using the last factorization, b is overwritten by the solution.
+	void solve(Prec* b, bool use_avx2) const
+	{
+		do_solve(b, use_avx2);
+	}
+
+	// Performs one step of the modified Newton (chord) iteration for the system mat * x = b using the factors of the
+	// last factored matrix: result = x + LU^-1 * (b - mat * x). The result may be stored over x.
+	void chord_step(const Prec* mat, const Prec* b, const Prec* x, Prec* result, bool use_avx2)
+	{
+		for (auto i = 0; i < n; ++i)
+		{
+			auto r = b[i];
+			const auto row = mat + i * n;
+			for (auto j = 0; j < n; ++j)
+				if (row[j] != Prec()) r -= row[j] * x[j];
+			work[i] = r;
+		}
+
+		do_solve(work.data(), use_avx2);
+		for (auto i = 0; i < n; ++i) result[i] = x[i] + work[i];
+	}
+
+	// Estimates the 1-norm condition number of the last factored matrix, returns infinity for singular matrices.
+	double condition_estimate() const
+	{
+		auto anorm = 0.0;
+		for (auto j = 0; j < n; ++j)
+		{
+			auto sum = 0.0;
+			for (auto i = 0; i < n; ++i) sum += std::fabs(matrix[i * n + j]);
+			anorm = std::max(anorm, sum);
+		}
+
+		for (auto i = 0; i < n; ++i)
+			if (factors[i * n + i] == 0) return HUGE_VAL;
+
+		return anorm * dense_lu_inverse_norm1(factors.data(), ipiv.data(), n);
+	}
+
+	// Returns the normwise backward error |b - A * x|_inf / (|A|_inf * |x|_inf + |b|_inf) of the solution x of the
+	// last factored matrix, NaN if any of the values is not finite.
+	double backward_error(const Prec* b, const Prec* x) const
+	{
+		auto rnorm = 0.0;
+		auto anorm = 0.0;
+		auto xnorm = 0.0;
+		auto bnorm = 0.0;
+		for (auto i = 0; i < n; ++i)
+		{
+			auto r = b[i];
+			auto rowsum = 0.0;
+			for (auto j = 0; j < n; ++j)
+			{
+				const auto v = matrix[i * n + j];
+				if (v == 0) continue;
+				r -= v * x[j];
+				rowsum += std::fabs(v);
+			}
+
+			rnorm = std::max(rnorm, std::fabs(r));
+			anorm = std::max(anorm, rowsum);
+			xnorm = std::max(xnorm, std::fabs(x[i]));
+			bnorm = std::max(bnorm, std::fabs(b[i]));
+		}
+
+		if (!std::isfinite(rnorm) || !std::isfinite(xnorm)) return NAN;
+		const auto denominator = anorm * xnorm + bnorm;
+		return denominator == 0 ? rnorm : rnorm / denominator;
+	}
+
+private:
+	void do_factor(bool)
+	{
+		dense_lu_factor(factors.data(), ipiv.data(), n);
+	}
+
+	void do_solve(Prec* b, bool) const
+	{
+		dense_lu_solve_factored(factors.data(), ipiv.data(), b, n);
+	}
+
+	int n;
+	std::vector<Prec> matrix;
+	std::vector<Prec> factors;
+	std::vector<int> ipiv;
+	std::vector<Prec> work;
+	bool factored;
+};
+
+template <>
+inline void DenseLu<double>::do_factor(bool use_avx2)
+{
+	if (use_avx2) dense_lu_factor_avx2(factors.data(), ipiv.data(), n);
+	else dense_lu_factor(factors.data(), ipiv.data(), n);
+}
+
+template <>
+inline void DenseLu<double>::do_solve(double* b, bool use_avx2) const
+{
+	if (use_avx2) dense_lu_solve_factored_avx2(factors.data(), ipiv.data(), b, n);
+	else dense_lu_solve_factored(factors.data(), ipiv.data(), b, n);
+}
+
+#endif // DENSE_LU_H
@@ -0,0 +1,183 @@
+#include "dense_lu_avx2.h"
+
+#include <immintrin.h>
+#include <cmath>
+
+// This file is compiled with AVX2 code generation. It must not instantiate any templates or inline functions from
+// headers (e.g. std::min, std::vector), because the linker could pick their AVX2 versions for the rest of the library.
+
+namespace
+{
+	int min(int a, int b)
+	{
+		return a < b ? a : b;
+	}
+
+	void swap(double& a, double& b)
+	{
+		const auto tmp = a;
+		a = b;
+		b = tmp;
+	}
+
+	// width of the panel factorized at once
+	const int panel_width = 32;
+	// number of columns of the trailing matrix updated at once, keeps the panel rows in L1 cache
+	const int column_block = 128;
+
+	void swap_rows(double* a, double* b, int count)
+	{
+		auto j = 0;
+		for (; j + 4 <= count; j += 4)
+		{
+			const auto va = _mm256_loadu_pd(a + j);
+			const auto vb = _mm256_loadu_pd(b + j);
+			_mm256_storeu_pd(a + j, vb);
+			_mm256_storeu_pd(b + j, va);
+		}
+		for (; j < count; ++j) swap(a[j], b[j]);
+	}
+
+	// dst -= l * src
+	void row_update(double* dst, const double* src, double l, int count)
+	{
+		const auto vl = _mm256_set1_pd(l);
+		auto j = 0;
+		for (; j + 4 <= count; j += 4)
+			_mm256_storeu_pd(dst + j, _mm256_fnmadd_pd(vl, _mm256_loadu_pd(src + j), _mm256_loadu_pd(dst + j)));
+		for (; j < count; ++j) dst[j] -= l * src[j];
+	}
+
+	// dst -= l0 * s0 + l1 * s1 + l2 * s2 + l3 * s3, rows of the source are stride apart
+	void row_update4(double* dst, const double* src, int stride, const double* l, int count)
+	{
+		const auto l0 = _mm256_set1_pd(l[0]);
+		const auto l1 = _mm256_set1_pd(l[1]);
+		const auto l2 = _mm256_set1_pd(l[2]);
+		const auto l3 = _mm256_set1_pd(l[3]);
+		const auto s0 = src;
+		const auto s1 = src + stride;
+		const auto s2 = src + 2 * stride;
+		const auto s3 = src + 3 * stride;
+
+		auto j = 0;
+		for (; j + 4 <= count; j += 4)
+		{
+			auto d = _mm256_loadu_pd(dst + j);
+			d = _mm256_fnmadd_pd(l0, _mm256_loadu_pd(s0 + j), d);
+			d = _mm256_fnmadd_pd(l1, _mm256_loadu_pd(s1 + j), d);
+			d = _mm256_fnmadd_pd(l2, _mm256_loadu_pd(s2 + j), d);
+			d = _mm256_fnmadd_pd(l3, _mm256_loadu_pd(s3 + j), d);
+			_mm256_storeu_pd(dst + j, d);
+		}
+		for (; j < count; ++j) dst[j] -= l[0] * s0[j] + l[1] * s1[j] + l[2] * s2[j] + l[3] * s3[j];
+	}
+
+	double dot(const double* a, const double* b, int count)
+	{
+		auto acc = _mm256_setzero_pd();
+		auto j = 0;
+		for (; j + 4 <= count; j += 4)
+			acc = _mm256_fmadd_pd(_mm256_loadu_pd(a + j), _mm256_loadu_pd(b + j), acc);
+
+		const auto lo = _mm256_castpd256_pd128(acc);
+		const auto hi = _mm256_extractf128_pd(acc, 1);
+		const auto sum2 = _mm_add_pd(lo, hi);
+		auto sum = _mm_cvtsd_f64(_mm_add_sd(sum2, _mm_unpackhi_pd(sum2, sum2)));
+
+		for (; j < count; ++j) sum += a[j] * b[j];
+		return sum;
+	}
+
+	// Updates rows [first, n) on columns [c0, n) using rows [k0, k1) of the panel: A22 -= L21 * U12.
+	void update_trailing(double* a, int n, int first, int k0, int k1, int c0)
+	{
+		for (auto cb = c0; cb < n; cb += column_block)
+		{
+			const auto count = min(column_block, n - cb);
+			for (auto i = first; i < n; ++i)
+			{
+				const auto row = a + i * n;
+				auto r = k0;
+				for (; r + 4 <= k1; r += 4)
+				{
+					const auto l = row + r;
+					// the matrices of circuit equations are sparse, skip the zero multipliers
+					if (l[0] == 0 && l[1] == 0 && l[2] == 0 && l[3] == 0) continue;
+					row_update4(row + cb, a + r * n + cb, n, l, count);
+				}
+
+				for (; r < k1; ++r)
+					if (row[r] != 0) row_update(row + cb, a + r * n + cb, row[r], count);
+			}
+		}
+	}
+}
+
+void dense_lu_factor_avx2(double* a, int* ipiv, int n)
+{
+	for (auto k0 = 0; k0 < n; k0 += panel_width)
+	{
+		const auto k1 = min(k0 + panel_width, n);
+
+		// factorize the panel, the row swaps are applied to the whole rows
+		for (auto j = k0; j < k1; ++j)
+		{
+			auto p = j;
+			auto maxabs = fabs(a[j * n + j]);
+			for (auto i = j + 1; i < n; ++i)
+			{
+				const auto v = fabs(a[i * n + j]);
+				if (v > maxabs)
+				{
+					maxabs = v;
+					p = i;
+				}
+			}
+
+			ipiv[j] = p;
+			if (p != j) swap_rows(a + j * n, a + p * n, n);
+
+			const auto pivot = a[j * n + j];
+			if (pivot == 0) continue; // the whole column is zero
+
+			for (auto i = j + 1; i < n; ++i)
+			{
+				const auto row = a + i * n;
+				if (row[j] == 0) continue;
+
+				row[j] /= pivot;
+				row_update(row + j + 1, a + j * n + j + 1, row[j], k1 - j - 1);
+			}
+		}
+
+		if (k1 == n) break;
+
+		// U12 = L11^-1 * A12
+		for (auto i = k0 + 1; i < k1; ++i)
+		{
+			const auto row = a + i * n;
+			for (auto r = k0; r < i; ++r)
+				if (row[r] != 0) row_update(row + k1, a + r * n + k1, row[r], n - k1);
+		}
+
+		update_trailing(a, n, k1, k0, k1, k1);
+	}
+}
+
+void dense_lu_solve_factored_avx2(const double* a, const int* ipiv, double* b, int n)
+{
+	for (auto i = 0; i < n; ++i)
+		if (ipiv[i] != i) swap(b[i], b[ipiv[i]]);
+
+	// forward substitution with unit lower triangular L
+	for (auto i = 1; i < n; ++i)
+		b[i] -= dot(a + i * n, b, i);
+
+	// backward substitution with U
+	for (auto i = n - 1; i >= 0; --i)
+	{
+		const auto s = b[i] - dot(a + i * n + i + 1, b + i + 1, n - i - 1);
+		b[i] = s == 0 ? 0 : s / a[i * n + i];
+	}
+}
@@ -0,0 +1,13 @@
+#ifndef DENSE_LU_AVX2_H
+#define DENSE_LU_AVX2_H
+
+// Kernels compiled with AVX2 code generation, they may be called only if cpu_supports_avx2_fma returns true.
+
+// Factorizes the dense matrix stored by rows in place into P * A = L * U using blocked LU with partial pivoting.
+// Row swapped with row i is stored in ipiv[i].
+void dense_lu_factor_avx2(double* mat, int* ipiv, int size);
+
+// Solves the system using factors computed by dense_lu_factor_avx2, b is overwritten by the solution.
+void dense_lu_solve_factored_avx2(const double* mat, const int* ipiv, double* b, int size);
+
+#endif // DENSE_LU_AVX2_H
@@ -0,0 +1,302 @@
+#ifndef DEVICE_EVAL_H
+#define DEVICE_EVAL_H
+
+#include <cmath>
+
+#include "vector_math.h"
+
+// Models of nonlinear devices evaluated for a whole group of instances of the same kind at once. The values of a
+// group are stored as struct of arrays: field f of the i-th instance is at values[f * stride + i]. The field layouts
+// must match the enums in DiodeGroupBuffer.cs and BjtGroupBuffer.cs.
+
+// Fields of the diode group.
+enum diode_field
+{
+	// model parameters
+	diode_is = 0, // saturation current
+	diode_vt,     // thermal voltage multiplied by the emission coefficient
+	diode_gmin,   // minimal conductance
+	diode_bv,     // reverse breakdown voltage
+	diode_tt,     // transit time
+	diode_cj,     // zero-bias junction capacitance
+	diode_vj,     // junction potential
+	diode_m,      // junction grading coefficient
+	diode_fc,     // forward bias depletion capacitance coefficient
+
+	// inputs
+	diode_vd, // voltage across the junction
+
+	// outputs
+	diode_id,  // current
+	diode_geq, // conductance
+	diode_cd,  // junction capacitance
+
+	// intermediate values
+	diode_exp_forward,   // exp(vd / vt)
+	diode_exp_breakdown, // exp(-(bv + vd) / vt)
+
+	diode_field_count
+};
+
+// Fields of the bipolar junction transistor group.
+enum bjt_field
+{
+	// model parameters
+	bjt_is = 0,   // saturation current
+	bjt_ise,      // base-emitter leakage saturation current
+	bjt_isc,      // base-collector leakage saturation current
+	bjt_vtf,      // thermal voltage multiplied by the forward emission coefficient
+	bjt_vtr,      // thermal voltage multiplied by the reverse emission coefficient
+	bjt_vte,      // thermal voltage multiplied by the base-emitter leakage emission coefficient
+	bjt_vtc,      // thermal voltage multiplied by the base-collector leakage emission coefficient
+	bjt_bf,       // forward beta
+	bjt_br,       // reverse beta
+	bjt_vaf,      // forward early voltage
+	bjt_var,      // reverse early voltage
+	bjt_ikf,      // forward current corner
+	bjt_ikr,      // reverse current corner
+	bjt_polarity, // +1 for npn, -1 for pnp
+	bjt_tf,       // forward transit time
+	bjt_tr,       // reverse transit time
+	bjt_fc,       // forward bias depletion coefficient
+	bjt_cje,      // base-emitter zero-bias capacitance
+	bjt_mje,      // base-emitter exponential factor
+	bjt_vje,      // base-emitter potential
+	bjt_cjc,      // base-collector zero-bias capacitance
+	bjt_mjc,      // base-collector exponential factor
+	bjt_vjc,      // base-collector potential
+	bjt_cjs,      // collector-substrate zero-bias capacitance
+	bjt_mjs,      // collector-substrate exponential factor
+	bjt_vjs,      // collector-substrate potential
+
+	// inputs
+	bjt_gmin, // minimal conductance
+	bjt_vbe,  // base-emitter voltage
+	bjt_vbc,  // base-collector voltage
+	bjt_vcs,  // collector-substrate voltage
+
+	// outputs
+	bjt_ic,    // collector current
+	bjt_ib,    // base current
+	bjt_gpi,   // base-emitter conductance
+	bjt_gmu,   // base-collector conductance
+	bjt_gm,    // transconductance
+	bjt_go,    // output conductance
+	bjt_ceqbe, // equivalent current source between base and emitter
+	bjt_ceqbc, // equivalent current source between base and collector
+	bjt_ibe,   // base-emitter junction current
+	bjt_ibc,   // base-collector junction current
+	bjt_gbe,   // base-emitter junction conductance
+	bjt_gbc,   // base-collector junction conductance
+	bjt_cbe,   // base-emitter capacitance
+	bjt_cbc,   // base-collector capacitance
+	bjt_ccs,   // collector-substrate capacitance
+
+	// intermediate values
+	bjt_exp_f, // exp(vbe / vtf)
+	bjt_exp_e, // exp(vbe / vte)
+	bjt_exp_r, // exp(vbc / vtr)
+	bjt_exp_c, // exp(vbc / vtc)
+
+	bjt_field_count
+};
+
+// Euler's number, same value as Math.E
+const double device_e = 2.7182818284590451;
+
+// Replaces the values by their exponentials.
+inline void array_exp(double* x, int count)
+{
+	vector_exp(x, x, count);
+}
+
+// Capacitance of a PN junction, same as DeviceHelpers.JunctionCapacitance.
+inline double junction_capacitance(double v, double cj0, double m, double vj, double tt, double fc)
+{
+	if (v < fc * vj) return tt + cj0 / std::pow(1 - v / vj, m);
+
+	const auto f2 = std::pow(1 - fc, 1 + m);
+	const auto f3 = 1 - fc * (1 + m);
+	return tt + cj0 / f2 * (f3 + m * v / vj);
+}
+
+// Evaluates current, conductance and capacitance of the diodes in range [begin, end). The arguments of all
+// exponentials are computed first so that they are evaluated in a single pass over contiguous memory.
+inline void diode_evaluate(double* values, int stride, int begin, int end)
+{
+	const auto field = [=](diode_field f) { return values + f * stride; };
+	const auto is = field(diode_is);
+	const auto vt = field(diode_vt);
+	const auto gmin = field(diode_gmin);
+	const auto bv = field(diode_bv);
+	const auto tt = field(diode_tt);
+	const auto cj = field(diode_cj);
+	const auto vj = field(diode_vj);
+	const auto m = field(diode_m);
+	const auto fc = field(diode_fc);
+	const auto vd = field(diode_vd);
+	const auto id = field(diode_id);
+	const auto geq = field(diode_geq);
+	const auto cd = field(diode_cd);
+	const auto ef = field(diode_exp_forward);
+	const auto eb = field(diode_exp_breakdown);
+
+	for (auto i = begin; i < end; ++i)
+	{
+		ef[i] = vd[i] / vt[i];
+		eb[i] = -(bv[i] + vd[i]) / vt[i];
+	}
+
+	array_exp(ef + begin, end - begin);
+	array_exp(eb + begin, end - begin);
+
+	for (auto i = begin; i < end; ++i)
+	{
+		const auto v = vd[i];
+		double current, conductance;
+		if (v >= -5 * vt[i])
+		{
+			if (v < -3 * vt[i])
+			{
+				auto a = 3 * vt[i] / (v * device_e);
+				a = a * a * a;
+				current = -is[i] * (1 + a);
+				conductance = +is[i] * 3 * a / v;
+			}
+			else
+			{
+				current = is[i] * (ef[i] - 1);
+				conductance = is[i] * ef[i] / vt[i];
+			}
+
+			current += v * gmin[i];
+			conductance += gmin[i];
+		}
+		else if (v > -bv[i])
+		{
+			current = -is[i];
+			conductance = gmin[i];
+		}
+		else
+		{
+			current = -is[i] * (eb[i] - 1 + bv[i] / vt[i]);
+			conductance = is[i] * eb[i] / vt[i];
+		}
+
+		auto c = -tt[i] * conductance;
+		if (v < fc[i] * vj[i])
+			c += cj[i] / std::pow(1 - v / vj[i], m[i]);
+		else
+			c += cj[i] / std::pow(1 - fc[i], 1 + m[i]) * (1 - fc[i] * (1 + m[i]) + m[i] * v / vj[i]);
+
+		id[i] = current;
+		geq[i] = conductance;
+		cd[i] = c;
+	}
+}
+
+// Current and conductance of a BJT junction, same as DeviceHelpers.PnBJT with precomputed exponential.
+inline void bjt_junction(double is, double v, double vt, double e, double gmin, double& current, double& conductance)
+{
+	if (v > -5 * vt)
+	{
+		current = is * (e - 1) + gmin * v;
+		conductance = is / vt * e + gmin;
+	}
+	else
+	{
+		conductance = -is / v + gmin;
+		current = conductance * v;
+	}
+}
+
+// Evaluates the Gummel-Poon model of the transistors in range [begin, end), the junction capacitances are evaluated
+// only if capacitances is true.
+inline void bjt_evaluate(double* values, int stride, int begin, int end, bool capacitances)
+{
+	const auto field = [=](bjt_field f) { return values + f * stride; };
+	const auto vbe = field(bjt_vbe);
+	const auto vbc = field(bjt_vbc);
+	const auto ef = field(bjt_exp_f);
+	const auto ee = field(bjt_exp_e);
+	const auto er = field(bjt_exp_r);
+	const auto ec = field(bjt_exp_c);
+
+	for (auto i = begin; i < end; ++i)
+	{
+		ef[i] = vbe[i] / field(bjt_vtf)[i];
+		ee[i] = vbe[i] / field(bjt_vte)[i];
+		er[i] = vbc[i] / field(bjt_vtr)[i];
+		ec[i] = vbc[i] / field(bjt_vtc)[i];
+	}
+
+	array_exp(ef + begin, end - begin);
+	array_exp(ee + begin, end - begin);
+	array_exp(er + begin, end - begin);
+	array_exp(ec + begin, end - begin);
+
+	for (auto i = begin; i < end; ++i)
+	{
+		const auto get = [=](bjt_field f) { return values[f * stride + i]; };
+		const auto set = [=](bjt_field f, double value) { values[f * stride + i] = value; };
+
+		const auto be = vbe[i];
+		const auto bc = vbc[i];
+		const auto gmin = get(bjt_gmin);
+
+		// calculate junction currents
+		double ibe, gbe, iben, gben, ibc, gbc, ibcn, gbcn;
+		bjt_junction(get(bjt_is), be, get(bjt_vtf), ef[i], gmin, ibe, gbe);
+		bjt_junction(get(bjt_ise), be, get(bjt_vte), ee[i], 0, iben, gben);
+		bjt_junction(get(bjt_is), bc, get(bjt_vtr), er[i], gmin, ibc, gbc);
+		bjt_junction(get(bjt_isc), bc, get(bjt_vtc), ec[i], 0, ibcn, gbcn);
+
+		// base charge calculation
+		const auto vaf = get(bjt_vaf);
+		const auto var = get(bjt_var);
+		const auto ikf = get(bjt_ikf);
+		const auto ikr = get(bjt_ikr);
+
+		const auto q1 = 1 / (1 - bc / vaf - be / var);
+		const auto q2 = ibe / ikf + ibc / ikr;
+
+		const auto sqrt = std::sqrt(1 + 4 * q2);
+		const auto qb = q1 / 2 * (1 + sqrt);
+
+		const auto dqbdube = q1 * (qb / var + gbe / (ikf * sqrt));
+		const auto dqbdubc = q1 * (qb / vaf + gbc / (ikr * sqrt));
+
+		const auto br = get(bjt_br);
+		const auto ic = (ibe - ibc) / qb - ibc / br - ibcn;
+		const auto ib = ibe / get(bjt_bf) + iben + ibc / br + ibcn;
+		const auto gpi = gbe / get(bjt_bf) + gben;
+		const auto gmu = gbc / br + gbcn;
+		const auto go = (gbc + (ibe - ibc) * dqbdubc / qb) / qb;
+		const auto gm = (gbe - (ibe - ibc) * dqbdube / qb) / qb - go;
+
+		// terminal currents
+		const auto polarity = get(bjt_polarity);
+		set(bjt_ceqbe, polarity * (ic + ib - be * (gm + go + gpi) + bc * go));
+		set(bjt_ceqbc, polarity * (-ic + be * (gm + go) - bc * (gmu + go)));
+
+		set(bjt_ic, ic);
+		set(bjt_ib, ib);
+		set(bjt_gpi, gpi);
+		set(bjt_gmu, gmu);
+		set(bjt_gm, gm);
+		set(bjt_go, go);
+		set(bjt_ibe, ibe);
+		set(bjt_ibc, ibc);
+		set(bjt_gbe, gbe);
+		set(bjt_gbc, gbc);
+
+		if (!capacitances) continue;
+
+		const auto fc = get(bjt_fc);
+		set(bjt_cbe, junction_capacitance(be, get(bjt_cje), get(bjt_mje), get(bjt_vje), gbe * get(bjt_tf), fc));
+		set(bjt_cbc, junction_capacitance(bc, get(bjt_cjc), get(bjt_mjc), get(bjt_vjc), gbc * get(bjt_tr), fc));
+		set(bjt_ccs, junction_capacitance(get(bjt_vcs), get(bjt_cjs), get(bjt_mjs), get(bjt_vjs), 0, fc));
+	}
+}
+
+#endif // DEVICE_EVAL_H
@@ -0,0 +1,13 @@
+#include "numerics.native.h"
+
+#include "device_eval.h"
+
+NUMERICSNATIVE_API void __stdcall diode_group_evaluate(double* values, int stride, int count)
+{
+	diode_evaluate(values, stride, 0, count);
+}
+
+NUMERICSNATIVE_API void __stdcall bjt_group_evaluate(double* values, int stride, int count, int capacitances)
+{
+	bjt_evaluate(values, stride, 0, count, capacitances != 0);
+}
@@ -0,0 +1,134 @@
+#ifndef ITERATIVE_REFINEMENT_H
+#define ITERATIVE_REFINEMENT_H
+
+#include "cpu_features.h"
+#include "dense_lu.h"
+
+#include <qd/dd_real.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Result codes of the iterative refinement.
+enum refinement_status
+{
+	refinement_converged = 0, // the backward error reached the target
+	refinement_stagnated = 1, // the backward error stopped decreasing above the target, solution is the best found
+	refinement_singular = 2   // the factorization produced non-finite values
+};
+
+// Solves dense dd_real systems using LU factorization in lower precision Factor (double or float) and mixed precision
+// iterative refinement: the residual r = b - A * x is computed in dd_real, the correction is solved with the low
+// precision factors and accumulated to the dd_real solution. Each step reduces the error by a factor of about
+// cond(A) * eps(Factor), so near dd_real accuracy is reached in a few steps unless the matrix is too ill-conditioned.
+template <typename Factor>
+class IterativeRefinement
+{
+public:
+	explicit IterativeRefinement(int size) : n{size}, lu(size), low(size * size), correction(size), residual(size)
+	{
+	}
+
+	// Solves a * x = b, the matrix is stored by rows. The factorization is reused if the matrix rounded to Factor
+	// precision did not change. Stops when the normwise backward error |b - A x| / (|A| |x| + |b|) drops below
+	// tolerance or after max_steps refinement steps.
+	refinement_status solve(const dd_real* a, const dd_real* b, dd_real* x, int max_steps, double tolerance)
+	{
+		const auto count = static_cast<size_t>(n) * n;
+		for (size_t i = 0; i < count; ++i) low[i] = static_cast<Factor>(a[i].x[0]);
+		lu.factor(low.data(), use_avx2());
+
+		auto anorm = 0.0;
+		auto bnorm = 0.0;
+		for (auto i = 0; i < n; ++i)
+		{
+			auto rowsum = 0.0;
+			for (auto j = 0; j < n; ++j) rowsum += std::fabs(a[i * n + j].x[0]);
+			anorm = std::max(anorm, rowsum);
+			bnorm = std::max(bnorm, std::fabs(b[i].x[0]));
+		}
+
+		// initial solution from the low precision factors
+		for (auto i = 0; i < n; ++i) correction[i] = static_cast<Factor>(b[i].x[0]);
+		lu.solve(correction.data(), use_avx2());
+		for (auto i = 0; i < n; ++i) x[i] = dd_real(correction[i]);
+
+		steps = 0;
+		auto previous = HUGE_VAL;
+		while (true)
+		{
+			backward_error = compute_residual(a, b, x, anorm, bnorm);
+			if (!std::isfinite(backward_error)) return refinement_singular;
+			if (backward_error <= tolerance) return refinement_converged;
+			if (steps == max_steps || backward_error > 0.5 * previous) return refinement_stagnated;
+
+			previous = backward_error;
+			++steps;
+
+			for (auto i = 0; i < n; ++i) correction[i] = static_cast<Factor>(residual[i].x[0]);
+			lu.solve(correction.data(), use_avx2());
+			for (auto i = 0; i < n; ++i) x[i] += correction[i];
+		}
+	}
+
+	// Number of refinement steps performed by the last solve.
+	int last_steps() const
+	{
+		return steps;
+	}
+
+	// Normwise backward error of the solution returned by the last solve.
+	double last_backward_error() const
+	{
+		return backward_error;
+	}
+
+private:
+	static bool use_avx2();
+
+	// Computes residual = b - A * x in dd_real and returns the normwise backward error.
+	double compute_residual(const dd_real* a, const dd_real* b, const dd_real* x, double anorm, double bnorm)
+	{
+		auto rnorm = 0.0;
+		auto xnorm = 0.0;
+		for (auto i = 0; i < n; ++i)
+		{
+			auto r = b[i];
+			const auto row = a + i * n;
+			for (auto j = 0; j < n; ++j)
+				if (row[j].x[0] != 0) r -= row[j] * x[j];
+
+			residual[i] = r;
+			if (!std::isfinite(r.x[0]) || !std::isfinite(x[i].x[0])) return NAN;
+
+			rnorm = std::max(rnorm, std::fabs(r.x[0]));
+			xnorm = std::max(xnorm, std::fabs(x[i].x[0]));
+		}
+
+		const auto scale = anorm * xnorm + bnorm;
+		return scale == 0 ? rnorm : rnorm / scale;
+	}
+
+	int n;
+	DenseLu<Factor> lu;
+	std::vector<Factor> low;
+	std::vector<Factor> correction;
+	std::vector<dd_real> residual;
+	int steps = 0;
+	double backward_error = 0;
+};
+
+template <>
+inline bool IterativeRefinement<double>::use_avx2()
+{
+	return cpu_supports_avx2_fma();
+}
+
+template <>
+inline bool IterativeRefinement<float>::use_avx2()
+{
+	return false; // the vectorized kernel exists only for double
+}
+
+#endif // ITERATIVE_REFINEMENT_H
@@ -0,0 +1,254 @@
+#include "math_avx2.h"
+
+#include <cmath>
+#include <immintrin.h>
+
+// This file is compiled with AVX2 code generation, it must not call any inline functions from headers (e.g. std::exp)
+// because the linker could pick their AVX2 versions for the rest of the library.
+//
+// The range reductions rely on the separate multiplications and additions not being contracted into FMA
+// instructions, the only FMAs are the explicit ones.
+
+namespace
+{
+	// ln(2) split so that multiples of ln2_hi by the exponents of double are exact
+	const double ln2_hi = 6.93147180369123816490e-01;
+	const double ln2_lo = 1.90821492927058770002e-10;
+	const double log2e = 1.4426950408889634;
+	const double sqrt2 = 1.4142135623730951;
+
+	// 2^52, adding it to a small nonnegative integer stores the integer in the low bits of the mantissa
+	const double two52 = 4503599627370496.0;
+	const long long two52_bits = 0x4330000000000000LL;
+
+	// 1/k! for k = 0 .. 13, the Taylor series is accurate to 2^-57 on |r| <= ln(2)/2
+	const double exp_coefficients[] = {
+		1.0, 1.0, 1.0 / 2, 1.0 / 6, 1.0 / 24, 1.0 / 120, 1.0 / 720, 1.0 / 5040, 1.0 / 40320, 1.0 / 362880,
+		1.0 / 3628800, 1.0 / 39916800, 1.0 / 479001600, 1.0 / 6227020800
+	};
+
+	// minimax coefficients of (log(1 + f) - 2s) / s in s^2, where s = f / (2 + f), from fdlibm
+	const double log_coefficients[] = {
+		6.666666666666735130e-01, 3.999999999940941908e-01, 2.857142874366239149e-01, 2.222219843214978396e-01,
+		1.818357216161805012e-01, 1.531383769920937332e-01, 1.479819860511658591e-01
+	};
+
+	__m256d is_nan(__m256d x)
+	{
+		return _mm256_cmp_pd(x, x, _CMP_UNORD_Q);
+	}
+
+	__m256d absolute(__m256d x)
+	{
+		return _mm256_andnot_pd(_mm256_set1_pd(-0.0), x);
+	}
+
+	// 2^n for integral n in [-1022, 1023] stored as double
+	__m256d pow2(__m256d n)
+	{
+		const auto biased = _mm256_castpd_si256(_mm256_add_pd(n, _mm256_set1_pd(two52 + 1023)));
+		const auto exponent = _mm256_sub_epi64(biased, _mm256_set1_epi64x(two52_bits));
+		return _mm256_castsi256_pd(_mm256_slli_epi64(exponent, 52));
+	}
+
+	// exp(hi + lo), where |lo| is much smaller than ulp of hi
+	__m256d exp4(__m256d hi, __m256d lo)
+	{
+		// arguments outside the range overflow or underflow in the final scaling, the low part of such arguments need
+		// not be small compared to the reduced argument and is dropped
+		const auto lower = _mm256_set1_pd(-746);
+		const auto upper = _mm256_set1_pd(710);
+		const auto x = _mm256_min_pd(_mm256_max_pd(hi, lower), upper);
+		lo = _mm256_and_pd(lo, _mm256_and_pd(_mm256_cmp_pd(hi, lower, _CMP_GE_OQ), _mm256_cmp_pd(hi, upper, _CMP_LE_OQ)));
+
+		// x = n * ln(2) + r, |r| <= ln(2) / 2
+		const auto n = _mm256_round_pd(_mm256_mul_pd(x, _mm256_set1_pd(log2e)),
+			_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+		auto r = _mm256_fnmadd_pd(n, _mm256_set1_pd(ln2_hi), x);
+		r = _mm256_fnmadd_pd(n, _mm256_set1_pd(ln2_lo), r);
+		r = _mm256_add_pd(r, lo);
+
+		// the terms from r^3 up are evaluated by Estrin's scheme to shorten the dependency chain, their rounding
+		// errors are scaled down by r^3 / 6
+		const auto r2 = _mm256_mul_pd(r, r);
+		const auto r4 = _mm256_mul_pd(r2, r2);
+		const auto r8 = _mm256_mul_pd(r4, r4);
+		const auto c = [](int k) { return _mm256_set1_pd(exp_coefficients[k]); };
+		const auto a0 = _mm256_fmadd_pd(c(4), r, c(3));
+		const auto a1 = _mm256_fmadd_pd(c(6), r, c(5));
+		const auto a2 = _mm256_fmadd_pd(c(8), r, c(7));
+		const auto a3 = _mm256_fmadd_pd(c(10), r, c(9));
+		const auto a4 = _mm256_fmadd_pd(c(12), r, c(11));
+		const auto b0 = _mm256_fmadd_pd(a1, r2, a0);
+		const auto b1 = _mm256_fmadd_pd(a3, r2, a2);
+		const auto b2 = _mm256_fmadd_pd(c(13), r2, a4);
+		auto p = _mm256_fmadd_pd(b2, r8, _mm256_fmadd_pd(b1, r4, b0));
+
+		// the leading terms by Horner's scheme
+		p = _mm256_fmadd_pd(p, r, c(2));
+		p = _mm256_fmadd_pd(p, r, c(1));
+		p = _mm256_fmadd_pd(p, r, c(0));
+
+		// scale by 2^n in two steps so that subnormal results are rounded only once and n = 1024 does not overflow
+		const auto n1 = _mm256_floor_pd(_mm256_mul_pd(n, _mm256_set1_pd(0.5)));
+		const auto n2 = _mm256_sub_pd(n, n1);
+		const auto result = _mm256_mul_pd(_mm256_mul_pd(p, pow2(n1)), pow2(n2));
+
+		return _mm256_blendv_pd(result, hi, is_nan(hi));
+	}
+
+	// log(x) as double-double number hi + lo
+	void log4(__m256d x, __m256d& hi, __m256d& lo)
+	{
+		// scale subnormal numbers to normal range
+		const auto subnormal = _mm256_cmp_pd(x, _mm256_set1_pd(2.2250738585072014e-308), _CMP_LT_OQ);
+		const auto scaled = _mm256_blendv_pd(x, _mm256_mul_pd(x, _mm256_set1_pd(18014398509481984.0)), subnormal);
+		auto k = _mm256_blendv_pd(_mm256_set1_pd(-1023), _mm256_set1_pd(-1023 - 54), subnormal);
+
+		// x = 2^k * m, sqrt(2)/2 < m <= sqrt(2)
+		const auto bits = _mm256_castpd_si256(scaled);
+		const auto exponent = _mm256_or_si256(_mm256_srli_epi64(bits, 52), _mm256_set1_epi64x(two52_bits));
+		k = _mm256_add_pd(k, _mm256_sub_pd(_mm256_castsi256_pd(exponent), _mm256_set1_pd(two52)));
+
+		const auto mantissa = _mm256_and_si256(bits, _mm256_set1_epi64x(0x000fffffffffffffLL));
+		auto m = _mm256_castsi256_pd(_mm256_or_si256(mantissa, _mm256_set1_epi64x(0x3ff0000000000000LL)));
+		const auto big = _mm256_cmp_pd(m, _mm256_set1_pd(sqrt2), _CMP_GT_OQ);
+		m = _mm256_blendv_pd(m, _mm256_mul_pd(m, _mm256_set1_pd(0.5)), big);
+		k = _mm256_add_pd(k, _mm256_and_pd(big, _mm256_set1_pd(1)));
+
+		// log(1 + f) = 2 * atanh(s), s = f / (2 + f), the quotient is computed in double-double precision
+		const auto two = _mm256_set1_pd(2);
+		const auto f = _mm256_sub_pd(m, _mm256_set1_pd(1));
+		const auto u = _mm256_add_pd(two, f);
+		const auto ue = _mm256_sub_pd(f, _mm256_sub_pd(u, two));
+		// s is not correctly rounded, but the residual f - s * u is still exact and corrects it
+		const auto inverse = _mm256_div_pd(_mm256_set1_pd(1), u);
+		const auto s = _mm256_mul_pd(f, inverse);
+		auto residual = _mm256_fnmadd_pd(s, u, f);
+		residual = _mm256_fnmadd_pd(s, ue, residual);
+		const auto sl = _mm256_mul_pd(residual, inverse);
+
+		const auto z = _mm256_mul_pd(s, s);
+		auto t = _mm256_set1_pd(log_coefficients[6]);
+		for (auto i = 5; i >= 0; --i) t = _mm256_fmadd_pd(t, z, _mm256_set1_pd(log_coefficients[i]));
+		t = _mm256_mul_pd(t, z);
+
+		// k * ln2_hi + 2s is the leading part, the rest is summed in double
+		const auto kh = _mm256_mul_pd(k, _mm256_set1_pd(ln2_hi));
+		const auto s2 = _mm256_add_pd(s, s);
+		const auto h = _mm256_add_pd(kh, s2);
+		const auto hb = _mm256_sub_pd(h, kh);
+		const auto e = _mm256_add_pd(_mm256_sub_pd(kh, _mm256_sub_pd(h, hb)), _mm256_sub_pd(s2, hb));
+
+		auto rest = _mm256_fmadd_pd(s, t, _mm256_mul_pd(k, _mm256_set1_pd(ln2_lo)));
+		rest = _mm256_add_pd(rest, _mm256_add_pd(sl, sl));
+		rest = _mm256_add_pd(e, rest);
+
+		hi = _mm256_add_pd(h, rest);
+		lo = _mm256_sub_pd(rest, _mm256_sub_pd(hi, h));
+
+		// special values: log(0) = -inf, log(x < 0) = NaN, log(inf) = inf, log(NaN) = NaN
+		const auto zero = _mm256_cmp_pd(x, _mm256_setzero_pd(), _CMP_EQ_OQ);
+		const auto negative = _mm256_cmp_pd(x, _mm256_setzero_pd(), _CMP_LT_OQ);
+		const auto self = _mm256_or_pd(is_nan(x), _mm256_cmp_pd(x, _mm256_set1_pd(HUGE_VAL), _CMP_EQ_OQ));
+		const auto special = _mm256_or_pd(_mm256_or_pd(zero, negative), self);
+
+		hi = _mm256_blendv_pd(hi, _mm256_set1_pd(-HUGE_VAL), zero);
+		hi = _mm256_blendv_pd(hi, _mm256_set1_pd(NAN), negative);
+		hi = _mm256_blendv_pd(hi, x, self);
+		lo = _mm256_andnot_pd(special, lo);
+	}
+
+	__m256d log4(__m256d x)
+	{
+		__m256d hi, lo;
+		log4(x, hi, lo);
+		return hi;
+	}
+
+	__m256d pow4(__m256d x, __m256d y)
+	{
+		__m256d lh, ll;
+		log4(absolute(x), lh, ll);
+
+		// y * log(x) in double-double precision, the low part is dropped for infinite products
+		const auto ph = _mm256_mul_pd(y, lh);
+		auto pl = _mm256_add_pd(_mm256_fmsub_pd(y, lh, ph), _mm256_mul_pd(y, ll));
+		pl = _mm256_and_pd(pl, _mm256_cmp_pd(absolute(ph), _mm256_set1_pd(HUGE_VAL), _CMP_LT_OQ));
+
+		auto result = exp4(ph, pl);
+
+		// pow(x, 0) = pow(1, y) = 1 even for NaN arguments, pow(-1, y) is handled below as pow(1, y)
+		const auto one = _mm256_or_pd(_mm256_cmp_pd(y, _mm256_setzero_pd(), _CMP_EQ_OQ),
+			_mm256_cmp_pd(absolute(x), _mm256_set1_pd(1), _CMP_EQ_OQ));
+		result = _mm256_blendv_pd(result, _mm256_set1_pd(1), one);
+
+		// negative base (including -0 and -inf) is negated for odd integral exponents, finite negative base gives NaN
+		// for non-integral exponents, the exponents of magnitude at least 2^53 are all even
+		const auto round = _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC;
+		const auto integral = _mm256_cmp_pd(y, _mm256_round_pd(y, round), _CMP_EQ_OQ);
+		const auto half = _mm256_mul_pd(y, _mm256_set1_pd(0.5));
+		const auto odd = _mm256_and_pd(integral, _mm256_cmp_pd(half, _mm256_round_pd(half, round), _CMP_NEQ_UQ));
+		result = _mm256_xor_pd(result, _mm256_and_pd(_mm256_and_pd(odd, x), _mm256_set1_pd(-0.0)));
+
+		const auto negative = _mm256_and_pd(_mm256_cmp_pd(x, _mm256_setzero_pd(), _CMP_LT_OQ),
+			_mm256_cmp_pd(x, _mm256_set1_pd(-HUGE_VAL), _CMP_GT_OQ));
+		return _mm256_blendv_pd(result, _mm256_set1_pd(NAN), _mm256_andnot_pd(integral, negative));
+	}
+
+	// Copies the remaining count < 4 numbers to a buffer padded by ones so that the tail can be processed by the
+	// same vector code.
+	struct tail
+	{
+		double data[4];
+
+		tail(const double* p, int count)
+		{
+			for (auto i = 0; i < 4; ++i) data[i] = i < count ? p[i] : 1;
+		}
+
+		void copy_to(double* p, int count) const
+		{
+			for (auto i = 0; i < count; ++i) p[i] = data[i];
+		}
+	};
+}
+
+void exp_avx2(const double* x, double* result, int count)
+{
+	const auto zero = _mm256_setzero_pd();
+
+	auto i = 0;
+	for (; i + 4 <= count; i += 4)
+		_mm256_storeu_pd(result + i, exp4(_mm256_loadu_pd(x + i), zero));
+
+	if (i == count) return;
+	tail t(x + i, count - i);
+	_mm256_storeu_pd(t.data, exp4(_mm256_loadu_pd(t.data), zero));
+	t.copy_to(result + i, count - i);
+}
+
+void log_avx2(const double* x, double* result, int count)
+{
+	auto i = 0;
+	for (; i + 4 <= count; i += 4)
+		_mm256_storeu_pd(result + i, log4(_mm256_loadu_pd(x + i)));
+
+	if (i == count) return;
+	tail t(x + i, count - i);
+	_mm256_storeu_pd(t.data, log4(_mm256_loadu_pd(t.data)));
+	t.copy_to(result + i, count - i);
+}
+
+void pow_avx2(const double* x, const double* y, double* result, int count)
+{
+	auto i = 0;
+	for (; i + 4 <= count; i += 4)
+		_mm256_storeu_pd(result + i, pow4(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+
+	if (i == count) return;
+	tail tx(x + i, count - i);
+	const tail ty(y + i, count - i);
+	_mm256_storeu_pd(tx.data, pow4(_mm256_loadu_pd(tx.data), _mm256_loadu_pd(ty.data)));
+	tx.copy_to(result + i, count - i);
+}
@@ -0,0 +1,26 @@
+#ifndef MATH_AVX2_H
+#define MATH_AVX2_H
+
+// Elementary functions over arrays of doubles, four numbers are evaluated in one AVX2 register. The input and the
+// result arrays may be the same. They may be called only if cpu_supports_avx2_fma returns true.
+//
+// Error bounds, measured against the qd_real functions rounded to double:
+//   exp: below 1 ulp over the whole domain (0.86 ulp measured), subnormal results are rounded only once.
+//   log: below 1 ulp (0.55 ulp measured), the logarithm is computed in double-double precision and rounded once.
+//   pow: at most 2 ulp for |y| <= 64, computed as exp(y * log(x)) with the product in double-double precision. For
+//        larger exponents the error of the logarithm is amplified by up to |y * log(x)| <= 746, the largest error
+//        measured was 50 ulp for |y| around 1000. Larger exponents need a base close to 1 to give a result in range
+//        and the error decreases again. Results out of range are exactly 0 or infinity for any exponent.
+//
+// Special values follow the C library.
+
+// result[i] = exp(x[i])
+void exp_avx2(const double* x, double* result, int count);
+
+// result[i] = log(x[i])
+void log_avx2(const double* x, double* result, int count);
+
+// result[i] = pow(x[i], y[i])
+void pow_avx2(const double* x, const double* y, double* result, int count);
+
+#endif // MATH_AVX2_H
@@ -0,0 +1,18 @@
+#include "numerics.native.h"
+
+#include "vector_math.h"
+
+NUMERICSNATIVE_API void __stdcall math_exp(const double* x, double* result, int count)
+{
+	vector_exp(x, result, count);
+}
+
+NUMERICSNATIVE_API void __stdcall math_log(const double* x, double* result, int count)
+{
+	vector_log(x, result, count);
+}
+
+NUMERICSNATIVE_API void __stdcall math_pow(const double* x, const double* y, double* result, int count)
+{
+	vector_pow(x, y, result, count);
+}
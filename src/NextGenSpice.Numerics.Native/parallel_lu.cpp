@@ -0,0 +1,145 @@
+#include "parallel_lu.h"
+#include "dense_lu.h"
+
+namespace
+{
+	// number of columns in one panel, the block columns are the units of work
+	const int block_width = 32;
+}
+
+ParallelLu::ParallelLu(int size, int threads, int serial_cutoff) : n{size}, serial_cutoff{serial_cutoff},
+                                                                    matrix(size * size), factors(size * size),
+                                                                    ipiv(size), factored{false}, pool{threads}
+{
+}
+
+bool ParallelLu::factor(const double* mat, bool use_avx2)
+{
+	const auto count = static_cast<size_t>(n) * n;
+	if (factored && std::memcmp(mat, matrix.data(), count * sizeof(double)) == 0) return false;
+
+	std::copy(mat, mat + count, matrix.begin());
+	std::copy(mat, mat + count, factors.begin());
+
+	if (n < serial_cutoff)
+	{
+		if (use_avx2) dense_lu_factor_avx2(factors.data(), ipiv.data(), n);
+		else dense_lu_factor(factors.data(), ipiv.data(), n);
+	}
+	else
+		factor_parallel();
+
+	factored = true;
+	return true;
+}
+
+void ParallelLu::solve(double* b, bool use_avx2) const
+{
+	if (use_avx2) dense_lu_solve_factored_avx2(factors.data(), ipiv.data(), b, n);
+	else dense_lu_solve_factored(factors.data(), ipiv.data(), b, n);
+}
+
+void ParallelLu::factor_parallel()
+{
+	const auto blocks = (n + block_width - 1) / block_width;
+
+	// panel[k] factors block column k, update[k][j] applies panel k to block column j > k
+	TaskGraph graph;
+	std::vector<int> panel(blocks);
+	std::vector<std::vector<int>> update(blocks, std::vector<int>(blocks, -1));
+
+	for (auto k = 0; k < blocks; ++k)
+	{
+		panel[k] = graph.add_task([this, k] { factor_panel(k); });
+		if (k > 0) graph.add_dependency(update[k - 1][k], panel[k]);
+
+		for (auto j = k + 1; j < blocks; ++j)
+		{
+			update[k][j] = graph.add_task([this, k, j] { update_block(k, j); });
+			graph.add_dependency(panel[k], update[k][j]);
+			if (k > 0) graph.add_dependency(update[k - 1][j], update[k][j]);
+		}
+	}
+
+	pool.run(graph);
+	swap_left_columns();
+}
+
+void ParallelLu::factor_panel(int k)
+{
+	const auto a = factors.data();
+	const auto c0 = k * block_width;
+	const auto c1 = std::min(c0 + block_width, n);
+
+	for (auto j = c0; j < c1; ++j)
+	{
+		auto p = j;
+		auto maxabs = std::fabs(a[j * n + j]);
+		for (auto i = j + 1; i < n; ++i)
+		{
+			const auto v = std::fabs(a[i * n + j]);
+			if (v > maxabs)
+			{
+				maxabs = v;
+				p = i;
+			}
+		}
+
+		// the rows are swapped only within the panel, other block columns are swapped by their updates
+		ipiv[j] = p;
+		if (p != j) std::swap_ranges(a + j * n + c0, a + j * n + c1, a + p * n + c0);
+
+		const auto pivot = a[j * n + j];
+		if (pivot == 0) continue; // the whole column is zero
+
+		for (auto i = j + 1; i < n; ++i)
+		{
+			const auto row = a + i * n;
+			if (row[j] == 0) continue;
+
+			row[j] /= pivot;
+			const auto l = row[j];
+			for (auto c = j + 1; c < c1; ++c) row[c] -= l * a[j * n + c];
+		}
+	}
+}
+
+void ParallelLu::update_block(int k, int j)
+{
+	const auto a = factors.data();
+	const auto r0 = k * block_width;
+	const auto r1 = std::min(r0 + block_width, n);
+	const auto c0 = j * block_width;
+	const auto c1 = std::min(c0 + block_width, n);
+
+	for (auto r = r0; r < r1; ++r)
+		if (ipiv[r] != r) std::swap_ranges(a + r * n + c0, a + r * n + c1, a + ipiv[r] * n + c0);
+
+	// U12 = L11^-1 * A12, then A22 -= L21 * U12, the subtractions on each entry are performed in the same order as in
+	// the unblocked factorization, but the factors may still differ in the last bits from the serial AVX2 factorization,
+	// which uses fused multiply-add
+	for (auto i = r0 + 1; i < n; ++i)
+	{
+		const auto row = a + i * n;
+		const auto last = std::min(i, r1);
+		for (auto r = r0; r < last; ++r)
+		{
+			const auto l = row[r];
+			if (l == 0) continue;
+
+			const auto src = a + r * n;
+			for (auto c = c0; c < c1; ++c) row[c] -= l * src[c];
+		}
+	}
+}
+
+void ParallelLu::swap_left_columns()
+{
+	// columns of L are swapped by pivoting of the later panels, which could not be done while they were being read
+	const auto a = factors.data();
+	for (auto r = block_width; r < n; ++r)
+	{
+		const auto left = r / block_width * block_width;
+		if (ipiv[r] != r) std::swap_ranges(a + r * n, a + r * n + left, a + ipiv[r] * n);
+	}
+}
@@ -0,0 +1,42 @@
+#ifndef PARALLEL_LU_H
+#define PARALLEL_LU_H
+
+#include <vector>
+
+#include "task_scheduler.h"
+
+// Right-looking blocked LU factorization with partial pivoting whose steps are scheduled as a dependency graph on a
+// work-stealing thread pool. Factorization of a panel (block of columns) waits only for the update of its columns by
+// the previous panel, so that it overlaps with updates of the rest of the matrix. Systems smaller than the serial
+// cutoff are factored on the calling thread without blocking.
+class ParallelLu
+{
+public:
+	// Creates factorization for matrices of given size, 0 threads means number of hardware threads.
+	ParallelLu(int size, int threads, int serial_cutoff);
+
+	// Factorizes given matrix unless it is the same as the last factored one. Returns true if the factorization
+	// was recomputed.
+	bool factor(const double* mat, bool use_avx2);
+
+	// Solves the system using the last factorization, b is overwritten by the solution.
+	void solve(double* b, bool use_avx2) const;
+
+	int thread_count() const { return pool.thread_count(); }
+
+private:
+	void factor_parallel();
+	void factor_panel(int k);
+	void update_block(int k, int j);
+	void swap_left_columns();
+
+	int n;
+	int serial_cutoff;
+	std::vector<double> matrix;
+	std::vector<double> factors;
+	std::vector<int> ipiv;
+	bool factored;
+	WorkStealingPool pool;
+};
+
+#endif // PARALLEL_LU_H
@@ -0,0 +1,102 @@
+#ifndef PRECISION_ARRAY_H
+#define PRECISION_ARRAY_H
+
+#include <qd/dd_real.h>
+
+#include "cpu_features.h"
+#include "dd_avx2.h"
+
+// Operations over contiguous arrays of extended precision numbers. They are exported for dd_real and qd_real so
+// that the managed code calls into the library once per array instead of once per arithmetic operation. The
+// dd_real overloads at the end of the file use the AVX2 kernels when available.
+
+// y += a * x
+template <typename Prec>
+void array_axpy(const Prec& a, const Prec* x, Prec* y, int count)
+{
+	for (auto i = 0; i < count; ++i) y[i] += a * x[i];
+}
+
+template <typename Prec>
+Prec array_dot(const Prec* x, const Prec* y, int count)
+{
+	Prec sum = 0.0;
+	for (auto i = 0; i < count; ++i) sum += x[i] * y[i];
+	return sum;
+}
+
+template <typename Prec>
+void array_add(Prec* self, const Prec* val, int count)
+{
+	for (auto i = 0; i < count; ++i) self[i] += val[i];
+}
+
+template <typename Prec>
+void array_mul(Prec* self, const Prec* val, int count)
+{
+	for (auto i = 0; i < count; ++i) self[i] *= val[i];
+}
+
+// self += x * y
+template <typename Prec>
+void array_fma(Prec* self, const Prec* x, const Prec* y, int count)
+{
+	for (auto i = 0; i < count; ++i) self[i] += x[i] * y[i];
+}
+
+template <typename Prec>
+void array_div(Prec* self, const Prec* val, int count)
+{
+	for (auto i = 0; i < count; ++i) self[i] /= val[i];
+}
+
+// Eliminates the first entry of the row using the pivot row: row += factor * pivot_row, where
+// factor = -row[0] / pivot_row[0]. The first entry is set to exact zero and the factor is returned, so that the
+// caller can apply the same update to the right hand side.
+template <typename Prec>
+Prec array_row_update(Prec* row, const Prec* pivot_row, int count)
+{
+	const Prec factor = -row[0] / pivot_row[0];
+	row[0] = 0.0;
+	array_axpy(factor, pivot_row + 1, row + 1, count - 1);
+	return factor;
+}
+
+// dd_real is laid out as (hi, lo) pair of doubles, which is what the AVX2 kernels expect
+static_assert(sizeof(dd_real) == 2 * sizeof(double), "unexpected dd_real layout");
+
+inline double* dd_data(dd_real* p)
+{
+	return reinterpret_cast<double*>(p);
+}
+
+inline const double* dd_data(const dd_real* p)
+{
+	return reinterpret_cast<const double*>(p);
+}
+
+inline void array_axpy(const dd_real& a, const dd_real* x, dd_real* y, int count)
+{
+	if (cpu_supports_avx2_fma()) dd_axpy_avx2(a.x, dd_data(x), dd_data(y), count);
+	else array_axpy<dd_real>(a, x, y, count);
+}
+
+inline void array_add(dd_real* self, const dd_real* val, int count)
+{
+	if (cpu_supports_avx2_fma()) dd_add_avx2(dd_data(self), dd_data(val), count);
+	else array_add<dd_real>(self, val, count);
+}
+
+inline void array_mul(dd_real* self, const dd_real* val, int count)
+{
+	if (cpu_supports_avx2_fma()) dd_mul_avx2(dd_data(self), dd_data(val), count);
+	else array_mul<dd_real>(self, val, count);
+}
+
+inline void array_fma(dd_real* self, const dd_real* x, const dd_real* y, int count)
+{
+	if (cpu_supports_avx2_fma()) dd_fma_avx2(dd_data(self), dd_data(x), dd_data(y), count);
+	else array_fma<dd_real>(self, x, y, count);
+}
+
+#endif // PRECISION_ARRAY_H
@@ -7,6 +7,8 @@
 
 #include <qd/qd_real.h>
 
+#include "precision_array.h"
+
 NUMERICSNATIVE_API void qd_add(qd_real& self, qd_real& val)
 {
 	self += val;
@@ -32,6 +34,51 @@ NUMERICSNATIVE_API void qd_sqrt(qd_real& self)
 	self = sqrt(self);
 }
 
+NUMERICSNATIVE_API void qd_exp(qd_real& self)
+{
+	self = exp(self);
+}
+
+NUMERICSNATIVE_API void qd_log(qd_real& self)
+{
+	self = log(self);
+}
+
+NUMERICSNATIVE_API void qd_array_axpy(qd_real& a, const qd_real* x, qd_real* y, int count)
+{
+	array_axpy(a, x, y, count);
+}
+
+NUMERICSNATIVE_API void qd_array_dot(const qd_real* x, const qd_real* y, int count, qd_real& result)
+{
+	result = array_dot(x, y, count);
+}
+
+NUMERICSNATIVE_API void qd_array_add(qd_real* self, const qd_real* val, int count)
+{
+	array_add(self, val, count);
+}
+
+NUMERICSNATIVE_API void qd_array_mul(qd_real* self, const qd_real* val, int count)
+{
+	array_mul(self, val, count);
+}
+
+NUMERICSNATIVE_API void qd_array_fma(qd_real* self, const qd_real* x, const qd_real* y, int count)
+{
+	array_fma(self, x, y, count);
+}
+
+NUMERICSNATIVE_API void qd_array_div(qd_real* self, const qd_real* val, int count)
+{
+	array_div(self, val, count);
+}
+
+NUMERICSNATIVE_API void qd_array_row_update(qd_real* row, const qd_real* pivot_row, int count, qd_real& factor)
+{
+	factor = array_row_update(row, pivot_row, count);
+}
+
 NUMERICSNATIVE_API BSTR qd_to_string(qd_real& self)
 {
 	std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
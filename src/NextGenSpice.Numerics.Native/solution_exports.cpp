@@ -0,0 +1,33 @@
+#include "numerics.native.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// Checks the solution of one Newton-Raphson iteration in a single pass. Returns -1 if any of the values is NaN or
+// infinity (which is also how a zero pivot shows in the back-substitution) and leaves the nodes untouched. Otherwise
+// copies the first node_count values into nodes and returns 1 if all of them were within tolerance from the previous
+// values and 0 if not. The largest change of the node values is stored into update_norm.
+NUMERICSNATIVE_API int __stdcall solution_update(const double* x, int count, double* nodes, int node_count,
+                                                 double abstol, double reltol, double* update_norm)
+{
+	auto finite = 0.0;
+	auto norm = 0.0;
+	auto converged = true;
+	for (auto i = 0; i < node_count; ++i)
+	{
+		const auto v1 = nodes[i];
+		const auto v2 = x[i];
+		const auto tol = reltol * std::max(std::fabs(v1), std::fabs(v2)) + abstol;
+		converged &= std::fabs(v1 - v2) < tol;
+		norm = std::max(norm, std::fabs(v1 - v2));
+		finite += v2 * 0.0;
+	}
+
+	for (auto i = node_count; i < count; ++i) finite += x[i] * 0.0;
+	if (finite != finite) return -1;
+
+	std::memcpy(nodes, x, node_count * sizeof(double));
+	*update_norm = norm;
+	return converged ? 1 : 0;
+}
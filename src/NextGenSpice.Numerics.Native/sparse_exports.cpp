@@ -0,0 +1,86 @@
+#include "numerics.native.h"
+#include "sparse_lu.h"
+
+#include <qd/qd_real.h>
+
+template <typename Prec>
+int do_sparse_solve(int size, const int* ptr, const int* ind, const Prec* values, Prec* b, int format)
+{
+	if (format != format_csc && format != format_csr) return sparse_invalid;
+
+	SparsePattern pattern(size, ptr, ind, format);
+	if (!pattern.valid()) return sparse_invalid;
+
+	SparseLu<Prec> lu(pattern);
+	if (!lu.factor(values)) return sparse_singular;
+
+	lu.solve(b);
+	return sparse_ok;
+}
+
+NUMERICSNATIVE_API int __stdcall sparse_solve_double(int size, const int* ptr, const int* ind, const double* values,
+                                                     double* b, int format)
+{
+	return do_sparse_solve(size, ptr, ind, values, b, format);
+}
+
+NUMERICSNATIVE_API int __stdcall sparse_solve_dd(int size, const int* ptr, const int* ind, const dd_real* values,
+                                                 dd_real* b, int format)
+{
+	return do_sparse_solve(size, ptr, ind, values, b, format);
+}
+
+NUMERICSNATIVE_API int __stdcall sparse_solve_qd(int size, const int* ptr, const int* ind, const qd_real* values,
+                                                 qd_real* b, int format)
+{
+	return do_sparse_solve(size, ptr, ind, values, b, format);
+}
+
+NUMERICSNATIVE_API SparseLu<double>* __stdcall sparse_analyze_double(int size, const int* ptr, const int* ind,
+                                                                     int format, int ordering, double pivot_tolerance)
+{
+	if (format != format_csc && format != format_csr) return nullptr;
+	if (ordering != ordering_natural && ordering != ordering_min_degree) return nullptr;
+	if (!(pivot_tolerance > 0 && pivot_tolerance <= 1)) return nullptr;
+
+	SparsePattern pattern(size, ptr, ind, format);
+	if (!pattern.valid()) return nullptr;
+
+	return new SparseLu<double>(pattern, ordering, pivot_tolerance);
+}
+
+NUMERICSNATIVE_API int __stdcall sparse_factor_double(SparseLu<double>* lu, const double* values)
+{
+	return lu->factor(values) ? sparse_ok : sparse_singular;
+}
+
+NUMERICSNATIVE_API int __stdcall sparse_factor_partial_double(SparseLu<double>* lu, const double* values,
+                                                             const int* changed, int count)
+{
+	return lu->factor_partial(values, changed, count) ? sparse_ok : sparse_singular;
+}
+
+NUMERICSNATIVE_API int __stdcall sparse_computed_columns_double(SparseLu<double>* lu)
+{
+	return lu->computed_columns();
+}
+
+NUMERICSNATIVE_API void __stdcall sparse_solve_factored_double(SparseLu<double>* lu, double* b)
+{
+	lu->solve(b);
+}
+
+NUMERICSNATIVE_API int __stdcall sparse_predicted_nonzeros_double(SparseLu<double>* lu)
+{
+	return lu->predicted_nonzeros();
+}
+
+NUMERICSNATIVE_API int __stdcall sparse_factor_nonzeros_double(SparseLu<double>* lu)
+{
+	return lu->factor_nonzeros();
+}
+
+NUMERICSNATIVE_API void __stdcall sparse_free_double(SparseLu<double>* lu)
+{
+	delete lu;
+}
@@ -0,0 +1,598 @@
+#ifndef SPARSE_LU_H
+#define SPARSE_LU_H
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <queue>
+
+// Layout of the sparse matrix passed through the exported functions.
+enum sparse_format
+{
+	format_csc = 0, // column pointers, row indices
+	format_csr = 1  // row pointers, column indices
+};
+
+// Column ordering used by the sparse LU factorization.
+enum sparse_ordering
+{
+	ordering_natural = 0,
+	ordering_min_degree = 1 // minimum degree on the pattern of A + A^T
+};
+
+// Result codes of the sparse solver functions.
+enum sparse_status
+{
+	sparse_ok = 0,
+	sparse_singular = 1,
+	sparse_invalid = 2
+};
+
+// Nonzero pattern of a square matrix in compressed column form. Remembers position of each entry in the
+// caller's value array, so that values can be passed in the original (CSC or CSR) order.
+class SparsePattern
+{
+public:
+	SparsePattern(int size, const int* ptr, const int* ind, int format) : n{size}, colptr(size + 1, 0)
+	{
+		const auto nnz = ptr[size];
+		rowind.resize(nnz);
+		source.resize(nnz);
+
+		if (format == format_csc)
+		{
+			std::copy(ptr, ptr + size + 1, colptr.begin());
+			std::copy(ind, ind + nnz, rowind.begin());
+			for (auto p = 0; p < nnz; ++p) source[p] = p;
+			return;
+		}
+
+		// transpose the compressed row form
+		for (auto p = 0; p < nnz; ++p) ++colptr[ind[p] + 1];
+		for (auto j = 0; j < size; ++j) colptr[j + 1] += colptr[j];
+
+		std::vector<int> next(colptr.begin(), colptr.end() - 1);
+		for (auto i = 0; i < size; ++i)
+			for (auto p = ptr[i]; p < ptr[i + 1]; ++p)
+			{
+				const auto q = next[ind[p]]++;
+				rowind[q] = i;
+				source[q] = p;
+			}
+	}
+
+	// Checks that all indices are in range.
+	bool valid() const
+	{
+		if (n <= 0) return false;
+		for (auto j = 0; j < n; ++j)
+			if (colptr[j] > colptr[j + 1]) return false;
+		for (auto i : rowind)
+			if (i < 0 || i >= n) return false;
+		return true;
+	}
+
+	int size() const { return n; }
+	int nonzeros() const { return colptr[n]; }
+
+	int n;
+	std::vector<int> colptr;
+	std::vector<int> rowind;
+	std::vector<int> source;
+};
+
+// Computes minimum degree ordering of the graph of A + A^T. The graph is eliminated explicitly, which is affordable
+// for the very sparse matrices of circuit equations. Ties are broken by the lower index to keep the ordering
+// deterministic.
+inline std::vector<int> minimum_degree_ordering(const SparsePattern& pattern)
+{
+	const auto n = pattern.size();
+
+	std::vector<std::vector<int>> adj(n);
+	for (auto j = 0; j < n; ++j)
+		for (auto p = pattern.colptr[j]; p < pattern.colptr[j + 1]; ++p)
+		{
+			const auto i = pattern.rowind[p];
+			if (i == j) continue;
+			adj[i].push_back(j);
+			adj[j].push_back(i);
+		}
+
+	for (auto& a : adj)
+	{
+		std::sort(a.begin(), a.end());
+		a.erase(std::unique(a.begin(), a.end()), a.end());
+	}
+
+	using entry = std::pair<int, int>; // degree, node
+	std::priority_queue<entry, std::vector<entry>, std::greater<entry>> queue;
+	for (auto i = 0; i < n; ++i) queue.emplace(static_cast<int>(adj[i].size()), i);
+
+	std::vector<bool> eliminated(n, false);
+	std::vector<int> order;
+	order.reserve(n);
+
+	std::vector<int> merged;
+	while (!queue.empty())
+	{
+		const auto top = queue.top();
+		queue.pop();
+
+		const auto v = top.second;
+		// skip stale entries
+		if (eliminated[v] || top.first != static_cast<int>(adj[v].size())) continue;
+
+		eliminated[v] = true;
+		order.push_back(v);
+
+		// neighbors of v form a clique after its elimination
+		const auto& clique = adj[v];
+		for (auto u : clique)
+		{
+			merged.clear();
+			std::set_union(adj[u].begin(), adj[u].end(), clique.begin(), clique.end(), std::back_inserter(merged));
+			merged.erase(std::remove_if(merged.begin(), merged.end(), [&](int w) { return w == u || w == v; }),
+			             merged.end());
+			adj[u].swap(merged);
+			queue.emplace(static_cast<int>(adj[u].size()), u);
+		}
+
+		adj[v].clear();
+		adj[v].shrink_to_fit();
+	}
+
+	return order;
+}
+
+// Left-looking sparse LU factorization (Gilbert-Peierls) with threshold partial pivoting. Computes
+// P * A * Q = L * U where L is unit lower triangular. Rows of L are kept in original row numbering, rows of U are
+// in pivot step numbering.
+//
+// The symbolic analysis (column ordering, elimination tree and the predicted factor size) runs once in the
+// constructor. The first factorization finds the pivot sequence and the pattern of L and U, following calls
+// only recompute the values over that pattern as long as the pivots stay acceptable.
+template <typename Prec>
+class SparseLu
+{
+public:
+	explicit SparseLu(const SparsePattern& pattern, int ordering = ordering_min_degree, double pivot_tolerance = 0.1)
+		: pattern{pattern}, tolerance{pivot_tolerance}, has_pattern{false}, computed{0}
+	{
+		const auto n = pattern.size();
+		if (ordering == ordering_min_degree)
+			q = minimum_degree_ordering(pattern);
+		else
+		{
+			q.resize(n);
+			for (auto k = 0; k < n; ++k) q[k] = k;
+		}
+
+		analyze();
+
+		// pivot step of the column of each value slot
+		std::vector<int> step(n);
+		for (auto k = 0; k < n; ++k) step[q[k]] = k;
+		slot_step.resize(pattern.nonzeros());
+		for (auto j = 0; j < n; ++j)
+			for (auto p = pattern.colptr[j]; p < pattern.colptr[j + 1]; ++p)
+				slot_step[pattern.source[p]] = step[j];
+
+		pinv.resize(n);
+		prow.resize(n);
+		lp.resize(n + 1);
+		up.resize(n + 1);
+		udiag.resize(n);
+
+		x.resize(n);
+		xi.resize(n);
+		stack.resize(n);
+		pstack.resize(n);
+		marked.resize(n);
+		stale.resize(n);
+	}
+
+	// Factorizes the matrix with given values (in the order of the input format), reusing the pivot sequence and
+	// pattern of the previous factorization if possible. Returns false if matrix is singular.
+	bool factor(const Prec* values)
+	{
+		if (has_pattern && refactor(values)) return true;
+		return factor_full(values);
+	}
+
+	// Factorizes the matrix whose values differ from the last successfully factored ones only at given slots
+	// (indices into the value array). Only the columns of the factors depending on these values are recomputed
+	// if the pivot sequence can be reused. Returns false if matrix is singular.
+	bool factor_partial(const Prec* values, const int* changed, int count)
+	{
+		if (has_pattern && refactor_partial(values, changed, count)) return true;
+		return factor_full(values);
+	}
+
+	// Factorizes the matrix with given values including the search for pivots. Returns false if matrix is singular.
+	bool factor_full(const Prec* values)
+	{
+		using std::abs;
+		const auto n = pattern.size();
+
+		has_pattern = false;
+		computed = 0;
+		li.clear();
+		lx.clear();
+		ui.clear();
+		ux.clear();
+		std::fill(pinv.begin(), pinv.end(), -1);
+
+		for (auto k = 0; k < n; ++k)
+		{
+			lp[k] = static_cast<int>(li.size());
+			up[k] = static_cast<int>(ui.size());
+
+			const auto j = q[k];
+			const auto top = reach(j);
+			++computed;
+
+			// scatter column of A and eliminate using already computed columns of L
+			for (auto p = pattern.colptr[j]; p < pattern.colptr[j + 1]; ++p)
+				x[pattern.rowind[p]] = values[pattern.source[p]];
+
+			for (auto px = top; px < n; ++px)
+			{
+				const auto s = pinv[xi[px]];
+				if (s < 0) continue;
+
+				const auto xs = x[xi[px]];
+				for (auto p = lp[s]; p < lp[s + 1]; ++p)
+					x[li[p]] -= lx[p] * xs;
+			}
+
+			// gather U part and search for the pivot among remaining rows
+			auto ipiv = -1;
+			Prec maxabs = Prec();
+			for (auto px = top; px < n; ++px)
+			{
+				const auto i = xi[px];
+				const auto s = pinv[i];
+				if (s >= 0)
+				{
+					ui.push_back(s);
+					ux.push_back(x[i]);
+					continue;
+				}
+
+				const auto a = abs(x[i]);
+				if (a > maxabs)
+				{
+					maxabs = a;
+					ipiv = i;
+				}
+			}
+
+			if (ipiv < 0 || maxabs == Prec())
+			{
+				clear(top);
+				return false;
+			}
+
+			// prefer the diagonal to keep the pattern close to the symmetric one
+			if (pinv[j] < 0 && abs(x[j]) >= tolerance * maxabs && x[j] != Prec()) ipiv = j;
+
+			const auto pivot = x[ipiv];
+			udiag[k] = pivot;
+			pinv[ipiv] = k;
+			prow[k] = ipiv;
+
+			for (auto px = top; px < n; ++px)
+			{
+				const auto i = xi[px];
+				if (pinv[i] >= 0) continue;
+
+				li.push_back(i);
+				lx.push_back(x[i] / pivot);
+			}
+
+			clear(top);
+		}
+
+		lp[n] = static_cast<int>(li.size());
+		up[n] = static_cast<int>(ui.size());
+		has_pattern = true;
+		return true;
+	}
+
+	// Recomputes values of the factors over the pattern and pivot sequence found by the last full factorization.
+	// Returns false if some pivot became too small, in which case the factors are invalid.
+	bool refactor(const Prec* values)
+	{
+		const auto n = pattern.size();
+
+		computed = 0;
+		for (auto k = 0; k < n; ++k)
+		{
+			++computed;
+			if (!refactor_column(k, values)) return false;
+		}
+
+		return true;
+	}
+
+	// Recomputes only the columns of the factors affected by the values at given slots. Column k of L and U depends
+	// on column q[k] of A and on the columns of L in the pattern of its U part, so a column is recomputed if its
+	// column of A changed or if it uses a recomputed column. Returns false if some pivot became too small, in which
+	// case the factors are invalid.
+	bool refactor_partial(const Prec* values, const int* changed, int count)
+	{
+		const auto n = pattern.size();
+
+		auto first = n;
+		for (auto i = 0; i < count; ++i)
+		{
+			const auto k = slot_step[changed[i]];
+			stale[k] = true;
+			first = std::min(first, k);
+		}
+
+		computed = 0;
+		auto ok = true;
+		for (auto k = first; k < n && ok; ++k)
+		{
+			for (auto p = up[k]; p < up[k + 1] && !stale[k]; ++p)
+				if (stale[ui[p]]) stale[k] = true;
+
+			if (!stale[k]) continue;
+
+			++computed;
+			ok = refactor_column(k, values);
+		}
+
+		std::fill(stale.begin() + first, stale.end(), false);
+		return ok;
+	}
+
+	// Solves A * x = b using computed factors, the solution overwrites b.
+	void solve(Prec* b)
+	{
+		const auto n = pattern.size();
+
+		// forward substitution with L, rows still in original numbering
+		for (auto k = 0; k < n; ++k)
+		{
+			const auto yk = b[prow[k]];
+			x[k] = yk;
+			if (yk == Prec()) continue;
+			for (auto p = lp[k]; p < lp[k + 1]; ++p)
+				b[li[p]] -= lx[p] * yk;
+		}
+
+		// backward substitution with U, rows in pivot order
+		for (auto k = n - 1; k >= 0; --k)
+		{
+			if (x[k] == Prec()) continue;
+			x[k] /= udiag[k];
+			const auto xk = x[k];
+			for (auto p = up[k]; p < up[k + 1]; ++p)
+				x[ui[p]] -= ux[p] * xk;
+		}
+
+		for (auto k = 0; k < n; ++k)
+		{
+			b[q[k]] = x[k];
+			x[k] = Prec();
+		}
+	}
+
+	// Number of columns of the factors computed by the last factorization, the rest was kept from the previous one.
+	int computed_columns() const { return computed; }
+
+	// Number of entries in the L and U factors including the diagonal of U.
+	int factor_nonzeros() const { return static_cast<int>(li.size() + ui.size()) + pattern.size(); }
+
+	// Parent of each pivot step in the elimination tree of A + A^T, -1 for roots.
+	const std::vector<int>& elimination_tree() const { return parent; }
+
+	// Predicted number of entries in L and U including the diagonal, exact if all diagonal pivots are accepted.
+	int predicted_nonzeros() const { return predicted; }
+
+private:
+	// Computes the elimination tree of the pattern of A + A^T in the column order and the size of its Cholesky factor.
+	// This predicts the size of L and U when the diagonal pivots are accepted, and it is used to preallocate the
+	// factors.
+	void analyze()
+	{
+		const auto n = pattern.size();
+
+		std::vector<int> step(n);
+		for (auto k = 0; k < n; ++k) step[q[k]] = k;
+
+		// neighbors of each step in the symmetrized graph with lower step number
+		std::vector<std::vector<int>> lower(n);
+		for (auto j = 0; j < n; ++j)
+			for (auto p = pattern.colptr[j]; p < pattern.colptr[j + 1]; ++p)
+			{
+				const auto a = step[pattern.rowind[p]];
+				const auto b = step[j];
+				if (a < b) lower[b].push_back(a);
+				else if (b < a) lower[a].push_back(b);
+			}
+
+		parent.assign(n, -1);
+		std::vector<int> ancestor(n, -1);
+		for (auto k = 0; k < n; ++k)
+			for (auto i : lower[k])
+			{
+				// walk to the root of the current subtree using path compression
+				while (i != -1 && i < k)
+				{
+					const auto inext = ancestor[i];
+					ancestor[i] = k;
+					if (inext == -1) parent[i] = k;
+					i = inext;
+				}
+			}
+
+		// row k of the Cholesky factor is the union of tree paths from its lower neighbors to k
+		std::vector<int> mark(n, -1);
+		auto lnz = 0;
+		for (auto k = 0; k < n; ++k)
+		{
+			mark[k] = k;
+			for (auto i : lower[k])
+				for (; mark[i] != k; i = parent[i])
+				{
+					mark[i] = k;
+					++lnz;
+				}
+		}
+
+		predicted = 2 * lnz + n;
+
+		li.reserve(lnz);
+		lx.reserve(lnz);
+		ui.reserve(lnz);
+		ux.reserve(lnz);
+	}
+
+	// Recomputes k-th column of the factors using the current values of the columns it depends on. Returns false if
+	// the pivot became too small.
+	bool refactor_column(int k, const Prec* values)
+	{
+		using std::abs;
+
+		const auto j = q[k];
+		for (auto p = pattern.colptr[j]; p < pattern.colptr[j + 1]; ++p)
+			x[pattern.rowind[p]] = values[pattern.source[p]];
+
+		// U entries are stored in topological order, so they can be eliminated in sequence
+		for (auto p = up[k]; p < up[k + 1]; ++p)
+		{
+			const auto s = ui[p];
+			const auto xs = x[prow[s]];
+			x[prow[s]] = Prec();
+			ux[p] = xs;
+
+			for (auto pl = lp[s]; pl < lp[s + 1]; ++pl)
+				x[li[pl]] -= lx[pl] * xs;
+		}
+
+		const auto pivot = x[prow[k]];
+		x[prow[k]] = Prec();
+
+		Prec maxabs = abs(pivot);
+		for (auto p = lp[k]; p < lp[k + 1]; ++p)
+		{
+			const auto a = abs(x[li[p]]);
+			if (a > maxabs) maxabs = a;
+		}
+
+		if (pivot == Prec() || abs(pivot) < tolerance * maxabs)
+		{
+			for (auto p = lp[k]; p < lp[k + 1]; ++p) x[li[p]] = Prec();
+			return false;
+		}
+
+		udiag[k] = pivot;
+		for (auto p = lp[k]; p < lp[k + 1]; ++p)
+		{
+			lx[p] = x[li[p]] / pivot;
+			x[li[p]] = Prec();
+		}
+
+		return true;
+	}
+
+	// Finds rows reachable from the pattern of j-th column of A in the graph of L. Result is stored in xi[top..n) in
+	// topological order.
+	int reach(int j)
+	{
+		const auto n = pattern.size();
+		auto top = n;
+
+		for (auto p = pattern.colptr[j]; p < pattern.colptr[j + 1]; ++p)
+		{
+			const auto i = pattern.rowind[p];
+			if (!marked[i]) top = dfs(i, top);
+		}
+
+		for (auto px = top; px < n; ++px) marked[xi[px]] = false;
+		return top;
+	}
+
+	// Non-recursive depth first search from given row, found rows are prepended to xi.
+	int dfs(int start, int top)
+	{
+		auto head = 0;
+		stack[0] = start;
+
+		while (head >= 0)
+		{
+			const auto i = stack[head];
+			const auto s = pinv[i];
+
+			if (!marked[i])
+			{
+				marked[i] = true;
+				pstack[head] = s < 0 ? 0 : lp[s];
+			}
+
+			auto done = true;
+			const auto end = s < 0 ? 0 : lp[s + 1];
+			for (auto p = pstack[head]; p < end; ++p)
+			{
+				const auto r = li[p];
+				if (marked[r]) continue;
+
+				pstack[head] = p + 1;
+				stack[++head] = r;
+				done = false;
+				break;
+			}
+
+			if (done)
+			{
+				--head;
+				xi[--top] = i;
+			}
+		}
+
+		return top;
+	}
+
+	// Clears the dense work vector on positions used by the last column.
+	void clear(int top)
+	{
+		const auto n = pattern.size();
+		for (auto px = top; px < n; ++px) x[xi[px]] = Prec();
+	}
+
+	const SparsePattern pattern;
+	double tolerance;
+	bool has_pattern; // whether the factors hold a valid pattern and pivot sequence
+
+	std::vector<int> q; // column permutation
+	std::vector<int> parent; // elimination tree
+	int predicted;
+	int computed; // columns computed by the last factorization
+	std::vector<int> slot_step; // pivot step of the column of given value slot
+	std::vector<int> pinv; // pivot step of given row
+	std::vector<int> prow; // pivot row of given step
+
+	std::vector<int> lp;
+	std::vector<int> li;
+	std::vector<Prec> lx;
+
+	std::vector<int> up;
+	std::vector<int> ui;
+	std::vector<Prec> ux;
+	std::vector<Prec> udiag;
+
+	// work arrays
+	std::vector<Prec> x;
+	std::vector<int> xi;
+	std::vector<int> stack;
+	std::vector<int> pstack;
+	std::vector<bool> marked;
+	std::vector<bool> stale; // columns to be recomputed by the partial refactorization
+};
+
+#endif // SPARSE_LU_H
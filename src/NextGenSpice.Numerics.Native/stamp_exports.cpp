@@ -0,0 +1,46 @@
+#include "numerics.native.h"
+
+#include <cstdlib>
+#include <cstring>
+
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
+
+namespace
+{
+	// values are aligned to the cache line so that the stamped entries of one device share as few lines as possible
+	const size_t value_alignment = 64;
+}
+
+NUMERICSNATIVE_API double* __stdcall stamp_values_create(int count)
+{
+	if (count <= 0) return nullptr;
+
+	// the size must be a multiple of the alignment for aligned_alloc
+	const auto size = (count * sizeof(double) + value_alignment - 1) / value_alignment * value_alignment;
+#ifdef _MSC_VER
+	const auto values = static_cast<double*>(_aligned_malloc(size, value_alignment));
+#else
+	const auto values = static_cast<double*>(aligned_alloc(value_alignment, size));
+#endif
+	if (values != nullptr) std::memset(values, 0, size);
+	return values;
+}
+
+NUMERICSNATIVE_API int __stdcall stamp_values_all_finite(const double* values, int count)
+{
+	// accumulate instead of branching on every value, both infinity and NaN give NaN in the sum
+	auto sum = 0.0;
+	for (auto i = 0; i < count; ++i) sum += values[i] * 0.0;
+	return sum == sum ? 1 : 0;
+}
+
+NUMERICSNATIVE_API void __stdcall stamp_values_free(double* values)
+{
+#ifdef _MSC_VER
+	_aligned_free(values);
+#else
+	free(values);
+#endif
+}
@@ -0,0 +1,146 @@
+#include "task_scheduler.h"
+
+int TaskGraph::add_task(std::function<void()> work)
+{
+	tasks.push_back(Task{std::move(work), {}, 0});
+	return size() - 1;
+}
+
+void TaskGraph::add_dependency(int before, int after)
+{
+	tasks[before].successors.push_back(after);
+	++tasks[after].predecessor_count;
+}
+
+WorkStealingPool::WorkStealingPool(int threads) : remaining{0}, current{nullptr}, generation{0}, active{0},
+                                                  stopping{false}
+{
+	if (threads <= 0) threads = static_cast<int>(std::thread::hardware_concurrency());
+	if (threads <= 0) threads = 1;
+
+	for (auto i = 0; i < threads; ++i) queues.emplace_back(new Queue());
+	// queue 0 belongs to the thread calling run()
+	for (auto i = 1; i < threads; ++i) workers.emplace_back(&WorkStealingPool::worker_loop, this, i);
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	start_condition.notify_all();
+
+	for (auto& worker : workers) worker.join();
+}
+
+void WorkStealingPool::run(TaskGraph& graph)
+{
+	const auto count = graph.size();
+	if (count == 0) return;
+
+	pending.reset(new std::atomic<int>[count]);
+	for (auto i = 0; i < count; ++i)
+	{
+		pending[i] = graph.tasks[i].predecessor_count;
+		if (graph.tasks[i].predecessor_count == 0) push(0, i);
+	}
+	remaining = count;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		current = &graph;
+		++generation;
+	}
+	start_condition.notify_all();
+
+	work(0, graph);
+
+	// workers which did not pick up the graph yet will see that there is none
+	std::unique_lock<std::mutex> lock(mutex);
+	done_condition.wait(lock, [this] { return active == 0; });
+	current = nullptr;
+}
+
+void WorkStealingPool::worker_loop(int id)
+{
+	auto seen = 0u;
+	for (;;)
+	{
+		TaskGraph* graph;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			start_condition.wait(lock, [this, seen] { return stopping || generation != seen; });
+			if (stopping) return;
+
+			seen = generation;
+			graph = current;
+			if (graph == nullptr) continue;
+			++active;
+		}
+
+		work(id, *graph);
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			--active;
+		}
+		done_condition.notify_all();
+	}
+}
+
+void WorkStealingPool::work(int id, TaskGraph& graph)
+{
+	while (remaining > 0)
+	{
+		int task;
+		if (!pop(id, task) && !steal(id, task))
+		{
+			std::this_thread::yield();
+			continue;
+		}
+
+		graph.tasks[task].work();
+
+		for (auto successor : graph.tasks[task].successors)
+			if (--pending[successor] == 0) push(id, successor);
+
+		// decremented only after the successors are queued, so that no thread leaves while there is work left
+		--remaining;
+	}
+}
+
+bool WorkStealingPool::pop(int id, int& task)
+{
+	auto& queue = *queues[id];
+	std::lock_guard<std::mutex> lock(queue.mutex);
+	if (queue.tasks.empty()) return false;
+
+	task = queue.tasks.back();
+	queue.tasks.pop_back();
+	return true;
+}
+
+bool WorkStealingPool::steal(int id, int& task)
+{
+	const auto count = thread_count();
+	for (auto i = 1; i < count; ++i)
+	{
+		auto& queue = *queues[(id + i) % count];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (queue.tasks.empty()) continue;
+
+		task = queue.tasks.front();
+		queue.tasks.pop_front();
+		return true;
+	}
+
+	return false;
+}
+
+void WorkStealingPool::push(int id, int task)
+{
+	auto& queue = *queues[id];
+	std::lock_guard<std::mutex> lock(queue.mutex);
+	queue.tasks.push_back(task);
+}
@@ -0,0 +1,85 @@
+#ifndef TASK_SCHEDULER_H
+#define TASK_SCHEDULER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Directed acyclic graph of tasks, a task can be executed once all its predecessors have finished.
+class TaskGraph
+{
+public:
+	// Adds a new task and returns its index.
+	int add_task(std::function<void()> work);
+
+	// Makes the task after wait for the task before.
+	void add_dependency(int before, int after);
+
+	int size() const { return static_cast<int>(tasks.size()); }
+
+private:
+	friend class WorkStealingPool;
+
+	struct Task
+	{
+		std::function<void()> work;
+		std::vector<int> successors;
+		int predecessor_count;
+	};
+
+	std::vector<Task> tasks;
+};
+
+// Pool of threads executing task graphs. Each thread keeps its own queue of ready tasks and takes the most recently
+// added ones, idle threads steal the oldest tasks from the queues of other threads.
+class WorkStealingPool
+{
+public:
+	// Creates pool which executes tasks on given number of threads including the calling thread, 0 means number of
+	// hardware threads.
+	explicit WorkStealingPool(int threads);
+	~WorkStealingPool();
+
+	WorkStealingPool(const WorkStealingPool&) = delete;
+	WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+	// Number of threads including the calling thread.
+	int thread_count() const { return static_cast<int>(queues.size()); }
+
+	// Executes all tasks of the graph and returns when they are finished. The calling thread takes part in the work.
+	void run(TaskGraph& graph);
+
+private:
+	struct Queue
+	{
+		std::mutex mutex;
+		std::deque<int> tasks;
+	};
+
+	void worker_loop(int id);
+	void work(int id, TaskGraph& graph);
+	bool pop(int id, int& task);
+	bool steal(int id, int& task);
+	void push(int id, int task);
+
+	std::vector<std::unique_ptr<Queue>> queues;
+	std::vector<std::thread> workers;
+	std::unique_ptr<std::atomic<int>[]> pending;
+	std::atomic<int> remaining;
+
+	// guards the fields below, which describe the currently executed graph
+	std::mutex mutex;
+	std::condition_variable start_condition;
+	std::condition_variable done_condition;
+	TaskGraph* current;
+	unsigned generation;
+	int active;
+	bool stopping;
+};
+
+#endif // TASK_SCHEDULER_H
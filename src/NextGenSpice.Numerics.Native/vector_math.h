@@ -0,0 +1,37 @@
+#ifndef VECTOR_MATH_H
+#define VECTOR_MATH_H
+
+#include <cmath>
+
+#include "cpu_features.h"
+#include "math_avx2.h"
+
+// Elementary functions over arrays of doubles. The AVX2 kernels are used when available, see math_avx2.h for their
+// error bounds. The fallback uses the C library functions, so the results may differ in the last bit between the
+// two. The input and the result arrays may be the same.
+
+inline void vector_exp(const double* x, double* result, int count)
+{
+	if (cpu_supports_avx2_fma())
+		exp_avx2(x, result, count);
+	else
+		for (auto i = 0; i < count; ++i) result[i] = std::exp(x[i]);
+}
+
+inline void vector_log(const double* x, double* result, int count)
+{
+	if (cpu_supports_avx2_fma())
+		log_avx2(x, result, count);
+	else
+		for (auto i = 0; i < count; ++i) result[i] = std::log(x[i]);
+}
+
+inline void vector_pow(const double* x, const double* y, double* result, int count)
+{
+	if (cpu_supports_avx2_fma())
+		pow_avx2(x, y, result, count);
+	else
+		for (auto i = 0; i < count; ++i) result[i] = std::pow(x[i], y[i]);
+}
+
+#endif // VECTOR_MATH_H
@@ -0,0 +1,194 @@
+using System.Runtime.InteropServices;
+using System.Security;
+
+namespace NextGenSpice.Numerics
+{
+	/// <summary>Fields of the <see cref="BjtGroupBuffer" />, the order must match the native bjt_field.</summary>
+	public enum BjtField
+	{
+		/// <summary>Saturation current parameter.</summary>
+		SaturationCurrent,
+
+		/// <summary>Base-emitter leakage saturation current parameter.</summary>
+		LeakageSaturationCurrentBe,
+
+		/// <summary>Base-collector leakage saturation current parameter.</summary>
+		LeakageSaturationCurrentBc,
+
+		/// <summary>Thermal voltage multiplied by the forward emission coefficient.</summary>
+		ThermalVoltageForward,
+
+		/// <summary>Thermal voltage multiplied by the reverse emission coefficient.</summary>
+		ThermalVoltageReverse,
+
+		/// <summary>Thermal voltage multiplied by the base-emitter leakage emission coefficient.</summary>
+		ThermalVoltageLeakageBe,
+
+		/// <summary>Thermal voltage multiplied by the base-collector leakage emission coefficient.</summary>
+		ThermalVoltageLeakageBc,
+
+		/// <summary>Forward beta parameter.</summary>
+		ForwardBeta,
+
+		/// <summary>Reverse beta parameter.</summary>
+		ReverseBeta,
+
+		/// <summary>Forward early voltage parameter.</summary>
+		ForwardEarlyVoltage,
+
+		/// <summary>Reverse early voltage parameter.</summary>
+		ReverseEarlyVoltage,
+
+		/// <summary>Forward current corner parameter.</summary>
+		ForwardCurrentCorner,
+
+		/// <summary>Reverse current corner parameter.</summary>
+		ReverseCurrentCorner,
+
+		/// <summary>+1 for npn transistors, -1 for pnp transistors.</summary>
+		Polarity,
+
+		/// <summary>Forward transit time parameter.</summary>
+		ForwardTransitTime,
+
+		/// <summary>Reverse transit time parameter.</summary>
+		ReverseTransitTime,
+
+		/// <summary>Forward bias depletion coefficient parameter.</summary>
+		ForwardBiasDepletionCoefficient,
+
+		/// <summary>Base-emitter zero-bias capacitance parameter.</summary>
+		EmitterCapacitance,
+
+		/// <summary>Base-emitter exponential factor parameter.</summary>
+		EmitterExponentialFactor,
+
+		/// <summary>Base-emitter potential parameter.</summary>
+		EmitterPotential,
+
+		/// <summary>Base-collector zero-bias capacitance parameter.</summary>
+		CollectorCapacitance,
+
+		/// <summary>Base-collector exponential factor parameter.</summary>
+		CollectorExponentialFactor,
+
+		/// <summary>Base-collector potential parameter.</summary>
+		CollectorPotential,
+
+		/// <summary>Collector-substrate zero-bias capacitance parameter.</summary>
+		SubstrateCapacitance,
+
+		/// <summary>Collector-substrate exponential factor parameter.</summary>
+		SubstrateExponentialFactor,
+
+		/// <summary>Collector-substrate potential parameter.</summary>
+		SubstratePotential,
+
+		/// <summary>Input: minimal conductance of the junctions.</summary>
+		MinimalConductance,
+
+		/// <summary>Input: voltage between base and emitter.</summary>
+		VoltageBaseEmitter,
+
+		/// <summary>Input: voltage between base and collector.</summary>
+		VoltageBaseCollector,
+
+		/// <summary>Input: voltage between collector and substrate.</summary>
+		VoltageCollectorSubstrate,
+
+		/// <summary>Output: current flowing through the collector terminal.</summary>
+		CurrentCollector,
+
+		/// <summary>Output: current flowing through the base terminal.</summary>
+		CurrentBase,
+
+		/// <summary>Output: conductance between base and emitter.</summary>
+		ConductancePi,
+
+		/// <summary>Output: conductance between base and collector.</summary>
+		ConductanceMu,
+
+		/// <summary>Output: transconductance.</summary>
+		Transconductance,
+
+		/// <summary>Output: output conductance.</summary>
+		OutputConductance,
+
+		/// <summary>Output: equivalent current source between base and emitter.</summary>
+		EquivalentCurrentBe,
+
+		/// <summary>Output: equivalent current source between base and collector.</summary>
+		EquivalentCurrentBc,
+
+		/// <summary>Output: current of the base-emitter junction.</summary>
+		CurrentBaseEmitter,
+
+		/// <summary>Output: current of the base-collector junction.</summary>
+		CurrentBaseCollector,
+
+		/// <summary>Output: conductance of the base-emitter junction.</summary>
+		ConductanceBaseEmitter,
+
+		/// <summary>Output: conductance of the base-collector junction.</summary>
+		ConductanceBaseCollector,
+
+		/// <summary>Output: base-emitter capacitance.</summary>
+		CapacitanceBaseEmitter,
+
+		/// <summary>Output: base-collector capacitance.</summary>
+		CapacitanceBaseCollector,
+
+		/// <summary>Output: collector-substrate capacitance.</summary>
+		CapacitanceCollectorSubstrate,
+
+		/// <summary>Intermediate value of the native evaluation.</summary>
+		ExpForward,
+
+		/// <summary>Intermediate value of the native evaluation.</summary>
+		ExpLeakageBe,
+
+		/// <summary>Intermediate value of the native evaluation.</summary>
+		ExpReverse,
+
+		/// <summary>Intermediate value of the native evaluation.</summary>
+		ExpLeakageBc,
+
+		/// <summary>Number of the fields.</summary>
+		Count
+	}
+
+	/// <summary>Values of a group of bipolar junction transistors whose Gummel-Poon model is evaluated natively.</summary>
+	public unsafe class BjtGroupBuffer : DeviceGroupBuffer
+	{
+		public BjtGroupBuffer(int count) : base(count, (int) BjtField.Count)
+		{
+		}
+
+		/// <summary>Gets or sets value of given field of the index-th transistor.</summary>
+		/// <param name="field">The field.</param>
+		/// <param name="index">Index of the transistor.</param>
+		/// <returns></returns>
+		public double this[BjtField field, int index]
+		{
+			get => Value((int) field, index);
+			set => Value((int) field, index) = value;
+		}
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void bjt_group_evaluate(double* values, int stride, int count, int capacitances);
+
+		/// <summary>Evaluates the outputs of all transistors including the junction capacitances.</summary>
+		public override void Evaluate()
+		{
+			Evaluate(true);
+		}
+
+		/// <summary>Evaluates the outputs of all transistors from their parameters and voltages.</summary>
+		/// <param name="capacitances">Whether the junction capacitances should be evaluated too.</param>
+		public void Evaluate(bool capacitances)
+		{
+			bjt_group_evaluate(Values, Stride, Count, capacitances ? 1 : 0);
+		}
+	}
+}
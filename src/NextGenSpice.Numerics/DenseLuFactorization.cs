@@ -0,0 +1,415 @@
+﻿using System;
+using System.Runtime.InteropServices;
+using System.Security;
+using NextGenSpice.Numerics.Precision;
+
+namespace NextGenSpice.Numerics
+{
+	/// <summary>
+	///   LU factorization of a dense matrix in double precision kept in native memory. The factorization is recomputed only when
+	///   the matrix differs from the previously factored one.
+	/// </summary>
+	public unsafe class DenseLuFactorization : IDisposable
+	{
+		private IntPtr handle;
+
+		public DenseLuFactorization(int size)
+		{
+			if (size <= 0) throw new ArgumentOutOfRangeException(nameof(size));
+			Size = size;
+			handle = dense_create_double(size);
+		}
+
+		/// <summary>Number of rows or columns of the factored matrix.</summary>
+		public int Size { get; }
+
+		/// <summary>How many times the factorization was actually computed.</summary>
+		public int FactorizationCount { get; private set; }
+
+		/// <summary>Performs application-defined tasks associated with freeing, releasing, or resetting unmanaged resources.</summary>
+		public void Dispose()
+		{
+			ReleaseHandle();
+			GC.SuppressFinalize(this);
+		}
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern IntPtr dense_create_double(int size);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern int dense_factor_double(IntPtr lu, double* mat);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void dense_solve_factored_double(IntPtr lu, double* b);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void dense_free_double(IntPtr lu);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void dense_chord_step_double(IntPtr lu, double* mat, double* b, double* x, double* result);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern double dense_condition_double(IntPtr lu);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern double dense_backward_error_double(IntPtr lu, double* b, double* x);
+
+		/// <summary>
+		///   Factorizes the matrix unless it is the same as the last factored one. Returns true if the factorization was
+		///   recomputed.
+		/// </summary>
+		/// <param name="m">The matrix to be factored, it is not modified.</param>
+		/// <returns></returns>
+		public bool Factor(Matrix<double> m)
+		{
+			if (handle == IntPtr.Zero) throw new ObjectDisposedException(nameof(DenseLuFactorization));
+			if (m.Size != Size) throw new ArgumentException("The matrix is of different size.");
+
+			bool factored;
+			fixed (double* mat = m.RawData)
+			{
+				factored = dense_factor_double(handle, mat) != 0;
+			}
+
+			if (factored) FactorizationCount++;
+			return factored;
+		}
+
+		/// <summary>Solves system of linear equations in the form A*x=b using the last computed factorization.</summary>
+		/// <param name="b">The right hand side vector b.</param>
+		/// <param name="x">The output array for solution x.</param>
+		public void Solve(double[] b, double[] x)
+		{
+			if (handle == IntPtr.Zero) throw new ObjectDisposedException(nameof(DenseLuFactorization));
+			if (FactorizationCount == 0) throw new InvalidOperationException("Matrix must be factored before solving.");
+
+			b.CopyTo(x, 0);
+			fixed (double* rhs = x)
+			{
+				dense_solve_factored_double(handle, rhs);
+			}
+		}
+
+		/// <summary>
+		///   Performs one step of the modified Newton (chord) iteration for the system m*x=b using the last computed
+		///   factorization instead of the factorization of m: result = x + LU^-1 * (b - m*x).
+		/// </summary>
+		/// <param name="m">The current matrix of the system.</param>
+		/// <param name="b">The current right hand side vector b.</param>
+		/// <param name="x">The previous iterate.</param>
+		/// <param name="result">The output array for the new iterate, may be the same array as x.</param>
+		public void ChordStep(Matrix<double> m, double[] b, double[] x, double[] result)
+		{
+			if (handle == IntPtr.Zero) throw new ObjectDisposedException(nameof(DenseLuFactorization));
+			if (FactorizationCount == 0) throw new InvalidOperationException("Matrix must be factored before solving.");
+			if (m.Size != Size || b.Length != Size || x.Length != Size || result.Length != Size)
+				throw new ArgumentException("The matrix or vectors are of different size.");
+
+			fixed (double* mat = m.RawData)
+			fixed (double* rhs = b)
+			fixed (double* sol = x)
+			fixed (double* res = result)
+			{
+				dense_chord_step_double(handle, mat, rhs, sol, res);
+			}
+		}
+
+		/// <summary>
+		///   Returns estimate of the 1-norm condition number of the last factored matrix computed from its LU factors.
+		///   Returns positive infinity for singular matrices.
+		/// </summary>
+		/// <returns></returns>
+		public double EstimateConditionNumber()
+		{
+			if (handle == IntPtr.Zero) throw new ObjectDisposedException(nameof(DenseLuFactorization));
+			if (FactorizationCount == 0) throw new InvalidOperationException("Matrix must be factored before estimating.");
+
+			return dense_condition_double(handle);
+		}
+
+		/// <summary>
+		///   Returns normwise backward error of the solution x of the system with the last factored matrix and right hand
+		///   side b, or NaN if the solution is not finite.
+		/// </summary>
+		/// <param name="b">The right hand side vector b.</param>
+		/// <param name="x">The solution x.</param>
+		/// <returns></returns>
+		public double BackwardError(double[] b, double[] x)
+		{
+			if (handle == IntPtr.Zero) throw new ObjectDisposedException(nameof(DenseLuFactorization));
+			if (FactorizationCount == 0) throw new InvalidOperationException("Matrix must be factored before solving.");
+			if (b.Length != Size || x.Length != Size) throw new ArgumentException("The vectors are of different size.");
+
+			fixed (double* rhs = b)
+			fixed (double* sol = x)
+			{
+				return dense_backward_error_double(handle, rhs, sol);
+			}
+		}
+
+		private void ReleaseHandle()
+		{
+			if (handle == IntPtr.Zero) return;
+			dense_free_double(handle);
+			handle = IntPtr.Zero;
+		}
+
+		~DenseLuFactorization()
+		{
+			ReleaseHandle();
+		}
+	}
+
+#if dd_precision
+	/// <summary>
+	///   LU factorization of a dense matrix in double-double precision kept in native memory. The factorization is recomputed only when
+	///   the matrix differs from the previously factored one.
+	/// </summary>
+	public unsafe class DdDenseLuFactorization : IDisposable
+	{
+		private IntPtr handle;
+
+		public DdDenseLuFactorization(int size)
+		{
+			if (size <= 0) throw new ArgumentOutOfRangeException(nameof(size));
+			Size = size;
+			handle = dense_create_dd(size);
+		}
+
+		/// <summary>Number of rows or columns of the factored matrix.</summary>
+		public int Size { get; }
+
+		/// <summary>How many times the factorization was actually computed.</summary>
+		public int FactorizationCount { get; private set; }
+
+		/// <summary>Performs application-defined tasks associated with freeing, releasing, or resetting unmanaged resources.</summary>
+		public void Dispose()
+		{
+			ReleaseHandle();
+			GC.SuppressFinalize(this);
+		}
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern IntPtr dense_create_dd(int size);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern int dense_factor_dd(IntPtr lu, dd_real* mat);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void dense_solve_factored_dd(IntPtr lu, dd_real* b);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void dense_free_dd(IntPtr lu);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void dense_chord_step_dd(IntPtr lu, dd_real* mat, dd_real* b, dd_real* x, dd_real* result);
+
+		/// <summary>
+		///   Factorizes the matrix unless it is the same as the last factored one. Returns true if the factorization was
+		///   recomputed.
+		/// </summary>
+		/// <param name="m">The matrix to be factored, it is not modified.</param>
+		/// <returns></returns>
+		public bool Factor(Matrix<dd_real> m)
+		{
+			if (handle == IntPtr.Zero) throw new ObjectDisposedException(nameof(DdDenseLuFactorization));
+			if (m.Size != Size) throw new ArgumentException("The matrix is of different size.");
+
+			bool factored;
+			fixed (dd_real* mat = m.RawData)
+			{
+				factored = dense_factor_dd(handle, mat) != 0;
+			}
+
+			if (factored) FactorizationCount++;
+			return factored;
+		}
+
+		/// <summary>Solves system of linear equations in the form A*x=b using the last computed factorization.</summary>
+		/// <param name="b">The right hand side vector b.</param>
+		/// <param name="x">The output array for solution x.</param>
+		public void Solve(dd_real[] b, dd_real[] x)
+		{
+			if (handle == IntPtr.Zero) throw new ObjectDisposedException(nameof(DdDenseLuFactorization));
+			if (FactorizationCount == 0) throw new InvalidOperationException("Matrix must be factored before solving.");
+
+			b.CopyTo(x, 0);
+			fixed (dd_real* rhs = x)
+			{
+				dense_solve_factored_dd(handle, rhs);
+			}
+		}
+
+		/// <summary>
+		///   Performs one step of the modified Newton (chord) iteration for the system m*x=b using the last computed
+		///   factorization instead of the factorization of m: result = x + LU^-1 * (b - m*x).
+		/// </summary>
+		/// <param name="m">The current matrix of the system.</param>
+		/// <param name="b">The current right hand side vector b.</param>
+		/// <param name="x">The previous iterate.</param>
+		/// <param name="result">The output array for the new iterate, may be the same array as x.</param>
+		public void ChordStep(Matrix<dd_real> m, dd_real[] b, dd_real[] x, dd_real[] result)
+		{
+			if (handle == IntPtr.Zero) throw new ObjectDisposedException(nameof(DdDenseLuFactorization));
+			if (FactorizationCount == 0) throw new InvalidOperationException("Matrix must be factored before solving.");
+			if (m.Size != Size || b.Length != Size || x.Length != Size || result.Length != Size)
+				throw new ArgumentException("The matrix or vectors are of different size.");
+
+			fixed (dd_real* mat = m.RawData)
+			fixed (dd_real* rhs = b)
+			fixed (dd_real* sol = x)
+			fixed (dd_real* res = result)
+			{
+				dense_chord_step_dd(handle, mat, rhs, sol, res);
+			}
+		}
+
+		private void ReleaseHandle()
+		{
+			if (handle == IntPtr.Zero) return;
+			dense_free_dd(handle);
+			handle = IntPtr.Zero;
+		}
+
+		~DdDenseLuFactorization()
+		{
+			ReleaseHandle();
+		}
+	}
+#endif
+
+#if qd_precision
+	/// <summary>
+	///   LU factorization of a dense matrix in quad-double precision kept in native memory. The factorization is recomputed only when
+	///   the matrix differs from the previously factored one.
+	/// </summary>
+	public unsafe class QdDenseLuFactorization : IDisposable
+	{
+		private IntPtr handle;
+
+		public QdDenseLuFactorization(int size)
+		{
+			if (size <= 0) throw new ArgumentOutOfRangeException(nameof(size));
+			Size = size;
+			handle = dense_create_qd(size);
+		}
+
+		/// <summary>Number of rows or columns of the factored matrix.</summary>
+		public int Size { get; }
+
+		/// <summary>How many times the factorization was actually computed.</summary>
+		public int FactorizationCount { get; private set; }
+
+		/// <summary>Performs application-defined tasks associated with freeing, releasing, or resetting unmanaged resources.</summary>
+		public void Dispose()
+		{
+			ReleaseHandle();
+			GC.SuppressFinalize(this);
+		}
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern IntPtr dense_create_qd(int size);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern int dense_factor_qd(IntPtr lu, qd_real* mat);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void dense_solve_factored_qd(IntPtr lu, qd_real* b);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void dense_free_qd(IntPtr lu);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void dense_chord_step_qd(IntPtr lu, qd_real* mat, qd_real* b, qd_real* x, qd_real* result);
+
+		/// <summary>
+		///   Factorizes the matrix unless it is the same as the last factored one. Returns true if the factorization was
+		///   recomputed.
+		/// </summary>
+		/// <param name="m">The matrix to be factored, it is not modified.</param>
+		/// <returns></returns>
+		public bool Factor(Matrix<qd_real> m)
+		{
+			if (handle == IntPtr.Zero) throw new ObjectDisposedException(nameof(QdDenseLuFactorization));
+			if (m.Size != Size) throw new ArgumentException("The matrix is of different size.");
+
+			bool factored;
+			fixed (qd_real* mat = m.RawData)
+			{
+				factored = dense_factor_qd(handle, mat) != 0;
+			}
+
+			if (factored) FactorizationCount++;
+			return factored;
+		}
+
+		/// <summary>Solves system of linear equations in the form A*x=b using the last computed factorization.</summary>
+		/// <param name="b">The right hand side vector b.</param>
+		/// <param name="x">The output array for solution x.</param>
+		public void Solve(qd_real[] b, qd_real[] x)
+		{
+			if (handle == IntPtr.Zero) throw new ObjectDisposedException(nameof(QdDenseLuFactorization));
+			if (FactorizationCount == 0) throw new InvalidOperationException("Matrix must be factored before solving.");
+
+			b.CopyTo(x, 0);
+			fixed (qd_real* rhs = x)
+			{
+				dense_solve_factored_qd(handle, rhs);
+			}
+		}
+
+		/// <summary>
+		///   Performs one step of the modified Newton (chord) iteration for the system m*x=b using the last computed
+		///   factorization instead of the factorization of m: result = x + LU^-1 * (b - m*x).
+		/// </summary>
+		/// <param name="m">The current matrix of the system.</param>
+		/// <param name="b">The current right hand side vector b.</param>
+		/// <param name="x">The previous iterate.</param>
+		/// <param name="result">The output array for the new iterate, may be the same array as x.</param>
+		public void ChordStep(Matrix<qd_real> m, qd_real[] b, qd_real[] x, qd_real[] result)
+		{
+			if (handle == IntPtr.Zero) throw new ObjectDisposedException(nameof(QdDenseLuFactorization));
+			if (FactorizationCount == 0) throw new InvalidOperationException("Matrix must be factored before solving.");
+			if (m.Size != Size || b.Length != Size || x.Length != Size || result.Length != Size)
+				throw new ArgumentException("The matrix or vectors are of different size.");
+
+			fixed (qd_real* mat = m.RawData)
+			fixed (qd_real* rhs = b)
+			fixed (qd_real* sol = x)
+			fixed (qd_real* res = result)
+			{
+				dense_chord_step_qd(handle, mat, rhs, sol, res);
+			}
+		}
+
+		private void ReleaseHandle()
+		{
+			if (handle == IntPtr.Zero) return;
+			dense_free_qd(handle);
+			handle = IntPtr.Zero;
+		}
+
+		~QdDenseLuFactorization()
+		{
+			ReleaseHandle();
+		}
+	}
+#endif
+}
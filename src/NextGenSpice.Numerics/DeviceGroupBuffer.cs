@@ -0,0 +1,88 @@
+using System;
+using System.Runtime.InteropServices;
+using System.Security;
+
+namespace NextGenSpice.Numerics
+{
+	/// <summary>
+	///   Natively allocated values of a group of devices of the same kind stored as struct of arrays, so that the
+	///   device models can be evaluated for the whole group in a single native call. Each field starts at 64-byte
+	///   boundary.
+	/// </summary>
+	public abstract unsafe class DeviceGroupBuffer : IDisposable
+	{
+		// each field starts at 64-byte boundary
+		private const int Alignment = 64 / sizeof(double);
+
+		private double* values;
+
+		/// <summary>Allocates buffer for given number of devices.</summary>
+		/// <param name="count">Number of devices in the group.</param>
+		/// <param name="fieldCount">Number of values per device.</param>
+		protected DeviceGroupBuffer(int count, int fieldCount)
+		{
+			if (count <= 0) throw new ArgumentOutOfRangeException(nameof(count));
+
+			Count = count;
+			Stride = (count + Alignment - 1) / Alignment * Alignment;
+			values = stamp_values_create(Stride * fieldCount);
+			if (values == null) throw new OutOfMemoryException();
+		}
+
+		/// <summary>Number of devices in the group.</summary>
+		public int Count { get; }
+
+		/// <summary>Distance between the same field of two adjacent devices.</summary>
+		public int Stride { get; }
+
+		/// <summary>Pointer to the first value of the buffer.</summary>
+		protected double* Values
+		{
+			get
+			{
+				if (values == null) throw new ObjectDisposedException(nameof(DeviceGroupBuffer));
+				return values;
+			}
+		}
+
+		/// <summary>Performs application-defined tasks associated with freeing, releasing, or resetting unmanaged resources.</summary>
+		public void Dispose()
+		{
+			ReleaseValues();
+			GC.SuppressFinalize(this);
+		}
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern double* stamp_values_create(int count);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void stamp_values_free(double* values);
+
+		/// <summary>Returns reference to the value of given field of the index-th device.</summary>
+		/// <param name="field">Index of the field.</param>
+		/// <param name="index">Index of the device.</param>
+		/// <returns></returns>
+		protected ref double Value(int field, int index)
+		{
+			if ((uint) index >= (uint) Count) throw new ArgumentOutOfRangeException(nameof(index));
+			return ref Values[field * Stride + index];
+		}
+
+		/// <summary>Evaluates the device models for all devices in the group.</summary>
+		public abstract void Evaluate();
+
+		private void ReleaseValues()
+		{
+			if (values == null) return;
+			stamp_values_free(values);
+			values = null;
+		}
+
+		~DeviceGroupBuffer()
+		{
+			ReleaseValues();
+		}
+	}
+}
@@ -0,0 +1,85 @@
+using System.Runtime.InteropServices;
+using System.Security;
+
+namespace NextGenSpice.Numerics
+{
+	/// <summary>Fields of the <see cref="DiodeGroupBuffer" />, the order must match the native diode_field.</summary>
+	public enum DiodeField
+	{
+		/// <summary>Saturation current parameter.</summary>
+		SaturationCurrent,
+
+		/// <summary>Thermal voltage multiplied by the emission coefficient.</summary>
+		ThermalVoltage,
+
+		/// <summary>Minimal conductance of the junction.</summary>
+		MinimalConductance,
+
+		/// <summary>Reverse breakdown voltage parameter.</summary>
+		ReverseBreakdownVoltage,
+
+		/// <summary>Transit time parameter.</summary>
+		TransitTime,
+
+		/// <summary>Zero-bias junction capacitance parameter.</summary>
+		JunctionCapacitance,
+
+		/// <summary>Junction potential parameter.</summary>
+		JunctionPotential,
+
+		/// <summary>Junction grading coefficient parameter.</summary>
+		JunctionGradingCoefficient,
+
+		/// <summary>Forward bias depletion capacitance coefficient parameter.</summary>
+		ForwardBiasDepletionCapacitanceCoefficient,
+
+		/// <summary>Input: voltage across the junction.</summary>
+		Voltage,
+
+		/// <summary>Output: current through the junction.</summary>
+		Current,
+
+		/// <summary>Output: equivalent conductance of the junction.</summary>
+		Conductance,
+
+		/// <summary>Output: capacitance of the junction.</summary>
+		Capacitance,
+
+		/// <summary>Intermediate value of the native evaluation.</summary>
+		ExpForward,
+
+		/// <summary>Intermediate value of the native evaluation.</summary>
+		ExpBreakdown,
+
+		/// <summary>Number of the fields.</summary>
+		Count
+	}
+
+	/// <summary>Values of a group of diodes whose current, conductance and capacitance are evaluated natively.</summary>
+	public unsafe class DiodeGroupBuffer : DeviceGroupBuffer
+	{
+		public DiodeGroupBuffer(int count) : base(count, (int) DiodeField.Count)
+		{
+		}
+
+		/// <summary>Gets or sets value of given field of the index-th diode.</summary>
+		/// <param name="field">The field.</param>
+		/// <param name="index">Index of the diode.</param>
+		/// <returns></returns>
+		public double this[DiodeField field, int index]
+		{
+			get => Value((int) field, index);
+			set => Value((int) field, index) = value;
+		}
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void diode_group_evaluate(double* values, int stride, int count);
+
+		/// <summary>Evaluates the outputs of all diodes from their parameters and voltages.</summary>
+		public override void Evaluate()
+		{
+			diode_group_evaluate(Values, Stride, Count);
+		}
+	}
+}
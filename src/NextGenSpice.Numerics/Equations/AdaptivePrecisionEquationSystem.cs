@@ -0,0 +1,147 @@
+using System;
+using NextGenSpice.Numerics.Precision;
+
+namespace NextGenSpice.Numerics.Equations
+{
+	/// <summary>Precision in which the <see cref="AdaptivePrecisionEquationSystem" /> was solved.</summary>
+	public enum SolvePrecision
+	{
+		Double = 0,
+		DoubleDouble = 1,
+		QuadDouble = 2
+	}
+
+#if dd_precision && qd_precision
+	/// <summary>
+	///   Equation system with dd_real precision coefficients which is solved in double precision first. The solve is
+	///   repeated in higher precision only if the estimated condition number of the matrix or the residual of the
+	///   double precision solution is too large.
+	/// </summary>
+	public class AdaptivePrecisionEquationSystem : IEquationSystem, IDisposable
+	{
+		private readonly Matrix<double> doubleMatrix;
+		private readonly double[] doubleRhs;
+		private readonly double[] doubleSolution;
+		private readonly DenseLuFactorization factorization;
+
+		private DdDenseLuFactorization ddFactorization;
+		private QdDenseLuFactorization qdFactorization;
+		private qd_real[] qdRhs;
+		private qd_real[] qdSolution;
+		private Matrix<qd_real> qdMatrix;
+
+		public AdaptivePrecisionEquationSystem(int size)
+		{
+			Matrix = new Matrix<dd_real>(size);
+			Solution = new dd_real[size];
+			RightHandSide = new dd_real[size];
+
+			doubleMatrix = new Matrix<double>(size);
+			doubleRhs = new double[size];
+			doubleSolution = new double[size];
+			factorization = new DenseLuFactorization(size);
+		}
+
+		/// <summary>Largest condition number estimate for which the double precision solution is accepted.</summary>
+		public double DdConditionThreshold { get; set; } = 1e12;
+
+		/// <summary>Largest condition number estimate for which the double-double precision solution is accepted.</summary>
+		public double QdConditionThreshold { get; set; } = 1e24;
+
+		/// <summary>Largest normwise backward error for which the double precision solution is accepted.</summary>
+		public double ResidualThreshold { get; set; } = 1e-12;
+
+		/// <summary>Precision used by the last call to Solve().</summary>
+		public SolvePrecision LastPrecision { get; private set; }
+
+		/// <summary>Condition number estimate of the matrix from the last call to Solve().</summary>
+		public double LastConditionEstimate { get; private set; }
+
+		/// <summary>Backward error of the double precision solution from the last call to Solve().</summary>
+		public double LastBackwardError { get; private set; }
+
+		/// <summary>Result of the latest call to the Solve() method.</summary>
+		public dd_real[] Solution { get; }
+
+		/// <summary>Matrix part of the equation system.</summary>
+		public Matrix<dd_real> Matrix { get; }
+
+		/// <summary>Right hand side vector of the equation system.</summary>
+		public dd_real[] RightHandSide { get; }
+
+		/// <summary>Count of the variables in the equation.</summary>
+		public int VariablesCount => Solution.Length;
+
+		/// <summary>Performs application-defined tasks associated with freeing, releasing, or resetting unmanaged resources.</summary>
+		public void Dispose()
+		{
+			factorization.Dispose();
+			ddFactorization?.Dispose();
+			qdFactorization?.Dispose();
+		}
+
+		/// <summary>Returns solution for the given variable.</summary>
+		/// <param name="variable">Index of the variable in the equation system.</param>
+		/// <returns></returns>
+		public double GetSolution(int variable)
+		{
+			return Solution[variable].x0;
+		}
+
+		/// <summary>Solves the linear equation system, the matrix is not modified. If the system has no solution, the result is undefined.</summary>
+		public void Solve()
+		{
+			var raw = Matrix.RawData;
+			var doubleRaw = doubleMatrix.RawData;
+			for (var i = 0; i < raw.Length; i++) doubleRaw[i] = raw[i].x0;
+			for (var i = 0; i < doubleRhs.Length; i++) doubleRhs[i] = RightHandSide[i].x0;
+
+			factorization.Factor(doubleMatrix);
+			factorization.Solve(doubleRhs, doubleSolution);
+			LastConditionEstimate = factorization.EstimateConditionNumber();
+			LastBackwardError = factorization.BackwardError(doubleRhs, doubleSolution);
+
+			// NaN backward error fails the comparison as well
+			if (LastConditionEstimate <= DdConditionThreshold && LastBackwardError <= ResidualThreshold)
+			{
+				LastPrecision = SolvePrecision.Double;
+				for (var i = 0; i < Solution.Length; i++) Solution[i] = new dd_real(doubleSolution[i]);
+			}
+			else if (LastConditionEstimate <= QdConditionThreshold)
+			{
+				LastPrecision = SolvePrecision.DoubleDouble;
+				if (ddFactorization == null) ddFactorization = new DdDenseLuFactorization(VariablesCount);
+				ddFactorization.Factor(Matrix);
+				ddFactorization.Solve(RightHandSide, Solution);
+			}
+			else
+			{
+				LastPrecision = SolvePrecision.QuadDouble;
+				SolveQd();
+			}
+		}
+
+		private void SolveQd()
+		{
+			if (qdFactorization == null)
+			{
+				qdFactorization = new QdDenseLuFactorization(VariablesCount);
+				qdMatrix = new Matrix<qd_real>(VariablesCount);
+				qdRhs = new qd_real[VariablesCount];
+				qdSolution = new qd_real[VariablesCount];
+			}
+
+			var raw = Matrix.RawData;
+			var qdRaw = qdMatrix.RawData;
+			for (var i = 0; i < raw.Length; i++) qdRaw[i] = raw[i];
+			for (var i = 0; i < qdRhs.Length; i++) qdRhs[i] = RightHandSide[i];
+
+			qdFactorization.Factor(qdMatrix);
+			qdFactorization.Solve(qdRhs, qdSolution);
+
+			for (var i = 0; i < Solution.Length; i++)
+				Solution[i] = new dd_real(qdSolution[i].x0, qdSolution[i].x1);
+		}
+	}
+#endif
+}
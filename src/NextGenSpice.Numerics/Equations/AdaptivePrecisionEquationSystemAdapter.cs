@@ -0,0 +1,246 @@
+﻿using System;
+using System.Collections.Generic;
+
+namespace NextGenSpice.Numerics.Equations
+{
+#if dd_precision && qd_precision
+	/// <summary>
+	///   Class providing equation system proxy objects for individual equation coefficients in double-double precision.
+	///   Each solve is performed in double precision and escalated to double-double or quad-double precision only when
+	///   the condition number estimate or the residual of the double precision solution exceeds given thresholds.
+	/// </summary>
+	public class AdaptivePrecisionEquationSystemAdapter : IReusableFactorizationAdapter, ISolutionSeedingAdapter,
+		IDisposable
+	{
+		private readonly Dictionary<(int, int), MatrixProxy> matrixProxies;
+		private readonly Dictionary<int, RhsProxy> rhsProxies;
+		private readonly Dictionary<int, SolutionProxy> solutionProxies;
+
+		private AdaptivePrecisionEquationSystem system;
+
+		public AdaptivePrecisionEquationSystemAdapter()
+		{
+			matrixProxies = new Dictionary<(int, int), MatrixProxy>();
+			rhsProxies = new Dictionary<int, RhsProxy>();
+			solutionProxies = new Dictionary<int, SolutionProxy>();
+		}
+
+		/// <summary>Largest condition number estimate for which the double precision solution is accepted.</summary>
+		public double DdConditionThreshold { get; set; } = 1e12;
+
+		/// <summary>Largest condition number estimate for which the double-double precision solution is accepted.</summary>
+		public double QdConditionThreshold { get; set; } = 1e24;
+
+		/// <summary>Largest normwise backward error for which the double precision solution is accepted.</summary>
+		public double ResidualThreshold { get; set; } = 1e-12;
+
+		/// <summary>Number of solves which were finished in double precision.</summary>
+		public int DoubleSolveCount { get; private set; }
+
+		/// <summary>Number of solves which were escalated to double-double precision.</summary>
+		public int DdSolveCount { get; private set; }
+
+		/// <summary>Number of solves which were escalated to quad-double precision.</summary>
+		public int QdSolveCount { get; private set; }
+
+		/// <summary>Condition number estimate of the matrix from the last solve.</summary>
+		public double LastConditionEstimate => system?.LastConditionEstimate ?? 0;
+
+		/// <summary>Number of variables in the equation system;</summary>
+		public int VariableCount { get; private set; }
+
+		/// <summary>Performs application-defined tasks associated with freeing, releasing, or resetting unmanaged resources.</summary>
+		public void Dispose()
+		{
+			system?.Dispose();
+		}
+
+		/// <summary>
+		///   Has no effect on this adapter. The double precision factors are recomputed only when the rounded matrix
+		///   changes, and the double-double and quad-double factors only when a solve is escalated with a changed matrix.
+		/// </summary>
+		public bool ReuseFactorization { get; set; }
+
+		/// <summary>Adds a new variable to the equation system and returns the index of the variable;</summary>
+		/// <returns></returns>
+		public int AddVariable()
+		{
+			return VariableCount++;
+		}
+
+		/// <summary>Returns proxy class for coefficient at given coordinates in the equation matrix.</summary>
+		/// <param name="row">Row coordinate.</param>
+		/// <param name="column">Column coordinate.</param>
+		/// <returns></returns>
+		public IEquationSystemCoefficientProxy GetMatrixCoefficientProxy(int row, int column)
+		{
+			if (row < 0 || row >= VariableCount) throw new ArgumentOutOfRangeException(nameof(row));
+			if (column < 0 || column >= VariableCount) throw new ArgumentOutOfRangeException(nameof(column));
+			if (system != null) throw new InvalidOperationException("Equation system already frozen.");
+
+			if (!matrixProxies.TryGetValue((row, column), out var proxy))
+				proxy = matrixProxies[(row, column)] = new MatrixProxy(row, column);
+			return proxy;
+		}
+
+		/// <summary>Returns proxy class for coefficient at given row in the right hand side vector.</summary>
+		/// <param name="row">Row coordinate.</param>
+		/// <returns></returns>
+		public IEquationSystemCoefficientProxy GetRightHandSideCoefficientProxy(int row)
+		{
+			if (row < 0 || row >= VariableCount) throw new ArgumentOutOfRangeException(nameof(row));
+			if (system != null) throw new InvalidOperationException("Equation system already frozen.");
+
+			if (!rhsProxies.TryGetValue(row, out var proxy))
+				proxy = rhsProxies[row] = new RhsProxy(row);
+			return proxy;
+		}
+
+		/// <summary>Returns proxy class for the i-th variable of the solution.</summary>
+		/// <param name="index"></param>
+		/// <returns></returns>
+		public IEquationSystemSolutionProxy GetSolutionProxy(int index)
+		{
+			if (index < 0 || index >= VariableCount) throw new ArgumentOutOfRangeException(nameof(index));
+			if (system != null) throw new InvalidOperationException("Equation system already frozen.");
+
+			if (!solutionProxies.TryGetValue(index, out var proxy))
+				proxy = solutionProxies[index] = new SolutionProxy(index);
+			return proxy;
+		}
+
+		/// <summary>Freezes the representation of the equation matrix.</summary>
+		public void Freeze()
+		{
+			if (system != null) throw new InvalidOperationException("Equation system already frozen.");
+
+			system = new AdaptivePrecisionEquationSystem(VariableCount);
+			// set system to all proxies
+			foreach (var proxy in matrixProxies.Values)
+				proxy.system = system;
+			foreach (var proxy in rhsProxies.Values)
+				proxy.system = system;
+			foreach (var proxy in solutionProxies.Values)
+				proxy.system = system;
+		}
+
+		/// <summary>Solves the equation matrix and stores the result in the provided array.</summary>
+		/// <param name="target"></param>
+		public void Solve(double[] target)
+		{
+			if (system == null) throw new InvalidOperationException("Equation system must be frozen before accessing.");
+			if (target.Length != VariableCount) throw new ArgumentException("The target array is of different size.");
+			system.DdConditionThreshold = DdConditionThreshold;
+			system.QdConditionThreshold = QdConditionThreshold;
+			system.ResidualThreshold = ResidualThreshold;
+			system.Solve();
+
+			switch (system.LastPrecision)
+			{
+				case SolvePrecision.Double:
+					DoubleSolveCount++;
+					break;
+				case SolvePrecision.DoubleDouble:
+					DdSolveCount++;
+					break;
+				case SolvePrecision.QuadDouble:
+					QdSolveCount++;
+					break;
+			}
+
+			for (var i = 0; i < target.Length; i++) target[i] = (double) system.Solution[i];
+		}
+
+		/// <summary>
+		///   Sets the values read by the solution proxies, e.g. to an estimate of the solution before the equation system
+		///   is solved.
+		/// </summary>
+		/// <param name="source"></param>
+		public void SetSolution(double[] source)
+		{
+			if (system == null) throw new InvalidOperationException("Equation system must be frozen before accessing.");
+			if (source.Length != VariableCount) throw new ArgumentException("The source array is of different size.");
+
+			for (var i = 0; i < source.Length; i++) system.Solution[i] = source[i];
+		}
+
+		/// <summary>Enforces value 0 of a particular eqation system variable.</summary>
+		/// <param name="index"></param>
+		public void Anullate(int index)
+		{
+			var m = system.Matrix;
+
+			for (var i = 0; i < m.Size; i++)
+			{
+				m[i, index] = 0;
+				m[index, i] = 0;
+			}
+
+			m[index, index] = 1;
+			system.RightHandSide[index] = 0;
+		}
+
+		public void Clear()
+		{
+			for (var i = 0; i < system.Matrix.RawData.Length; ++i) system.Matrix.RawData[i] = 0;
+
+			for (var i = 0; i < system.RightHandSide.Length; ++i) system.RightHandSide[i] = 0;
+		}
+
+		private class MatrixProxy : IEquationSystemCoefficientProxy
+		{
+			private readonly int col;
+			private readonly int row;
+
+			public AdaptivePrecisionEquationSystem system;
+
+			public MatrixProxy(int row, int col)
+			{
+				this.row = row;
+				this.col = col;
+			}
+
+			public void Add(double value)
+			{
+				if (double.IsNaN(value)) throw new ArgumentNaNException("Cannot insert NaN");
+				system.Matrix[row, col] += value;
+			}
+		}
+
+		private class RhsProxy : IEquationSystemCoefficientProxy
+		{
+			private readonly int row;
+
+			public AdaptivePrecisionEquationSystem system;
+
+			public RhsProxy(int row)
+			{
+				this.row = row;
+			}
+
+			public void Add(double value)
+			{
+				if (double.IsNaN(value)) throw new ArgumentNaNException("Cannot insert NaN");
+				system.RightHandSide[row] += value;
+			}
+		}
+
+		private class SolutionProxy : IEquationSystemSolutionProxy
+		{
+			private readonly int row;
+
+			public AdaptivePrecisionEquationSystem system;
+
+			public SolutionProxy(int row)
+			{
+				this.row = row;
+			}
+
+			public double GetValue()
+			{
+				return (double) system.Solution[row];
+			}
+		}
+	}
+#endif
+}
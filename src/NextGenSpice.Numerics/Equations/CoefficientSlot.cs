@@ -0,0 +1,41 @@
+namespace NextGenSpice.Numerics.Equations
+{
+	/// <summary>
+	///   Coefficient of the equation system which can be modified without virtual dispatch. Slots bound by
+	///   <see cref="StampMap" /> add directly to the native value array, other proxies are only wrapped.
+	/// </summary>
+	public sealed unsafe class CoefficientSlot : IEquationSystemCoefficientProxy
+	{
+		private readonly IEquationSystemCoefficientProxy proxy;
+
+		// set by StampMap when the equation system is frozen
+		internal double* target;
+
+		internal CoefficientSlot()
+		{
+		}
+
+		private CoefficientSlot(IEquationSystemCoefficientProxy proxy)
+		{
+			this.proxy = proxy;
+		}
+
+		/// <summary>Adds a specified value to the target coefficient.</summary>
+		/// <param name="value"></param>
+		public void Add(double value)
+		{
+			if (target != null)
+				*target += value;
+			else
+				proxy.Add(value);
+		}
+
+		/// <summary>Returns the proxy itself if it is a slot, otherwise wraps it in a new slot.</summary>
+		/// <param name="proxy">The proxy to be wrapped.</param>
+		/// <returns></returns>
+		public static CoefficientSlot From(IEquationSystemCoefficientProxy proxy)
+		{
+			return proxy as CoefficientSlot ?? new CoefficientSlot(proxy);
+		}
+	}
+}
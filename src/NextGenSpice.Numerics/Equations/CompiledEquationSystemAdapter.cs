@@ -0,0 +1,259 @@
+using System;
+using System.Collections.Generic;
+using System.Linq;
+
+namespace NextGenSpice.Numerics.Equations
+{
+	/// <summary>
+	///   Class providing equation system coefficient slots which are bound at <see cref="Freeze" /> to fixed positions in
+	///   a natively allocated value array. The devices add directly to the array and the sparse LU factorization reads
+	///   the matrix values in place.
+	/// </summary>
+	public unsafe class CompiledEquationSystemAdapter : IReusableFactorizationAdapter, ISolutionSeedingAdapter,
+		IDisposable
+	{
+		private readonly Dictionary<(int, int), CoefficientSlot> matrixSlots;
+		private readonly Dictionary<int, CoefficientSlot> rhsSlots;
+		private readonly Dictionary<int, SolutionProxy> solutionProxies;
+
+		// copy of the matrix values at the time of the last successful factorization
+		private double[] factoredValues;
+
+		// indices of the values which differ from factoredValues
+		private int[] changedSlots;
+		private SparseLuFactorization factorization;
+		private double[] solution;
+		private StampMap stampMap;
+
+		// indices into matrix values of the diagonal entries and entries in given row
+		private int[] diagonalSlots;
+		private int[][] rowSlots;
+		private int[] columnPointers;
+
+		public CompiledEquationSystemAdapter(SparseOrdering ordering = SparseOrdering.MinimumDegree)
+		{
+			Ordering = ordering;
+			matrixSlots = new Dictionary<(int, int), CoefficientSlot>();
+			rhsSlots = new Dictionary<int, CoefficientSlot>();
+			solutionProxies = new Dictionary<int, SolutionProxy>();
+		}
+
+		/// <summary>Column ordering used for the factorization of the equation matrix.</summary>
+		public SparseOrdering Ordering { get; }
+
+		/// <summary>The value array, available after the adapter is frozen.</summary>
+		public StampMap StampMap => stampMap;
+
+		/// <summary>Performs application-defined tasks associated with freeing, releasing, or resetting unmanaged resources.</summary>
+		public void Dispose()
+		{
+			factorization?.Dispose();
+			stampMap?.Dispose();
+		}
+
+		/// <summary>Number of variables in the equation system;</summary>
+		public int VariableCount { get; private set; }
+
+		/// <summary>
+		///   If true, the LU factorization of the equation matrix is kept between calls to <see cref="Solve" /> and
+		///   recomputed only when the matrix changes, only forward and backward substitution is performed otherwise.
+		/// </summary>
+		public bool ReuseFactorization { get; set; }
+
+		/// <summary>
+		///   If true, the matrix values are compared with the ones of the last factorization and only the columns of the
+		///   factors which depend on the changed values are recomputed.
+		/// </summary>
+		public bool PartialRefactorization { get; set; }
+
+		/// <summary>Total number of columns of the LU factors computed by all factorizations.</summary>
+		public long ComputedColumnCount => factorization?.ComputedColumnCount ?? 0;
+
+		/// <summary>Total number of columns of the LU factors kept from the previous factorization.</summary>
+		public long ReusedColumnCount => factorization?.ReusedColumnCount ?? 0;
+
+		/// <summary>Adds a new variable to the equation system and returns the index of the variable;</summary>
+		/// <returns></returns>
+		public int AddVariable()
+		{
+			return VariableCount++;
+		}
+
+		/// <summary>Returns proxy class for coefficient at given coordinates in the equation matrix.</summary>
+		/// <param name="row">Row coordinate.</param>
+		/// <param name="column">Column coordinate.</param>
+		/// <returns></returns>
+		public IEquationSystemCoefficientProxy GetMatrixCoefficientProxy(int row, int column)
+		{
+			if (row < 0 || row >= VariableCount) throw new ArgumentOutOfRangeException(nameof(row));
+			if (column < 0 || column >= VariableCount) throw new ArgumentOutOfRangeException(nameof(column));
+			if (stampMap != null) throw new InvalidOperationException("Equation system already frozen.");
+
+			if (!matrixSlots.TryGetValue((row, column), out var slot))
+				slot = matrixSlots[(row, column)] = new CoefficientSlot();
+			return slot;
+		}
+
+		/// <summary>Returns proxy class for coefficient at given row in the right hand side vector.</summary>
+		/// <param name="row">Row coordinate.</param>
+		/// <returns></returns>
+		public IEquationSystemCoefficientProxy GetRightHandSideCoefficientProxy(int row)
+		{
+			if (row < 0 || row >= VariableCount) throw new ArgumentOutOfRangeException(nameof(row));
+			if (stampMap != null) throw new InvalidOperationException("Equation system already frozen.");
+
+			if (!rhsSlots.TryGetValue(row, out var slot))
+				slot = rhsSlots[row] = new CoefficientSlot();
+			return slot;
+		}
+
+		/// <summary>Returns proxy class for the i-th variable of the solution.</summary>
+		/// <param name="index"></param>
+		/// <returns></returns>
+		public IEquationSystemSolutionProxy GetSolutionProxy(int index)
+		{
+			if (index < 0 || index >= VariableCount) throw new ArgumentOutOfRangeException(nameof(index));
+			if (stampMap != null) throw new InvalidOperationException("Equation system already frozen.");
+
+			if (!solutionProxies.TryGetValue(index, out var proxy))
+				proxy = solutionProxies[index] = new SolutionProxy(index);
+			return proxy;
+		}
+
+		/// <summary>Freezes the representation of the equation matrix.</summary>
+		public void Freeze()
+		{
+			if (stampMap != null) throw new InvalidOperationException("Equation system already frozen.");
+
+			// diagonal is always part of the pattern so that the variables can be anullated
+			var entries = matrixSlots.Keys.Concat(Enumerable.Range(0, VariableCount).Select(i => (i, i)));
+			var pattern = SparseMatrix<double>.FromCoordinates(VariableCount, entries);
+			stampMap = new StampMap(pattern);
+			factorization = new SparseLuFactorization(pattern, Ordering);
+			factoredValues = new double[pattern.NonzeroCount];
+			changedSlots = new int[pattern.NonzeroCount];
+			solution = new double[VariableCount];
+			columnPointers = pattern.ColumnPointers;
+
+			diagonalSlots = new int[VariableCount];
+			var rows = Enumerable.Range(0, VariableCount).Select(_ => new List<int>()).ToArray();
+			for (var col = 0; col < VariableCount; col++)
+			for (var p = pattern.ColumnPointers[col]; p < pattern.ColumnPointers[col + 1]; p++)
+			{
+				var row = pattern.RowIndices[p];
+				rows[row].Add(p);
+				if (row == col) diagonalSlots[col] = p;
+			}
+
+			rowSlots = rows.Select(r => r.ToArray()).ToArray();
+
+			// bind all slots to the value array
+			foreach (var pair in matrixSlots)
+				stampMap.BindMatrixSlot(pair.Value, pair.Key.Item1, pair.Key.Item2);
+			foreach (var pair in rhsSlots)
+				stampMap.BindRightHandSideSlot(pair.Value, pair.Key);
+			foreach (var proxy in solutionProxies.Values)
+				proxy.solution = solution;
+		}
+
+		/// <summary>
+		///   Solves the equation matrix and stores the result in the provided array. If the system has no solution or
+		///   contains NaN, the solution is filled with NaN.
+		/// </summary>
+		/// <param name="target"></param>
+		public void Solve(double[] target)
+		{
+			if (stampMap == null) throw new InvalidOperationException("Equation system must be frozen before accessing.");
+			if (target.Length != VariableCount) throw new ArgumentException("The target array is of different size.");
+
+			var values = new Span<double>(stampMap.MatrixValues, stampMap.NonzeroCount);
+			if (!stampMap.AllFinite() || !Factor(values))
+			{
+				for (var i = 0; i < solution.Length; i++) solution[i] = double.NaN;
+			}
+			else
+			{
+				new Span<double>(stampMap.RightHandSide, VariableCount).CopyTo(solution);
+				factorization.SolveInPlace(solution);
+			}
+
+			solution.CopyTo(target, 0);
+		}
+
+		/// <summary>
+		///   Sets the values read by the solution proxies, e.g. to an estimate of the solution before the equation system
+		///   is solved.
+		/// </summary>
+		/// <param name="source"></param>
+		public void SetSolution(double[] source)
+		{
+			if (stampMap == null) throw new InvalidOperationException("Equation system must be frozen before accessing.");
+			if (source.Length != VariableCount) throw new ArgumentException("The source array is of different size.");
+
+			source.CopyTo(solution, 0);
+		}
+
+		private bool Factor(Span<double> values)
+		{
+			if (PartialRefactorization && factorization.IsFactored)
+			{
+				var count = 0;
+				for (var i = 0; i < values.Length; i++)
+					if (values[i] != factoredValues[i])
+						changedSlots[count++] = i;
+
+				if (count == 0) return true;
+
+				fixed (int* changed = changedSlots)
+				{
+					if (!factorization.Factor(stampMap.MatrixValues, changed, count)) return false;
+				}
+			}
+			else
+			{
+				if (ReuseFactorization && factorization.IsFactored && values.SequenceEqual(factoredValues)) return true;
+				if (!factorization.Factor(stampMap.MatrixValues)) return false;
+			}
+
+			values.CopyTo(factoredValues);
+			return true;
+		}
+
+		/// <summary>Enforces value 0 of a particular eqation system variable.</summary>
+		/// <param name="index"></param>
+		public void Anullate(int index)
+		{
+			var values = stampMap.MatrixValues;
+
+			for (var p = columnPointers[index]; p < columnPointers[index + 1]; p++)
+				values[p] = 0;
+			foreach (var p in rowSlots[index])
+				values[p] = 0;
+
+			values[diagonalSlots[index]] = 1;
+			stampMap.RightHandSide[index] = 0;
+		}
+
+		public void Clear()
+		{
+			stampMap.Clear();
+		}
+
+		private class SolutionProxy : IEquationSystemSolutionProxy
+		{
+			private readonly int row;
+
+			public double[] solution;
+
+			public SolutionProxy(int row)
+			{
+				this.row = row;
+			}
+
+			public double GetValue()
+			{
+				return solution[row];
+			}
+		}
+	}
+}
@@ -1,10 +1,14 @@
-﻿using NextGenSpice.Numerics.Precision;
+﻿using System;
+using NextGenSpice.Numerics.Precision;
 
 namespace NextGenSpice.Numerics.Equations
 {
 	/// <summary>Simple equation system with double precision coefficient.</summary>
-	public class EquationSystem : IEquationSystem
+	public class EquationSystem : IEquationSystem, IDisposable
 	{
+		private DenseLuFactorization factorization;
+		private ParallelLuFactorization parallelFactorization;
+
 		public EquationSystem(int size)
 		{
 			// init backup space
@@ -25,6 +29,13 @@ namespace NextGenSpice.Numerics.Equations
 		/// <summary>Count of the variables in the equation.</summary>
 		public int VariablesCount => Solution.Length;
 
+		/// <summary>Performs application-defined tasks associated with freeing, releasing, or resetting unmanaged resources.</summary>
+		public void Dispose()
+		{
+			factorization?.Dispose();
+			parallelFactorization?.Dispose();
+		}
+
 		/// <summary>Returns solution for the given variable.</summary>
 		/// <param name="variable">Index of the variable in the equation system.</param>
 		/// <returns></returns>
@@ -36,14 +47,84 @@ namespace NextGenSpice.Numerics.Equations
 		/// <summary>Solves the linear equation system. If the system has no solution, the result is undefined.</summary>
 		public void Solve()
 		{
-			GaussJordanElimination.Solve(Matrix, RightHandSide, Solution);
+			Solve(Solution);
+		}
+
+		/// <summary>Solves the linear equation system into given array instead of <see cref="Solution" />.</summary>
+		/// <param name="solution">The output array for the solution.</param>
+		public void Solve(double[] solution)
+		{
+			GaussJordanElimination.Solve(Matrix, RightHandSide, solution);
+		}
+
+		/// <summary>
+		///   Solves the linear equation system using LU factorization, which is reused if the matrix did not change since
+		///   the last call. Unlike <see cref="Solve" />, the matrix is not modified.
+		/// </summary>
+		public void SolveFactored()
+		{
+			SolveFactored(Solution);
+		}
+
+		/// <summary>Solves the linear equation system like <see cref="SolveFactored()" />, but into given array.</summary>
+		/// <param name="solution">The output array for the solution.</param>
+		public void SolveFactored(double[] solution)
+		{
+			if (factorization == null) factorization = new DenseLuFactorization(VariablesCount);
+			factorization.Factor(Matrix);
+			factorization.Solve(RightHandSide, solution);
+		}
+
+		/// <summary>Whether LU factors from some previous call to <see cref="SolveFactored()" /> are available.</summary>
+		public bool HasFactors => factorization != null && factorization.FactorizationCount > 0;
+
+		/// <summary>
+		///   Computes the next iterate of the modified Newton (chord) method using the LU factors of the matrix from the
+		///   last call to <see cref="SolveFactored()" /> instead of factoring the current matrix.
+		/// </summary>
+		/// <param name="previous">The previous iterate.</param>
+		/// <param name="solution">The output array for the new iterate, may be the same array as previous.</param>
+		public void SolveChord(double[] previous, double[] solution)
+		{
+			if (!HasFactors) throw new InvalidOperationException("The system must be solved by SolveFactored() first.");
+			factorization.ChordStep(Matrix, RightHandSide, previous, solution);
+		}
+
+		/// <summary>
+		///   Solves the linear equation system using LU factorization computed by multiple threads. The factorization is
+		///   reused if the matrix did not change since the last call and the matrix is not modified.
+		/// </summary>
+		/// <param name="threadCount">Number of threads used for the factorization, 0 means number of hardware threads.</param>
+		/// <param name="serialCutoff">Systems with fewer variables are factored by the calling thread only.</param>
+		public void SolveParallel(int threadCount, int serialCutoff)
+		{
+			SolveParallel(threadCount, serialCutoff, Solution);
+		}
+
+		/// <summary>Solves the linear equation system like <see cref="SolveParallel(int, int)" />, but into given array.</summary>
+		/// <param name="threadCount">Number of threads used for the factorization, 0 means number of hardware threads.</param>
+		/// <param name="serialCutoff">Systems with fewer variables are factored by the calling thread only.</param>
+		/// <param name="solution">The output array for the solution.</param>
+		public void SolveParallel(int threadCount, int serialCutoff, double[] solution)
+		{
+			if (parallelFactorization == null || parallelFactorization.SerialCutoff != serialCutoff ||
+			    threadCount != 0 && parallelFactorization.ThreadCount != threadCount)
+			{
+				parallelFactorization?.Dispose();
+				parallelFactorization = new ParallelLuFactorization(VariablesCount, threadCount, serialCutoff);
+			}
+
+			parallelFactorization.Factor(Matrix);
+			parallelFactorization.Solve(RightHandSide, solution);
 		}
 	}
 
 #if dd_precision
 	/// <summary>Simple equation system with dd_real precision coefficient.</summary>
-	public class DdEquationSystem : IEquationSystem
+	public class DdEquationSystem : IEquationSystem, IDisposable
 	{
+		private DdDenseLuFactorization factorization;
+
 		public DdEquationSystem(int size)
 		{
 			// init backup space
@@ -64,6 +145,12 @@ namespace NextGenSpice.Numerics.Equations
 		/// <summary>Count of the variables in the equation.</summary>
 		public int VariablesCount => Solution.Length;
 
+		/// <summary>Performs application-defined tasks associated with freeing, releasing, or resetting unmanaged resources.</summary>
+		public void Dispose()
+		{
+			factorization?.Dispose();
+		}
+
 		/// <summary>Returns solution for the given variable.</summary>
 		/// <param name="variable">Index of the variable in the equation system.</param>
 		/// <returns></returns>
@@ -77,13 +164,39 @@ namespace NextGenSpice.Numerics.Equations
 		{
 			GaussJordanElimination.Solve(Matrix, RightHandSide, Solution);
 		}
+
+		/// <summary>
+		///   Solves the linear equation system using LU factorization, which is reused if the matrix did not change since
+		///   the last call. Unlike <see cref="Solve" />, the matrix is not modified.
+		/// </summary>
+		public void SolveFactored()
+		{
+			if (factorization == null) factorization = new DdDenseLuFactorization(VariablesCount);
+			factorization.Factor(Matrix);
+			factorization.Solve(RightHandSide, Solution);
+		}
+
+		/// <summary>Whether LU factors from some previous call to <see cref="SolveFactored" /> are available.</summary>
+		public bool HasFactors => factorization != null && factorization.FactorizationCount > 0;
+
+		/// <summary>
+		///   Replaces <see cref="Solution" /> by the next iterate of the modified Newton (chord) method using the LU factors
+		///   of the matrix from the last call to <see cref="SolveFactored" /> instead of factoring the current matrix.
+		/// </summary>
+		public void SolveChord()
+		{
+			if (!HasFactors) throw new InvalidOperationException("The system must be solved by SolveFactored() first.");
+			factorization.ChordStep(Matrix, RightHandSide, Solution, Solution);
+		}
 	}
 #endif
 
 #if qd_precision
 	/// <summary>Simple equation system with qd_real precision coefficient.</summary>
-	public class QdEquationSystem : IEquationSystem
+	public class QdEquationSystem : IEquationSystem, IDisposable
 	{
+		private QdDenseLuFactorization factorization;
+
 		public QdEquationSystem(int size)
 		{
 			// init backup space
@@ -104,6 +217,12 @@ namespace NextGenSpice.Numerics.Equations
 		/// <summary>Count of the variables in the equation.</summary>
 		public int VariablesCount => Solution.Length;
 
+		/// <summary>Performs application-defined tasks associated with freeing, releasing, or resetting unmanaged resources.</summary>
+		public void Dispose()
+		{
+			factorization?.Dispose();
+		}
+
 		/// <summary>Returns solution for the given variable.</summary>
 		/// <param name="variable">Index of the variable in the equation system.</param>
 		/// <returns></returns>
@@ -117,6 +236,30 @@ namespace NextGenSpice.Numerics.Equations
 		{
 			GaussJordanElimination.Solve(Matrix, RightHandSide, Solution);
 		}
+
+		/// <summary>
+		///   Solves the linear equation system using LU factorization, which is reused if the matrix did not change since
+		///   the last call. Unlike <see cref="Solve" />, the matrix is not modified.
+		/// </summary>
+		public void SolveFactored()
+		{
+			if (factorization == null) factorization = new QdDenseLuFactorization(VariablesCount);
+			factorization.Factor(Matrix);
+			factorization.Solve(RightHandSide, Solution);
+		}
+
+		/// <summary>Whether LU factors from some previous call to <see cref="SolveFactored" /> are available.</summary>
+		public bool HasFactors => factorization != null && factorization.FactorizationCount > 0;
+
+		/// <summary>
+		///   Replaces <see cref="Solution" /> by the next iterate of the modified Newton (chord) method using the LU factors
+		///   of the matrix from the last call to <see cref="SolveFactored" /> instead of factoring the current matrix.
+		/// </summary>
+		public void SolveChord()
+		{
+			if (!HasFactors) throw new InvalidOperationException("The system must be solved by SolveFactored() first.");
+			factorization.ChordStep(Matrix, RightHandSide, Solution, Solution);
+		}
 	}
 #endif
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 using System;
 using System.Collections.Generic;
+using System.Linq;
 
 namespace NextGenSpice.Numerics.Equations
 {
@@ -61,7 +62,8 @@ namespace NextGenSpice.Numerics.Equations
 	}
 
 	/// <summary>Class providing equation system proxy objects for individual equation coefficients in double precision</summary>
-	public class EquationSystemAdapter : IEquationSystemAdapterWide
+	public class EquationSystemAdapter : IModifiedNewtonEquationSystemAdapter, IReusableFactorizationAdapter,
+		ISolutionSeedingAdapter, IDisposable
 	{
 		private readonly Dictionary<(int, int), MatrixProxy> matrixProxies;
 		private readonly Dictionary<int, RhsProxy> rhsProxies;
@@ -69,6 +71,13 @@ namespace NextGenSpice.Numerics.Equations
 
 		private EquationSystem system;
 
+		// array passed to the last Solve() call, which is read by the solution proxies
+		private double[] solution;
+
+		// positions of the coefficients reset by Clear() when SparseAssembly is used
+		private int[] assembledEntries;
+		private int[] assembledRows;
+
 		public EquationSystemAdapter()
 		{
 			matrixProxies = new Dictionary<(int, int), MatrixProxy>();
@@ -79,6 +88,37 @@ namespace NextGenSpice.Numerics.Equations
 		/// <summary>Number of variables in the equation system;</summary>
 		public int VariableCount { get; private set; }
 
+		/// <summary>Performs application-defined tasks associated with freeing, releasing, or resetting unmanaged resources.</summary>
+		public void Dispose()
+		{
+			system?.Dispose();
+		}
+
+		/// <summary>
+		///   If true, the LU factorization of the equation matrix is kept between calls to <see cref="Solve" /> and
+		///   recomputed only when the matrix changes, only forward and backward substitution is performed otherwise.
+		/// </summary>
+		public bool ReuseFactorization { get; set; }
+
+		/// <summary>
+		///   If true, the equation matrix is factored by multiple threads using native parallel LU factorization, which
+		///   is also reused when the matrix does not change.
+		/// </summary>
+		public bool UseParallelFactorization { get; set; }
+
+		/// <summary>Number of threads used by the parallel factorization, 0 means number of hardware threads.</summary>
+		public int ThreadCount { get; set; }
+
+		/// <summary>Equation systems with fewer variables are factored by single thread even if parallel factorization is used.</summary>
+		public int SerialCutoff { get; set; } = 200;
+
+		/// <summary>
+		///   If true, the ground variable (index 0) is removed from the equation system at <see cref="Freeze" /> and
+		///   <see cref="Clear" /> resets only the coefficients requested through the proxies, so that the assembly cost is
+		///   proportional to the number of nonzero coefficients. Such system is solved using LU factorization, which
+		///   leaves the assembled matrix intact. Must be set before the system is frozen.
+		/// </summary>
+		public bool SparseAssembly { get; set; }
 
 		/// <summary>Adds a new variable to the equation system and returns the index of the variable;</summary>
 		/// <returns></returns>
@@ -133,30 +173,106 @@ namespace NextGenSpice.Numerics.Equations
 		{
 			if (system != null) throw new InvalidOperationException("Equation system already frozen.");
 
-			system = new EquationSystem(VariableCount);
+			// with sparse assembly, ground is removed by shifting all coordinates by one
+			var offset = SparseAssembly ? 1 : 0;
+			system = new EquationSystem(VariableCount - offset);
 			// set system to all proxies
 			foreach (var proxy in matrixProxies.Values)
-				proxy.system = system;
+				proxy.Bind(system, offset);
 			foreach (var proxy in rhsProxies.Values)
-				proxy.system = system;
+				proxy.Bind(system, offset);
+			solution = new double[VariableCount];
 			foreach (var proxy in solutionProxies.Values)
-				proxy.system = system;
+				proxy.adapter = this;
+
+			if (!SparseAssembly) return;
+
+			// diagonal is always reset because of the anullation
+			var size = system.VariablesCount;
+			assembledEntries = matrixProxies.Values.Where(p => p.Row >= 0).Select(p => p.Row * size + p.Col)
+				.Concat(Enumerable.Range(0, size).Select(i => i * size + i)).Distinct().ToArray();
+			assembledRows = rhsProxies.Values.Where(p => p.Row >= 0).Select(p => p.Row).ToArray();
 		}
 
-		/// <summary>Solves the equation matrix and stores the result in the provided array.</summary>
+		/// <summary>
+		///   Solves the equation matrix and stores the result in the provided array. Unless the ground is removed by
+		///   <see cref="SparseAssembly" />, the solver writes directly into the array without intermediate copy. The
+		///   solution proxies read from the array until the next call, so it must not be modified by the caller.
+		/// </summary>
 		/// <param name="target"></param>
 		public void Solve(double[] target)
 		{
 			if (system == null) throw new InvalidOperationException("Equation system must be frozen before accessing.");
 			if (target.Length != VariableCount) throw new ArgumentException("The target array is of different size.");
-			system.Solve();
-			for (var i = 0; i < target.Length; i++) target[i] = system.Solution[i];
+
+			var offset = VariableCount - system.VariablesCount;
+			var x = offset == 0 ? target : system.Solution;
+			if (UseParallelFactorization)
+				system.SolveParallel(ThreadCount, SerialCutoff, x);
+			else if (ReuseFactorization || assembledEntries != null)
+				system.SolveFactored(x);
+			else
+				system.Solve(x);
+
+			solution = target;
+			if (offset == 0) return;
+
+			target[0] = 0;
+			for (var i = offset; i < target.Length; i++) target[i] = x[i - offset];
+		}
+
+		/// <summary>
+		///   Sets the values read by the solution proxies, e.g. to an estimate of the solution before the equation system
+		///   is solved.
+		/// </summary>
+		/// <param name="source"></param>
+		public void SetSolution(double[] source)
+		{
+			if (system == null) throw new InvalidOperationException("Equation system must be frozen before accessing.");
+			if (source.Length != VariableCount) throw new ArgumentException("The source array is of different size.");
+
+			// the modified Newton iterations start from the previous solution
+			var offset = VariableCount - system.VariablesCount;
+			for (var i = offset; i < source.Length; i++) system.Solution[i - offset] = source[i];
+			solution = source;
+		}
+
+		/// <summary>Whether the LU factors of some previously solved matrix are available.</summary>
+		public bool HasFactors => system != null && !UseParallelFactorization && system.HasFactors;
+
+		/// <summary>
+		///   Computes the next iterate x + A0^-1 * (b - A * x), where A and b form the current equation system, x is the
+		///   result of the previous solution and A0 is the last factored matrix, and stores it in the provided array.
+		/// </summary>
+		/// <param name="target"></param>
+		public void SolveChord(double[] target)
+		{
+			if (!HasFactors) throw new InvalidOperationException("The equation system has not been factored yet.");
+			if (target.Length != VariableCount) throw new ArgumentException("The target array is of different size.");
+
+			var offset = VariableCount - system.VariablesCount;
+			if (offset == 0)
+			{
+				system.SolveChord(solution, target);
+				solution = target;
+				return;
+			}
+
+			system.SolveChord(system.Solution, system.Solution);
+			solution = target;
+			target[0] = 0;
+			for (var i = offset; i < target.Length; i++) target[i] = system.Solution[i - offset];
 		}
 
 		/// <summary>Enforces value 0 of a particular eqation system variable.</summary>
 		/// <param name="index"></param>
 		public void Anullate(int index)
 		{
+			// removed ground variable is always zero
+			var offset = VariableCount - system.VariablesCount;
+			if (index < offset) return;
+			index -= offset;
+
 			var m = system.Matrix;
 
 			for (var i = 0; i < m.Size; i++)
@@ -171,6 +287,13 @@ namespace NextGenSpice.Numerics.Equations
 
 		public void Clear()
 		{
+			if (assembledEntries != null)
+			{
+				foreach (var i in assembledEntries) system.Matrix.RawData[i] = 0;
+				foreach (var i in assembledRows) system.RightHandSide[i] = 0;
+				return;
+			}
+
 			for (var i = 0; i < system.Matrix.RawData.Length; ++i) system.Matrix.RawData[i] = 0;
 
 			for (var i = 0; i < system.RightHandSide.Length; ++i) system.RightHandSide[i] = 0;
@@ -178,39 +301,58 @@ namespace NextGenSpice.Numerics.Equations
 
 		private class MatrixProxy : IEquationSystemCoefficientProxy
 		{
-			private readonly int col;
-			private readonly int row;
-
-			public EquationSystem system;
+			private EquationSystem system;
 
 			public MatrixProxy(int row, int col)
 			{
-				this.row = row;
-				this.col = col;
+				Row = row;
+				Col = col;
 			}
 
+			/// <summary>Row in the frozen system, -1 if the coefficient belongs to the removed ground row or column.</summary>
+			public int Row { get; private set; }
+
+			public int Col { get; private set; }
+
 			public void Add(double value)
 			{
 				if (double.IsNaN(value)) throw new ArgumentNaNException("Cannot insert NaN");
-				system.Matrix[row, col] += value;
+				if (Row < 0) return;
+				system.Matrix[Row, Col] += value;
+			}
+
+			public void Bind(EquationSystem system, int offset)
+			{
+				this.system = system;
+				Row -= offset;
+				Col -= offset;
+				if (Col < 0) Row = -1;
 			}
 		}
 
 		private class RhsProxy : IEquationSystemCoefficientProxy
 		{
-			private readonly int row;
-
-			public EquationSystem system;
+			private EquationSystem system;
 
 			public RhsProxy(int row)
 			{
-				this.row = row;
+				Row = row;
 			}
 
+			/// <summary>Row in the frozen system, -1 if the coefficient belongs to the removed ground row.</summary>
+			public int Row { get; private set; }
+
 			public void Add(double value)
 			{
 				if (double.IsNaN(value)) throw new ArgumentNaNException("Cannot insert NaN");
-				system.RightHandSide[row] += value;
+				if (Row < 0) return;
+				system.RightHandSide[Row] += value;
+			}
+
+			public void Bind(EquationSystem system, int offset)
+			{
+				this.system = system;
+				Row -= offset;
 			}
 		}
 
@@ -218,7 +360,7 @@ namespace NextGenSpice.Numerics.Equations
 		{
 			private readonly int row;
 
-			public EquationSystem system;
+			public EquationSystemAdapter adapter;
 
 			public SolutionProxy(int row)
 			{
@@ -227,14 +369,15 @@ namespace NextGenSpice.Numerics.Equations
 
 			public double GetValue()
 			{
-				return system.Solution[row];
+				return adapter.solution[row];
 			}
 		}
 	}
 
 #if dd_precision
 	/// <summary>Class providing equation system proxy objects for individual equaiton coefficients in double-double precision</summary>
-	public class DdEquationSystemAdapter : IEquationSystemAdapterWide
+	public class DdEquationSystemAdapter : IModifiedNewtonEquationSystemAdapter, IReusableFactorizationAdapter,
+		ISolutionSeedingAdapter, IDisposable
 	{
 		private readonly Dictionary<(int, int), MatrixProxy> matrixProxies;
 		private readonly Dictionary<int, RhsProxy> rhsProxies;
@@ -242,6 +385,10 @@ namespace NextGenSpice.Numerics.Equations
 
 		private DdEquationSystem system;
 
+		// positions of the coefficients reset by Clear() when SparseAssembly is used
+		private int[] assembledEntries;
+		private int[] assembledRows;
+
 		public DdEquationSystemAdapter()
 		{
 			matrixProxies = new Dictionary<(int, int), MatrixProxy>();
@@ -252,6 +399,25 @@ namespace NextGenSpice.Numerics.Equations
 		/// <summary>Number of variables in the equation system;</summary>
 		public int VariableCount { get; private set; }
 
+		/// <summary>Performs application-defined tasks associated with freeing, releasing, or resetting unmanaged resources.</summary>
+		public void Dispose()
+		{
+			system?.Dispose();
+		}
+
+		/// <summary>
+		///   If true, the LU factorization of the equation matrix is kept between calls to <see cref="Solve" /> and
+		///   recomputed only when the matrix changes, only forward and backward substitution is performed otherwise.
+		/// </summary>
+		public bool ReuseFactorization { get; set; }
+
+		/// <summary>
+		///   If true, the ground variable (index 0) is removed from the equation system at <see cref="Freeze" /> and
+		///   <see cref="Clear" /> resets only the coefficients requested through the proxies, so that the assembly cost is
+		///   proportional to the number of nonzero coefficients. Such system is solved using LU factorization, which
+		///   leaves the assembled matrix intact. Must be set before the system is frozen.
+		/// </summary>
+		public bool SparseAssembly { get; set; }
 
 		/// <summary>Adds a new variable to the equation system and returns the index of the variable;</summary>
 		/// <returns></returns>
@@ -306,14 +472,24 @@ namespace NextGenSpice.Numerics.Equations
 		{
 			if (system != null) throw new InvalidOperationException("Equation system already frozen.");
 
-			system = new DdEquationSystem(VariableCount);
+			// with sparse assembly, ground is removed by shifting all coordinates by one
+			var offset = SparseAssembly ? 1 : 0;
+			system = new DdEquationSystem(VariableCount - offset);
 			// set system to all proxies
 			foreach (var proxy in matrixProxies.Values)
-				proxy.system = system;
+				proxy.Bind(system, offset);
 			foreach (var proxy in rhsProxies.Values)
-				proxy.system = system;
+				proxy.Bind(system, offset);
 			foreach (var proxy in solutionProxies.Values)
-				proxy.system = system;
+				proxy.Bind(system, offset);
+
+			if (!SparseAssembly) return;
+
+			// diagonal is always reset because of the anullation
+			var size = system.VariablesCount;
+			assembledEntries = matrixProxies.Values.Where(p => p.Row >= 0).Select(p => p.Row * size + p.Col)
+				.Concat(Enumerable.Range(0, size).Select(i => i * size + i)).Distinct().ToArray();
+			assembledRows = rhsProxies.Values.Where(p => p.Row >= 0).Select(p => p.Row).ToArray();
 		}
 
 		/// <summary>Solves the equation matrix and stores the result in the provided array.</summary>
@@ -322,14 +498,61 @@ namespace NextGenSpice.Numerics.Equations
 		{
 			if (system == null) throw new InvalidOperationException("Equation system must be frozen before accessing.");
 			if (target.Length != VariableCount) throw new ArgumentException("The target array is of different size.");
-			system.Solve();
-			for (var i = 0; i < target.Length; i++) target[i] = (double) system.Solution[i];
+			if (ReuseFactorization || assembledEntries != null)
+				system.SolveFactored();
+			else
+				system.Solve();
+
+			CopySolution(target);
+		}
+
+		/// <summary>
+		///   Sets the values read by the solution proxies, e.g. to an estimate of the solution before the equation system
+		///   is solved.
+		/// </summary>
+		/// <param name="source"></param>
+		public void SetSolution(double[] source)
+		{
+			if (system == null) throw new InvalidOperationException("Equation system must be frozen before accessing.");
+			if (source.Length != VariableCount) throw new ArgumentException("The source array is of different size.");
+
+			var offset = VariableCount - system.VariablesCount;
+			for (var i = offset; i < source.Length; i++) system.Solution[i - offset] = source[i];
+		}
+
+		/// <summary>Whether the LU factors of some previously solved matrix are available.</summary>
+		public bool HasFactors => system != null && system.HasFactors;
+
+		/// <summary>
+		///   Computes the next iterate x + A0^-1 * (b - A * x), where A and b form the current equation system, x is the
+		///   result of the previous solution and A0 is the last factored matrix, and stores it in the provided array.
+		/// </summary>
+		/// <param name="target"></param>
+		public void SolveChord(double[] target)
+		{
+			if (!HasFactors) throw new InvalidOperationException("The equation system has not been factored yet.");
+			if (target.Length != VariableCount) throw new ArgumentException("The target array is of different size.");
+
+			system.SolveChord();
+			CopySolution(target);
+		}
+
+		private void CopySolution(double[] target)
+		{
+			var offset = VariableCount - system.VariablesCount;
+			if (offset > 0) target[0] = 0;
+			for (var i = offset; i < target.Length; i++) target[i] = (double) system.Solution[i - offset];
 		}
 
 		/// <summary>Enforces value 0 of a particular eqation system variable.</summary>
 		/// <param name="index"></param>
 		public void Anullate(int index)
 		{
+			// removed ground variable is always zero
+			var offset = VariableCount - system.VariablesCount;
+			if (index < offset) return;
+			index -= offset;
+
 			var m = system.Matrix;
 
 			for (var i = 0; i < m.Size; i++)
@@ -344,6 +567,13 @@ namespace NextGenSpice.Numerics.Equations
 
 		public void Clear()
 		{
+			if (assembledEntries != null)
+			{
+				foreach (var i in assembledEntries) system.Matrix.RawData[i] = 0;
+				foreach (var i in assembledRows) system.RightHandSide[i] = 0;
+				return;
+			}
+
 			for (var i = 0; i < system.Matrix.RawData.Length; ++i) system.Matrix.RawData[i] = 0;
 
 			for (var i = 0; i < system.RightHandSide.Length; ++i) system.RightHandSide[i] = 0;
@@ -351,47 +581,65 @@ namespace NextGenSpice.Numerics.Equations
 
 		private class MatrixProxy : IEquationSystemCoefficientProxy
 		{
-			private readonly int col;
-			private readonly int row;
-
-			public DdEquationSystem system;
+			private DdEquationSystem system;
 
 			public MatrixProxy(int row, int col)
 			{
-				this.row = row;
-				this.col = col;
+				Row = row;
+				Col = col;
 			}
 
+			/// <summary>Row in the frozen system, -1 if the coefficient belongs to the removed ground row or column.</summary>
+			public int Row { get; private set; }
+
+			public int Col { get; private set; }
+
 			public void Add(double value)
 			{
 				if (double.IsNaN(value)) throw new ArgumentNaNException("Cannot insert NaN");
-				system.Matrix[row, col] += value;
+				if (Row < 0) return;
+				system.Matrix[Row, Col] += value;
+			}
+
+			public void Bind(DdEquationSystem system, int offset)
+			{
+				this.system = system;
+				Row -= offset;
+				Col -= offset;
+				if (Col < 0) Row = -1;
 			}
 		}
 
 		private class RhsProxy : IEquationSystemCoefficientProxy
 		{
-			private readonly int row;
-
-			public DdEquationSystem system;
+			private DdEquationSystem system;
 
 			public RhsProxy(int row)
 			{
-				this.row = row;
+				Row = row;
 			}
 
+			/// <summary>Row in the frozen system, -1 if the coefficient belongs to the removed ground row.</summary>
+			public int Row { get; private set; }
+
 			public void Add(double value)
 			{
 				if (double.IsNaN(value)) throw new ArgumentNaNException("Cannot insert NaN");
-				system.RightHandSide[row] += value;
+				if (Row < 0) return;
+				system.RightHandSide[Row] += value;
+			}
+
+			public void Bind(DdEquationSystem system, int offset)
+			{
+				this.system = system;
+				Row -= offset;
 			}
 		}
 
 		private class SolutionProxy : IEquationSystemSolutionProxy
 		{
-			private readonly int row;
-
-			public DdEquationSystem system;
+			private int row;
+			private DdEquationSystem system;
 
 			public SolutionProxy(int row)
 			{
@@ -400,7 +648,13 @@ namespace NextGenSpice.Numerics.Equations
 
 			public double GetValue()
 			{
-				return (double) system.Solution[row];
+				return row < 0 ? 0 : (double) system.Solution[row];
+			}
+
+			public void Bind(DdEquationSystem system, int offset)
+			{
+				this.system = system;
+				row -= offset;
 			}
 		}
 	}
@@ -408,7 +662,8 @@ namespace NextGenSpice.Numerics.Equations
 
 #if qd_precision
 	/// <summary>Class providing equation system proxy objects for individual equaiton coefficients in quad-double precision</summary>
-	public class QdEquationSystemAdapter : IEquationSystemAdapterWide
+	public class QdEquationSystemAdapter : IModifiedNewtonEquationSystemAdapter, IReusableFactorizationAdapter,
+		ISolutionSeedingAdapter, IDisposable
 	{
 		private readonly Dictionary<(int, int), MatrixProxy> matrixProxies;
 		private readonly Dictionary<int, RhsProxy> rhsProxies;
@@ -416,6 +671,10 @@ namespace NextGenSpice.Numerics.Equations
 
 		private QdEquationSystem system;
 
+		// positions of the coefficients reset by Clear() when SparseAssembly is used
+		private int[] assembledEntries;
+		private int[] assembledRows;
+
 		public QdEquationSystemAdapter()
 		{
 			matrixProxies = new Dictionary<(int, int), MatrixProxy>();
@@ -426,6 +685,25 @@ namespace NextGenSpice.Numerics.Equations
 		/// <summary>Number of variables in the equation system;</summary>
 		public int VariableCount { get; private set; }
 
+		/// <summary>Performs application-defined tasks associated with freeing, releasing, or resetting unmanaged resources.</summary>
+		public void Dispose()
+		{
+			system?.Dispose();
+		}
+
+		/// <summary>
+		///   If true, the LU factorization of the equation matrix is kept between calls to <see cref="Solve" /> and
+		///   recomputed only when the matrix changes, only forward and backward substitution is performed otherwise.
+		/// </summary>
+		public bool ReuseFactorization { get; set; }
+
+		/// <summary>
+		///   If true, the ground variable (index 0) is removed from the equation system at <see cref="Freeze" /> and
+		///   <see cref="Clear" /> resets only the coefficients requested through the proxies, so that the assembly cost is
+		///   proportional to the number of nonzero coefficients. Such system is solved using LU factorization, which
+		///   leaves the assembled matrix intact. Must be set before the system is frozen.
+		/// </summary>
+		public bool SparseAssembly { get; set; }
 
 		/// <summary>Adds a new variable to the equation system and returns the index of the variable;</summary>
 		/// <returns></returns>
@@ -480,14 +758,24 @@ namespace NextGenSpice.Numerics.Equations
 		{
 			if (system != null) throw new InvalidOperationException("Equation system already frozen.");
 
-			system = new QdEquationSystem(VariableCount);
+			// with sparse assembly, ground is removed by shifting all coordinates by one
+			var offset = SparseAssembly ? 1 : 0;
+			system = new QdEquationSystem(VariableCount - offset);
 			// set system to all proxies
 			foreach (var proxy in matrixProxies.Values)
-				proxy.system = system;
+				proxy.Bind(system, offset);
 			foreach (var proxy in rhsProxies.Values)
-				proxy.system = system;
+				proxy.Bind(system, offset);
 			foreach (var proxy in solutionProxies.Values)
-				proxy.system = system;
+				proxy.Bind(system, offset);
+
+			if (!SparseAssembly) return;
+
+			// diagonal is always reset because of the anullation
+			var size = system.VariablesCount;
+			assembledEntries = matrixProxies.Values.Where(p => p.Row >= 0).Select(p => p.Row * size + p.Col)
+				.Concat(Enumerable.Range(0, size).Select(i => i * size + i)).Distinct().ToArray();
+			assembledRows = rhsProxies.Values.Where(p => p.Row >= 0).Select(p => p.Row).ToArray();
 		}
 
 		/// <summary>Solves the equation matrix and stores the result in the provided array.</summary>
@@ -496,14 +784,61 @@ namespace NextGenSpice.Numerics.Equations
 		{
 			if (system == null) throw new InvalidOperationException("Equation system must be frozen before accessing.");
 			if (target.Length != VariableCount) throw new ArgumentException("The target array is of different size.");
-			system.Solve();
-			for (var i = 0; i < target.Length; i++) target[i] = (double) system.Solution[i];
+			if (ReuseFactorization || assembledEntries != null)
+				system.SolveFactored();
+			else
+				system.Solve();
+
+			CopySolution(target);
+		}
+
+		/// <summary>
+		///   Sets the values read by the solution proxies, e.g. to an estimate of the solution before the equation system
+		///   is solved.
+		/// </summary>
+		/// <param name="source"></param>
+		public void SetSolution(double[] source)
+		{
+			if (system == null) throw new InvalidOperationException("Equation system must be frozen before accessing.");
+			if (source.Length != VariableCount) throw new ArgumentException("The source array is of different size.");
+
+			var offset = VariableCount - system.VariablesCount;
+			for (var i = offset; i < source.Length; i++) system.Solution[i - offset] = source[i];
+		}
+
+		/// <summary>Whether the LU factors of some previously solved matrix are available.</summary>
+		public bool HasFactors => system != null && system.HasFactors;
+
+		/// <summary>
+		///   Computes the next iterate x + A0^-1 * (b - A * x), where A and b form the current equation system, x is the
+		///   result of the previous solution and A0 is the last factored matrix, and stores it in the provided array.
+		/// </summary>
+		/// <param name="target"></param>
+		public void SolveChord(double[] target)
+		{
+			if (!HasFactors) throw new InvalidOperationException("The equation system has not been factored yet.");
+			if (target.Length != VariableCount) throw new ArgumentException("The target array is of different size.");
+
+			system.SolveChord();
+			CopySolution(target);
+		}
+
+		private void CopySolution(double[] target)
+		{
+			var offset = VariableCount - system.VariablesCount;
+			if (offset > 0) target[0] = 0;
+			for (var i = offset; i < target.Length; i++) target[i] = (double) system.Solution[i - offset];
 		}
 
 		/// <summary>Enforces value 0 of a particular eqation system variable.</summary>
 		/// <param name="index"></param>
 		public void Anullate(int index)
 		{
+			// removed ground variable is always zero
+			var offset = VariableCount - system.VariablesCount;
+			if (index < offset) return;
+			index -= offset;
+
 			var m = system.Matrix;
 
 			for (var i = 0; i < m.Size; i++)
@@ -518,6 +853,13 @@ namespace NextGenSpice.Numerics.Equations
 
 		public void Clear()
 		{
+			if (assembledEntries != null)
+			{
+				foreach (var i in assembledEntries) system.Matrix.RawData[i] = 0;
+				foreach (var i in assembledRows) system.RightHandSide[i] = 0;
+				return;
+			}
+
 			for (var i = 0; i < system.Matrix.RawData.Length; ++i) system.Matrix.RawData[i] = 0;
 
 			for (var i = 0; i < system.RightHandSide.Length; ++i) system.RightHandSide[i] = 0;
@@ -525,47 +867,65 @@ namespace NextGenSpice.Numerics.Equations
 
 		private class MatrixProxy : IEquationSystemCoefficientProxy
 		{
-			private readonly int col;
-			private readonly int row;
-
-			public QdEquationSystem system;
+			private QdEquationSystem system;
 
 			public MatrixProxy(int row, int col)
 			{
-				this.row = row;
-				this.col = col;
+				Row = row;
+				Col = col;
 			}
 
+			/// <summary>Row in the frozen system, -1 if the coefficient belongs to the removed ground row or column.</summary>
+			public int Row { get; private set; }
+
+			public int Col { get; private set; }
+
 			public void Add(double value)
 			{
 				if (double.IsNaN(value)) throw new ArgumentNaNException("Cannot insert NaN");
-				system.Matrix[row, col] += value;
+				if (Row < 0) return;
+				system.Matrix[Row, Col] += value;
+			}
+
+			public void Bind(QdEquationSystem system, int offset)
+			{
+				this.system = system;
+				Row -= offset;
+				Col -= offset;
+				if (Col < 0) Row = -1;
 			}
 		}
 
 		private class RhsProxy : IEquationSystemCoefficientProxy
 		{
-			private readonly int row;
-
-			public QdEquationSystem system;
+			private QdEquationSystem system;
 
 			public RhsProxy(int row)
 			{
-				this.row = row;
+				Row = row;
 			}
 
+			/// <summary>Row in the frozen system, -1 if the coefficient belongs to the removed ground row.</summary>
+			public int Row { get; private set; }
+
 			public void Add(double value)
 			{
 				if (double.IsNaN(value)) throw new ArgumentNaNException("Cannot insert NaN");
-				system.RightHandSide[row] += value;
+				if (Row < 0) return;
+				system.RightHandSide[Row] += value;
+			}
+
+			public void Bind(QdEquationSystem system, int offset)
+			{
+				this.system = system;
+				Row -= offset;
 			}
 		}
 
 		private class SolutionProxy : IEquationSystemSolutionProxy
 		{
-			private readonly int row;
-
-			public QdEquationSystem system;
+			private int row;
+			private QdEquationSystem system;
 
 			public SolutionProxy(int row)
 			{
@@ -574,7 +934,13 @@ namespace NextGenSpice.Numerics.Equations
 
 			public double GetValue()
 			{
-				return (double) system.Solution[row];
+				return row < 0 ? 0 : (double) system.Solution[row];
+			}
+
+			public void Bind(QdEquationSystem system, int offset)
+			{
+				this.system = system;
+				row -= offset;
 			}
 		}
 	}
@@ -0,0 +1,25 @@
+namespace NextGenSpice.Numerics.Equations
+{
+	/// <summary>Extension methods for obtaining <see cref="CoefficientSlot" /> instances from equation system adapters.</summary>
+	public static class EquationSystemAdapterExtensions
+	{
+		/// <summary>Returns slot for coefficient at given coordinates in the equation matrix.</summary>
+		/// <param name="adapter">The equation system adapter.</param>
+		/// <param name="row">Row coordinate.</param>
+		/// <param name="column">Column coordinate.</param>
+		/// <returns></returns>
+		public static CoefficientSlot GetMatrixCoefficientSlot(this IEquationSystemAdapter adapter, int row, int column)
+		{
+			return CoefficientSlot.From(adapter.GetMatrixCoefficientProxy(row, column));
+		}
+
+		/// <summary>Returns slot for coefficient at given row in the right hand side vector.</summary>
+		/// <param name="adapter">The equation system adapter.</param>
+		/// <param name="row">Row coordinate.</param>
+		/// <returns></returns>
+		public static CoefficientSlot GetRightHandSideCoefficientSlot(this IEquationSystemAdapter adapter, int row)
+		{
+			return CoefficientSlot.From(adapter.GetRightHandSideCoefficientProxy(row));
+		}
+	}
+}
@@ -0,0 +1,19 @@
+namespace NextGenSpice.Numerics.Equations
+{
+	/// <summary>
+	///   Equation system adapter which can solve the system using LU factors of an older matrix, which allows modified
+	///   Newton (chord) iterations without refactoring the matrix.
+	/// </summary>
+	public interface IModifiedNewtonEquationSystemAdapter : IEquationSystemAdapterWide
+	{
+		/// <summary>Whether the LU factors of some previously solved matrix are available.</summary>
+		bool HasFactors { get; }
+
+		/// <summary>
+		///   Computes the next iterate x + A0^-1 * (b - A * x), where A and b form the current equation system, x is the
+		///   result of the previous solution and A0 is the last factored matrix, and stores it in the provided array.
+		/// </summary>
+		/// <param name="target"></param>
+		void SolveChord(double[] target);
+	}
+}
@@ -0,0 +1,16 @@
+namespace NextGenSpice.Numerics.Equations
+{
+	/// <summary>
+	///   Equation system adapter which can keep the LU factorization of the equation matrix between solutions, so that
+	///   repeated solutions with the same matrix need only forward and backward substitution.
+	/// </summary>
+	public interface IReusableFactorizationAdapter : IEquationSystemAdapterWide
+	{
+		/// <summary>
+		///   If true, the LU factorization of the equation matrix is kept between calls to
+		///   <see cref="IEquationSystemAdapterWide.Solve" /> and recomputed only when the matrix changes, only forward and
+		///   backward substitution is performed otherwise.
+		/// </summary>
+		bool ReuseFactorization { get; set; }
+	}
+}
@@ -0,0 +1,13 @@
+namespace NextGenSpice.Numerics.Equations
+{
+	/// <summary>
+	///   Equation system adapter whose solution proxies can be set to given values before the equation system is
+	///   solved, e.g. to an estimate of the solution.
+	/// </summary>
+	public interface ISolutionSeedingAdapter : IEquationSystemAdapterWide
+	{
+		/// <summary>Sets the values read by the solution proxies.</summary>
+		/// <param name="source"></param>
+		void SetSolution(double[] source);
+	}
+}
@@ -0,0 +1,63 @@
+using System;
+using NextGenSpice.Numerics.Precision;
+
+namespace NextGenSpice.Numerics.Equations
+{
+#if dd_precision
+	/// <summary>
+	///   Equation system with dd_real precision coefficients which is solved by factorization in lower precision and
+	///   iterative refinement.
+	/// </summary>
+	public class MixedPrecisionEquationSystem : IEquationSystem, IDisposable
+	{
+		public MixedPrecisionEquationSystem(int size, FactorPrecision precision = FactorPrecision.Double)
+		{
+			Matrix = new Matrix<dd_real>(size);
+			Solution = new dd_real[size];
+			RightHandSide = new dd_real[size];
+			Solver = new MixedPrecisionSolver(size, precision);
+		}
+
+		/// <summary>Solver used for solving the system.</summary>
+		public MixedPrecisionSolver Solver { get; }
+
+		/// <summary>Whether the last call to Solve() reached the target backward error.</summary>
+		public bool LastSolveConverged { get; private set; }
+
+		/// <summary>Result of the latest call to the Solve() method.</summary>
+		public dd_real[] Solution { get; }
+
+		/// <summary>Matrix part of the equation system.</summary>
+		public Matrix<dd_real> Matrix { get; }
+
+		/// <summary>Right hand side vector of the equation system.</summary>
+		public dd_real[] RightHandSide { get; }
+
+		/// <summary>Count of the variables in the equation.</summary>
+		public int VariablesCount => Solution.Length;
+
+		/// <summary>Performs application-defined tasks associated with freeing, releasing, or resetting unmanaged resources.</summary>
+		public void Dispose()
+		{
+			Solver.Dispose();
+		}
+
+		/// <summary>Returns solution for the given variable.</summary>
+		/// <param name="variable">Index of the variable in the equation system.</param>
+		/// <returns></returns>
+		public double GetSolution(int variable)
+		{
+			return Solution[variable].x0;
+		}
+
+		/// <summary>
+		///   Solves the linear equation system, the matrix is not modified. If the system has no solution, the solution
+		///   is filled with NaN.
+		/// </summary>
+		public void Solve()
+		{
+			LastSolveConverged = Solver.Solve(Matrix, RightHandSide, Solution);
+		}
+	}
+#endif
+}
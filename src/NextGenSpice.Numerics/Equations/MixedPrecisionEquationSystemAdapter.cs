@@ -0,0 +1,234 @@
+﻿using System;
+using System.Collections.Generic;
+
+namespace NextGenSpice.Numerics.Equations
+{
+#if dd_precision
+	/// <summary>
+	///   Class providing equation system proxy objects for individual equation coefficients in double-double precision.
+	///   The system is solved by LU factorization in double (or single) precision and iterative refinement with
+	///   residuals computed in double-double precision.
+	/// </summary>
+	public class MixedPrecisionEquationSystemAdapter : IReusableFactorizationAdapter, ISolutionSeedingAdapter,
+		IDisposable
+	{
+		private readonly Dictionary<(int, int), MatrixProxy> matrixProxies;
+		private readonly Dictionary<int, RhsProxy> rhsProxies;
+		private readonly Dictionary<int, SolutionProxy> solutionProxies;
+
+		private MixedPrecisionEquationSystem system;
+
+		public MixedPrecisionEquationSystemAdapter(FactorPrecision precision = FactorPrecision.Double)
+		{
+			Precision = precision;
+			matrixProxies = new Dictionary<(int, int), MatrixProxy>();
+			rhsProxies = new Dictionary<int, RhsProxy>();
+			solutionProxies = new Dictionary<int, SolutionProxy>();
+		}
+
+		/// <summary>Precision of the LU factors.</summary>
+		public FactorPrecision Precision { get; }
+
+		/// <summary>Maximum number of refinement steps per solve.</summary>
+		public int MaxRefinementSteps { get; set; } = 10;
+
+		/// <summary>Target normwise backward error of the solution.</summary>
+		public double Tolerance { get; set; } = 1e-24;
+
+		/// <summary>Total number of refinement steps over all solves.</summary>
+		public int TotalRefinementSteps { get; private set; }
+
+		/// <summary>Number of solves in which the refinement stopped before reaching <see cref="Tolerance" />.</summary>
+		public int StagnatedSolveCount { get; private set; }
+
+		/// <summary>Backward error of the solution of the last solve.</summary>
+		public double LastBackwardError => system?.Solver.LastBackwardError ?? 0;
+
+		/// <summary>Number of variables in the equation system;</summary>
+		public int VariableCount { get; private set; }
+
+		/// <summary>Performs application-defined tasks associated with freeing, releasing, or resetting unmanaged resources.</summary>
+		public void Dispose()
+		{
+			system?.Dispose();
+		}
+
+		/// <summary>
+		///   If true, the LU factorization of the equation matrix is kept between calls to <see cref="Solve" /> and
+		///   recomputed only when the matrix changes. The mixed precision solver always does so, because it needs to
+		///   keep the matrix intact for computing the residuals.
+		/// </summary>
+		public bool ReuseFactorization { get; set; }
+
+		/// <summary>Adds a new variable to the equation system and returns the index of the variable;</summary>
+		/// <returns></returns>
+		public int AddVariable()
+		{
+			return VariableCount++;
+		}
+
+		/// <summary>Returns proxy class for coefficient at given coordinates in the equation matrix.</summary>
+		/// <param name="row">Row coordinate.</param>
+		/// <param name="column">Column coordinate.</param>
+		/// <returns></returns>
+		public IEquationSystemCoefficientProxy GetMatrixCoefficientProxy(int row, int column)
+		{
+			if (row < 0 || row >= VariableCount) throw new ArgumentOutOfRangeException(nameof(row));
+			if (column < 0 || column >= VariableCount) throw new ArgumentOutOfRangeException(nameof(column));
+			if (system != null) throw new InvalidOperationException("Equation system already frozen.");
+
+			if (!matrixProxies.TryGetValue((row, column), out var proxy))
+				proxy = matrixProxies[(row, column)] = new MatrixProxy(row, column);
+			return proxy;
+		}
+
+		/// <summary>Returns proxy class for coefficient at given row in the right hand side vector.</summary>
+		/// <param name="row">Row coordinate.</param>
+		/// <returns></returns>
+		public IEquationSystemCoefficientProxy GetRightHandSideCoefficientProxy(int row)
+		{
+			if (row < 0 || row >= VariableCount) throw new ArgumentOutOfRangeException(nameof(row));
+			if (system != null) throw new InvalidOperationException("Equation system already frozen.");
+
+			if (!rhsProxies.TryGetValue(row, out var proxy))
+				proxy = rhsProxies[row] = new RhsProxy(row);
+			return proxy;
+		}
+
+		/// <summary>Returns proxy class for the i-th variable of the solution.</summary>
+		/// <param name="index"></param>
+		/// <returns></returns>
+		public IEquationSystemSolutionProxy GetSolutionProxy(int index)
+		{
+			if (index < 0 || index >= VariableCount) throw new ArgumentOutOfRangeException(nameof(index));
+			if (system != null) throw new InvalidOperationException("Equation system already frozen.");
+
+			if (!solutionProxies.TryGetValue(index, out var proxy))
+				proxy = solutionProxies[index] = new SolutionProxy(index);
+			return proxy;
+		}
+
+		/// <summary>Freezes the representation of the equation matrix.</summary>
+		public void Freeze()
+		{
+			if (system != null) throw new InvalidOperationException("Equation system already frozen.");
+
+			system = new MixedPrecisionEquationSystem(VariableCount, Precision);
+			// set system to all proxies
+			foreach (var proxy in matrixProxies.Values)
+				proxy.system = system;
+			foreach (var proxy in rhsProxies.Values)
+				proxy.system = system;
+			foreach (var proxy in solutionProxies.Values)
+				proxy.system = system;
+		}
+
+		/// <summary>Solves the equation matrix and stores the result in the provided array.</summary>
+		/// <param name="target"></param>
+		public void Solve(double[] target)
+		{
+			if (system == null) throw new InvalidOperationException("Equation system must be frozen before accessing.");
+			if (target.Length != VariableCount) throw new ArgumentException("The target array is of different size.");
+			system.Solver.MaxRefinementSteps = MaxRefinementSteps;
+			system.Solver.Tolerance = Tolerance;
+			system.Solve();
+
+			TotalRefinementSteps += system.Solver.LastRefinementSteps;
+			if (!system.LastSolveConverged) StagnatedSolveCount++;
+
+			for (var i = 0; i < target.Length; i++) target[i] = (double) system.Solution[i];
+		}
+
+		/// <summary>
+		///   Sets the values read by the solution proxies, e.g. to an estimate of the solution before the equation system
+		///   is solved.
+		/// </summary>
+		/// <param name="source"></param>
+		public void SetSolution(double[] source)
+		{
+			if (system == null) throw new InvalidOperationException("Equation system must be frozen before accessing.");
+			if (source.Length != VariableCount) throw new ArgumentException("The source array is of different size.");
+
+			for (var i = 0; i < source.Length; i++) system.Solution[i] = source[i];
+		}
+
+		/// <summary>Enforces value 0 of a particular eqation system variable.</summary>
+		/// <param name="index"></param>
+		public void Anullate(int index)
+		{
+			var m = system.Matrix;
+
+			for (var i = 0; i < m.Size; i++)
+			{
+				m[i, index] = 0;
+				m[index, i] = 0;
+			}
+
+			m[index, index] = 1;
+			system.RightHandSide[index] = 0;
+		}
+
+		public void Clear()
+		{
+			for (var i = 0; i < system.Matrix.RawData.Length; ++i) system.Matrix.RawData[i] = 0;
+
+			for (var i = 0; i < system.RightHandSide.Length; ++i) system.RightHandSide[i] = 0;
+		}
+
+		private class MatrixProxy : IEquationSystemCoefficientProxy
+		{
+			private readonly int col;
+			private readonly int row;
+
+			public MixedPrecisionEquationSystem system;
+
+			public MatrixProxy(int row, int col)
+			{
+				this.row = row;
+				this.col = col;
+			}
+
+			public void Add(double value)
+			{
+				if (double.IsNaN(value)) throw new ArgumentNaNException("Cannot insert NaN");
+				system.Matrix[row, col] += value;
+			}
+		}
+
+		private class RhsProxy : IEquationSystemCoefficientProxy
+		{
+			private readonly int row;
+
+			public MixedPrecisionEquationSystem system;
+
+			public RhsProxy(int row)
+			{
+				this.row = row;
+			}
+
+			public void Add(double value)
+			{
+				if (double.IsNaN(value)) throw new ArgumentNaNException("Cannot insert NaN");
+				system.RightHandSide[row] += value;
+			}
+		}
+
+		private class SolutionProxy : IEquationSystemSolutionProxy
+		{
+			private readonly int row;
+
+			public MixedPrecisionEquationSystem system;
+
+			public SolutionProxy(int row)
+			{
+				this.row = row;
+			}
+
+			public double GetValue()
+			{
+				return (double) system.Solution[row];
+			}
+		}
+	}
+#endif
+}
@@ -0,0 +1,89 @@
+﻿using System;
+
+namespace NextGenSpice.Numerics.Equations
+{
+	/// <summary>
+	///   Equation system with double precision coefficients stored in a sparse matrix. The pattern of the matrix is
+	///   analyzed only once, repeated solving reuses the structure of the factorization.
+	/// </summary>
+	public class SparseEquationSystem : IEquationSystem, IDisposable
+	{
+		// copy of the matrix values at the time of the last successful factorization
+		private readonly double[] factoredValues;
+
+		public SparseEquationSystem(SparseMatrix<double> matrix, SparseOrdering ordering = SparseOrdering.MinimumDegree)
+		{
+			Matrix = matrix ?? throw new ArgumentNullException(nameof(matrix));
+			Solution = new double[matrix.Size];
+			RightHandSide = new double[matrix.Size];
+			Factorization = new SparseLuFactorization(matrix, ordering);
+			factoredValues = new double[matrix.NonzeroCount];
+		}
+
+		/// <summary>Factorization of the matrix used for solving the system.</summary>
+		public SparseLuFactorization Factorization { get; }
+
+		/// <summary>Result of the latest call to the Solve() method.</summary>
+		public double[] Solution { get; }
+
+		/// <summary>Matrix part of the equation system.</summary>
+		public SparseMatrix<double> Matrix { get; }
+
+		/// <summary>Right hand side vector of the equation system.</summary>
+		public double[] RightHandSide { get; }
+
+		/// <summary>Count of the variables in the equation.</summary>
+		public int VariablesCount => Solution.Length;
+
+		/// <summary>Performs application-defined tasks associated with freeing, releasing, or resetting unmanaged resources.</summary>
+		public void Dispose()
+		{
+			Factorization.Dispose();
+		}
+
+		/// <summary>Returns solution for the given variable.</summary>
+		/// <param name="variable">Index of the variable in the equation system.</param>
+		/// <returns></returns>
+		public double GetSolution(int variable)
+		{
+			return Solution[variable];
+		}
+
+		/// <summary>Solves the linear equation system. If the system has no solution, the solution is filled with NaN.</summary>
+		public void Solve()
+		{
+			if (Factorization.Factor())
+				Factorization.Solve(RightHandSide, Solution);
+			else
+				for (var i = 0; i < Solution.Length; i++) Solution[i] = double.NaN;
+		}
+
+		/// <summary>
+		///   Solves the linear equation system, the factorization is recomputed only if the matrix values changed since the
+		///   last factorization.
+		/// </summary>
+		public void SolveFactored()
+		{
+			if (!Factorization.IsFactored || !ValuesEqual(Matrix.Values, factoredValues))
+			{
+				if (!Factorization.Factor())
+				{
+					for (var i = 0; i < Solution.Length; i++) Solution[i] = double.NaN;
+					return;
+				}
+
+				Matrix.Values.CopyTo(factoredValues, 0);
+			}
+
+			Factorization.Solve(RightHandSide, Solution);
+		}
+
+		private static bool ValuesEqual(double[] a, double[] b)
+		{
+			for (var i = 0; i < a.Length; i++)
+				if (a[i] != b[i])
+					return false;
+			return true;
+		}
+	}
+}
@@ -0,0 +1,246 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+
+namespace NextGenSpice.Numerics.Equations
+{
+	/// <summary>
+	///   Class providing equation system proxy objects for individual equation coefficients in double precision. Only
+	///   the coefficients for which a proxy was requested are stored and the system is solved using sparse LU
+	///   factorization.
+	/// </summary>
+	public class SparseEquationSystemAdapter : IReusableFactorizationAdapter, ISolutionSeedingAdapter,
+		IDisposable
+	{
+		private readonly Dictionary<(int, int), MatrixProxy> matrixProxies;
+		private readonly Dictionary<int, RhsProxy> rhsProxies;
+		private readonly Dictionary<int, SolutionProxy> solutionProxies;
+
+		private SparseEquationSystem system;
+
+		// indices into matrix values of the diagonal entries and entries in given row
+		private int[] diagonalSlots;
+		private int[][] rowSlots;
+
+		public SparseEquationSystemAdapter(SparseOrdering ordering = SparseOrdering.MinimumDegree)
+		{
+			Ordering = ordering;
+			matrixProxies = new Dictionary<(int, int), MatrixProxy>();
+			rhsProxies = new Dictionary<int, RhsProxy>();
+			solutionProxies = new Dictionary<int, SolutionProxy>();
+		}
+
+		/// <summary>Column ordering used for the factorization of the equation matrix.</summary>
+		public SparseOrdering Ordering { get; }
+
+		/// <summary>Number of nonzero entries in the equation matrix, available after the adapter is frozen.</summary>
+		public int NonzeroCount => system?.Matrix.NonzeroCount ?? 0;
+
+		/// <summary>Number of entries in the LU factors predicted by the symbolic analysis, available after the adapter is frozen.</summary>
+		public int PredictedFactorNonzeroCount => system?.Factorization.PredictedNonzeroCount ?? 0;
+
+		/// <summary>Number of entries in the LU factors after the last solve.</summary>
+		public int FactorNonzeroCount => system?.Factorization.NonzeroCount ?? 0;
+
+		/// <summary>Performs application-defined tasks associated with freeing, releasing, or resetting unmanaged resources.</summary>
+		public void Dispose()
+		{
+			system?.Dispose();
+		}
+
+		/// <summary>Number of variables in the equation system;</summary>
+		public int VariableCount { get; private set; }
+
+		/// <summary>
+		///   If true, the LU factorization of the equation matrix is kept between calls to <see cref="Solve" /> and
+		///   recomputed only when the matrix changes, only forward and backward substitution is performed otherwise.
+		/// </summary>
+		public bool ReuseFactorization { get; set; }
+
+		/// <summary>Adds a new variable to the equation system and returns the index of the variable;</summary>
+		/// <returns></returns>
+		public int AddVariable()
+		{
+			return VariableCount++;
+		}
+
+		/// <summary>Returns proxy class for coefficient at given coordinates in the equation matrix.</summary>
+		/// <param name="row">Row coordinate.</param>
+		/// <param name="column">Column coordinate.</param>
+		/// <returns></returns>
+		public IEquationSystemCoefficientProxy GetMatrixCoefficientProxy(int row, int column)
+		{
+			if (row < 0 || row >= VariableCount) throw new ArgumentOutOfRangeException(nameof(row));
+			if (column < 0 || column >= VariableCount) throw new ArgumentOutOfRangeException(nameof(column));
+			if (system != null) throw new InvalidOperationException("Equation system already frozen.");
+
+			if (!matrixProxies.TryGetValue((row, column), out var proxy))
+				proxy = matrixProxies[(row, column)] = new MatrixProxy(row, column);
+			return proxy;
+		}
+
+		/// <summary>Returns proxy class for coefficient at given row in the right hand side vector.</summary>
+		/// <param name="row">Row coordinate.</param>
+		/// <returns></returns>
+		public IEquationSystemCoefficientProxy GetRightHandSideCoefficientProxy(int row)
+		{
+			if (row < 0 || row >= VariableCount) throw new ArgumentOutOfRangeException(nameof(row));
+			if (system != null) throw new InvalidOperationException("Equation system already frozen.");
+
+			if (!rhsProxies.TryGetValue(row, out var proxy))
+				proxy = rhsProxies[row] = new RhsProxy(row);
+			return proxy;
+		}
+
+		/// <summary>Returns proxy class for the i-th variable of the solution.</summary>
+		/// <param name="index"></param>
+		/// <returns></returns>
+		public IEquationSystemSolutionProxy GetSolutionProxy(int index)
+		{
+			if (index < 0 || index >= VariableCount) throw new ArgumentOutOfRangeException(nameof(index));
+			if (system != null) throw new InvalidOperationException("Equation system already frozen.");
+
+			if (!solutionProxies.TryGetValue(index, out var proxy))
+				proxy = solutionProxies[index] = new SolutionProxy(index);
+			return proxy;
+		}
+
+		/// <summary>Freezes the representation of the equation matrix.</summary>
+		public void Freeze()
+		{
+			if (system != null) throw new InvalidOperationException("Equation system already frozen.");
+
+			// diagonal is always part of the pattern so that the variables can be anullated
+			var entries = matrixProxies.Keys.Concat(Enumerable.Range(0, VariableCount).Select(i => (i, i)));
+			var matrix = SparseMatrix<double>.FromCoordinates(VariableCount, entries);
+			system = new SparseEquationSystem(matrix, Ordering);
+
+			diagonalSlots = new int[VariableCount];
+			var rows = Enumerable.Range(0, VariableCount).Select(_ => new List<int>()).ToArray();
+			for (var col = 0; col < VariableCount; col++)
+			for (var p = matrix.ColumnPointers[col]; p < matrix.ColumnPointers[col + 1]; p++)
+			{
+				var row = matrix.RowIndices[p];
+				rows[row].Add(p);
+				if (row == col) diagonalSlots[col] = p;
+			}
+
+			rowSlots = rows.Select(r => r.ToArray()).ToArray();
+
+			// set system to all proxies
+			foreach (var proxy in matrixProxies.Values)
+			{
+				proxy.values = matrix.Values;
+				proxy.slot = matrix.IndexOf(proxy.row, proxy.col);
+			}
+
+			foreach (var proxy in rhsProxies.Values)
+				proxy.system = system;
+			foreach (var proxy in solutionProxies.Values)
+				proxy.system = system;
+		}
+
+		/// <summary>Solves the equation matrix and stores the result in the provided array.</summary>
+		/// <param name="target"></param>
+		public void Solve(double[] target)
+		{
+			if (system == null) throw new InvalidOperationException("Equation system must be frozen before accessing.");
+			if (target.Length != VariableCount) throw new ArgumentException("The target array is of different size.");
+			if (ReuseFactorization)
+				system.SolveFactored();
+			else
+				system.Solve();
+			for (var i = 0; i < target.Length; i++) target[i] = system.Solution[i];
+		}
+
+		/// <summary>
+		///   Sets the values read by the solution proxies, e.g. to an estimate of the solution before the equation system
+		///   is solved.
+		/// </summary>
+		/// <param name="source"></param>
+		public void SetSolution(double[] source)
+		{
+			if (system == null) throw new InvalidOperationException("Equation system must be frozen before accessing.");
+			if (source.Length != VariableCount) throw new ArgumentException("The source array is of different size.");
+
+			for (var i = 0; i < source.Length; i++) system.Solution[i] = source[i];
+		}
+
+		/// <summary>Enforces value 0 of a particular eqation system variable.</summary>
+		/// <param name="index"></param>
+		public void Anullate(int index)
+		{
+			var m = system.Matrix;
+
+			for (var p = m.ColumnPointers[index]; p < m.ColumnPointers[index + 1]; p++)
+				m.Values[p] = 0;
+			foreach (var p in rowSlots[index])
+				m.Values[p] = 0;
+
+			m.Values[diagonalSlots[index]] = 1;
+			system.RightHandSide[index] = 0;
+		}
+
+		public void Clear()
+		{
+			Array.Clear(system.Matrix.Values, 0, system.Matrix.Values.Length);
+			Array.Clear(system.RightHandSide, 0, system.RightHandSide.Length);
+		}
+
+		private class MatrixProxy : IEquationSystemCoefficientProxy
+		{
+			public readonly int col;
+			public readonly int row;
+
+			public int slot;
+			public double[] values;
+
+			public MatrixProxy(int row, int col)
+			{
+				this.row = row;
+				this.col = col;
+			}
+
+			public void Add(double value)
+			{
+				if (double.IsNaN(value)) throw new ArgumentNaNException("Cannot insert NaN");
+				values[slot] += value;
+			}
+		}
+
+		private class RhsProxy : IEquationSystemCoefficientProxy
+		{
+			private readonly int row;
+
+			public SparseEquationSystem system;
+
+			public RhsProxy(int row)
+			{
+				this.row = row;
+			}
+
+			public void Add(double value)
+			{
+				if (double.IsNaN(value)) throw new ArgumentNaNException("Cannot insert NaN");
+				system.RightHandSide[row] += value;
+			}
+		}
+
+		private class SolutionProxy : IEquationSystemSolutionProxy
+		{
+			private readonly int row;
+
+			public SparseEquationSystem system;
+
+			public SolutionProxy(int row)
+			{
+				this.row = row;
+			}
+
+			public double GetValue()
+			{
+				return system.Solution[row];
+			}
+		}
+	}
+}
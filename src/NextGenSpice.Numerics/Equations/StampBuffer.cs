@@ -0,0 +1,111 @@
+using System;
+using System.Collections.Generic;
+
+namespace NextGenSpice.Numerics.Equations
+{
+	/// <summary>
+	///   Equation system adapter decorator which gives each requested coefficient proxy its own private accumulator.
+	///   Devices stamping through the buffer do not share any coefficient and can be evaluated concurrently. The
+	///   accumulated values are then added to the decorated equation system in the order in which the proxies were
+	///   requested, so the sums are deterministic regardless of the evaluation order of the devices. They may differ in
+	///   the last bits from stamping directly into the decorated equation system.
+	/// </summary>
+	public class StampBuffer : IEquationSystemAdapter
+	{
+		private readonly IEquationSystemAdapter adapter;
+		private readonly List<CoefficientSlot> targets;
+		private double[] values;
+
+		public StampBuffer(IEquationSystemAdapter adapter)
+		{
+			this.adapter = adapter ?? throw new ArgumentNullException(nameof(adapter));
+			targets = new List<CoefficientSlot>();
+			values = new double[0];
+		}
+
+		/// <summary>Number of private accumulators in the buffer.</summary>
+		public int CoefficientCount => targets.Count;
+
+		/// <summary>Adds a new variable to the equation system and returns the index of the variable;</summary>
+		/// <returns></returns>
+		public int AddVariable()
+		{
+			return adapter.AddVariable();
+		}
+
+		/// <summary>Returns proxy class for coefficient at given coordinates in the equation matrix.</summary>
+		/// <param name="row">Row coordinate.</param>
+		/// <param name="column">Column coordinate.</param>
+		/// <returns></returns>
+		public IEquationSystemCoefficientProxy GetMatrixCoefficientProxy(int row, int column)
+		{
+			return AddAccumulator(adapter.GetMatrixCoefficientSlot(row, column));
+		}
+
+		/// <summary>Returns proxy class for coefficient at given row in the right hand side vector.</summary>
+		/// <param name="row">Row coordinate.</param>
+		/// <returns></returns>
+		public IEquationSystemCoefficientProxy GetRightHandSideCoefficientProxy(int row)
+		{
+			return AddAccumulator(adapter.GetRightHandSideCoefficientSlot(row));
+		}
+
+		/// <summary>Returns proxy class for the i-th variable of the solution.</summary>
+		/// <param name="index"></param>
+		/// <returns></returns>
+		public IEquationSystemSolutionProxy GetSolutionProxy(int index)
+		{
+			return adapter.GetSolutionProxy(index);
+		}
+
+		private Accumulator AddAccumulator(CoefficientSlot target)
+		{
+			targets.Add(target);
+			if (targets.Count > values.Length) Array.Resize(ref values, Math.Max(16, 2 * values.Length));
+			return new Accumulator(this, targets.Count - 1);
+		}
+
+		/// <summary>
+		///   Adds the accumulated values to the decorated equation system in the order in which the proxies were requested
+		///   and resets the accumulators. The accumulators are reset also when adding a value fails.
+		/// </summary>
+		public void Apply()
+		{
+			try
+			{
+				for (var i = 0; i < targets.Count; i++)
+				{
+					var value = values[i];
+					if (value != 0) targets[i].Add(value);
+				}
+			}
+			finally
+			{
+				Clear();
+			}
+		}
+
+		/// <summary>Resets the accumulators without adding them to the decorated equation system.</summary>
+		public void Clear()
+		{
+			Array.Clear(values, 0, targets.Count);
+		}
+
+		private class Accumulator : IEquationSystemCoefficientProxy
+		{
+			private readonly StampBuffer buffer;
+			private readonly int index;
+
+			public Accumulator(StampBuffer buffer, int index)
+			{
+				this.buffer = buffer;
+				this.index = index;
+			}
+
+			public void Add(double value)
+			{
+				buffer.values[index] += value;
+			}
+		}
+	}
+}
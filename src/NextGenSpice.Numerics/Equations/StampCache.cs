@@ -0,0 +1,121 @@
+using System;
+using System.Collections.Generic;
+
+namespace NextGenSpice.Numerics.Equations
+{
+	/// <summary>
+	///   Equation system adapter decorator which records stamps of devices whose coefficients stay the same between
+	///   iterations. The recorded values are summed per coefficient into a base layer, which is then added onto the
+	///   decorated equation system after each clear without evaluating the devices again.
+	/// </summary>
+	public class StampCache : IEquationSystemAdapter
+	{
+		private readonly IEquationSystemAdapter adapter;
+		private readonly List<CachedCoefficient> coefficients;
+		private readonly Dictionary<(int, int), CachedCoefficient> matrixCoefficients;
+		private readonly Dictionary<int, CachedCoefficient> rhsCoefficients;
+
+		public StampCache(IEquationSystemAdapter adapter)
+		{
+			this.adapter = adapter ?? throw new ArgumentNullException(nameof(adapter));
+			coefficients = new List<CachedCoefficient>();
+			matrixCoefficients = new Dictionary<(int, int), CachedCoefficient>();
+			rhsCoefficients = new Dictionary<int, CachedCoefficient>();
+		}
+
+		/// <summary>Number of distinct coefficients in the base layer.</summary>
+		public int CoefficientCount => coefficients.Count;
+
+		/// <summary>Adds a new variable to the equation system and returns the index of the variable;</summary>
+		/// <returns></returns>
+		public int AddVariable()
+		{
+			return adapter.AddVariable();
+		}
+
+		/// <summary>Returns proxy class for coefficient at given coordinates in the equation matrix.</summary>
+		/// <param name="row">Row coordinate.</param>
+		/// <param name="column">Column coordinate.</param>
+		/// <returns></returns>
+		public IEquationSystemCoefficientProxy GetMatrixCoefficientProxy(int row, int column)
+		{
+			if (!matrixCoefficients.TryGetValue((row, column), out var coefficient))
+			{
+				coefficient = matrixCoefficients[(row, column)] =
+					new CachedCoefficient(adapter.GetMatrixCoefficientSlot(row, column));
+				coefficients.Add(coefficient);
+			}
+
+			return coefficient;
+		}
+
+		/// <summary>Returns proxy class for coefficient at given row in the right hand side vector.</summary>
+		/// <param name="row">Row coordinate.</param>
+		/// <returns></returns>
+		public IEquationSystemCoefficientProxy GetRightHandSideCoefficientProxy(int row)
+		{
+			if (!rhsCoefficients.TryGetValue(row, out var coefficient))
+			{
+				coefficient = rhsCoefficients[row] = new CachedCoefficient(adapter.GetRightHandSideCoefficientSlot(row));
+				coefficients.Add(coefficient);
+			}
+
+			return coefficient;
+		}
+
+		/// <summary>Returns proxy class for the i-th variable of the solution.</summary>
+		/// <param name="index"></param>
+		/// <returns></returns>
+		public IEquationSystemSolutionProxy GetSolutionProxy(int index)
+		{
+			return adapter.GetSolutionProxy(index);
+		}
+
+		/// <summary>Discards the recorded values, the base layer is then built again by stamping the devices.</summary>
+		public void Reset()
+		{
+			for (var i = 0; i < coefficients.Count; i++) coefficients[i].Reset();
+		}
+
+		/// <summary>Adds the recorded values to the decorated equation system.</summary>
+		public void Apply()
+		{
+			for (var i = 0; i < coefficients.Count; i++) coefficients[i].Apply();
+		}
+
+		private class CachedCoefficient : IEquationSystemCoefficientProxy
+		{
+			private readonly CoefficientSlot target;
+
+			// the rounding error of the sum is kept so that the extended precision systems receive the exact sum
+			private double error;
+			private double sum;
+
+			public CachedCoefficient(CoefficientSlot target)
+			{
+				this.target = target;
+			}
+
+			public void Add(double value)
+			{
+				var s = sum + value;
+				var v = s - sum;
+				error += sum - (s - v) + (value - v);
+				sum = s;
+			}
+
+			public void Reset()
+			{
+				sum = error = 0;
+			}
+
+			public void Apply()
+			{
+				if (sum == 0 && error == 0) return;
+
+				target.Add(sum);
+				if (error != 0 && !double.IsInfinity(sum)) target.Add(error);
+			}
+		}
+	}
+}
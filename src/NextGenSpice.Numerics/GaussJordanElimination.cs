@@ -20,6 +20,17 @@ namespace NextGenSpice.Numerics
 		[SuppressUnmanagedCodeSecurity]
 		private static extern void gauss_solve_double(double* mat, double* b, uint size);
 
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void gauss_solve_double_scalar(double* mat, double* b, uint size);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern int gauss_simd_enabled();
+
+		/// <summary>Whether the native double precision solver uses the vectorized AVX2/FMA kernel on this machine.</summary>
+		public static bool IsNativeSimdEnabled => gauss_simd_enabled() != 0;
+
 
 		[Conditional("trace_dumpmatrix")]
 		public static void PrintSystem<T>(Matrix<T> m, T[] b) where T : struct
@@ -143,6 +154,17 @@ namespace NextGenSpice.Numerics
 			b.CopyTo(x, 0);
 		}
 
+		public static void Solve_NativeScalar_double(Matrix<double> m, double[] b, double[] x)
+		{
+			fixed (double* mat = m.RawData)
+			fixed (double* rhs = b)
+			{
+				gauss_solve_double_scalar(mat, rhs, (uint) x.Length);
+			}
+
+			b.CopyTo(x, 0);
+		}
+
 
 #if qd_precision
 		/// <summary>Solves system of linear equations in the form A*x=b.</summary>
@@ -162,9 +184,10 @@ namespace NextGenSpice.Numerics
 
 		public static void Solve_Managed_qd(Matrix<qd_real> m, qd_real[] b, qd_real[] x)
 		{
+			// the sign of the number is the sign of the leading component, negate without calling native code
 			qd_real Abs(qd_real val)
 			{
-				return val > qd_real.Zero ? val : -val;
+				return val.x0 >= 0 ? val : new qd_real(-val.x0, -val.x1, -val.x2, -val.x3);
 			}
 
 			var size = m.Size;
@@ -198,35 +221,24 @@ namespace NextGenSpice.Numerics
 				}
 
 
-				// eliminate current variable in all columns
+				// eliminate current variable in all columns, whole rows are updated by one native call
+				var pivotRow = m.GetRow(i).Slice(i);
 				for (var k = i + 1; k < size; k++)
 				{
 					if (m[k, i] == qd_real.Zero) continue; // skip elimination on zered rows
 
-					var c = -m[k, i] / m[i, i];
-					for (var j = i; j < size; j++)
-						if (i == j)
-							m[k, j] = qd_real.Zero;
-						else
-							m[k, j] += c * m[i, j];
+					var c = QdVector.RowUpdate(m.GetRow(k).Slice(i), pivotRow);
 					// b vector
 					b[k] += c * b[i];
 				}
 			}
 
 
-			// Solve equation Ax=b for an upper triangular matrix A
+			// Solve equation Ax=b for an upper triangular matrix A, row by row
 			for (var i = size - 1; i >= 0; i--)
 			{
-				if (b[i] == qd_real.Zero)
-					continue;
-				// normalize
-				b[i] /= m[i, i];
-				//m[i, i] = 1;
-				// backward elimination
-				for (var k = i - 1; k >= 0; k--)
-					b[k] -= m[k, i] * b[i];
-				//m[k, i] = 0;
+				var sum = b[i] - QdVector.Dot(m.GetRow(i).Slice(i + 1), new ReadOnlySpan<qd_real>(b, i + 1, size - i - 1));
+				b[i] = sum == qd_real.Zero ? qd_real.Zero : sum / m[i, i];
 			}
 
 			b.CopyTo(x, 0);
@@ -268,9 +280,10 @@ namespace NextGenSpice.Numerics
 
 		public static void Solve_Managed_dd(Matrix<dd_real> m, dd_real[] b, dd_real[] x)
 		{
+			// the sign of the number is the sign of the leading component, negate without calling native code
 			dd_real Abs(dd_real val)
 			{
-				return val > dd_real.Zero ? val : -val;
+				return val.x0 >= 0 ? val : new dd_real(-val.x0, -val.x1);
 			}
 
 			var size = m.Size;
@@ -304,35 +317,24 @@ namespace NextGenSpice.Numerics
 					b[i] = tmp;
 				}
 
-				// eliminate current variable in all columns
+				// eliminate current variable in all columns, whole rows are updated by one native call
+				var pivotRow = m.GetRow(i).Slice(i);
 				for (var k = i + 1; k < size; k++)
 				{
 					if (m[k, i] == dd_real.Zero) continue; // skip elimination on zered rows
 
-					var c = -m[k, i] / m[i, i];
-					for (var j = i; j < size; j++)
-						if (i == j)
-							m[k, j] = dd_real.Zero;
-						else
-							m[k, j] += c * m[i, j];
+					var c = DdVector.RowUpdate(m.GetRow(k).Slice(i), pivotRow);
 					// b vector
 					b[k] += c * b[i];
 				}
 			}
 
 
-			// Solve equation Ax=b for an upper triangular matrix A
+			// Solve equation Ax=b for an upper triangular matrix A, row by row
 			for (var i = size - 1; i >= 0; i--)
 			{
-				if (b[i] == dd_real.Zero)
-					continue;
-				// normalize
-				b[i] /= m[i, i];
-				//m[i, i] = 1;
-				// backward elimination
-				for (var k = i - 1; k >= 0; k--)
-					b[k] -= m[k, i] * b[i];
-				//m[k, i] = 0;
+				var sum = b[i] - DdVector.Dot(m.GetRow(i).Slice(i + 1), new ReadOnlySpan<dd_real>(b, i + 1, size - i - 1));
+				b[i] = sum == dd_real.Zero ? dd_real.Zero : sum / m[i, i];
 			}
 
 			b.CopyTo(x, 0);
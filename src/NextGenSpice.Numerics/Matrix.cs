@@ -24,6 +24,14 @@ namespace NextGenSpice.Numerics
 			set => RawData[row * Size + col] = value;
 		}
 
+		/// <summary>Returns the given row of the matrix as a span over the <see cref="RawData" />.</summary>
+		/// <param name="row">Index of the row.</param>
+		/// <returns></returns>
+		public Span<T> GetRow(int row)
+		{
+			return new Span<T>(RawData, row * Size, Size);
+		}
+
 		/// <summary>Creates a new object that is a copy of the current instance.</summary>
 		/// <returns></returns>
 		object ICloneable.Clone()
@@ -0,0 +1,139 @@
+using System;
+using System.Runtime.InteropServices;
+using System.Security;
+using NextGenSpice.Numerics.Precision;
+
+namespace NextGenSpice.Numerics
+{
+	/// <summary>Precision of the LU factors used by the <see cref="MixedPrecisionSolver" />.</summary>
+	public enum FactorPrecision
+	{
+		Double = 0,
+		Single = 1
+	}
+
+#if dd_precision
+	/// <summary>
+	///   Solver for dense systems with double-double precision coefficients. The matrix is factored in lower precision
+	///   and the solution is improved by iterative refinement with residuals computed in double-double precision.
+	/// </summary>
+	public unsafe class MixedPrecisionSolver : IDisposable
+	{
+		// values of refinement_status enum in iterative_refinement.h
+		private const int StatusConverged = 0;
+		private const int StatusSingular = 2;
+
+		private IntPtr handle;
+
+		public MixedPrecisionSolver(int size, FactorPrecision precision = FactorPrecision.Double)
+		{
+			if (size <= 0) throw new ArgumentOutOfRangeException(nameof(size));
+			Size = size;
+			Precision = precision;
+			handle = precision == FactorPrecision.Double ? refine_create_double(size) : refine_create_float(size);
+		}
+
+		/// <summary>Number of rows or columns of the solved matrix.</summary>
+		public int Size { get; }
+
+		/// <summary>Precision of the LU factors.</summary>
+		public FactorPrecision Precision { get; }
+
+		/// <summary>Maximum number of refinement steps per solve.</summary>
+		public int MaxRefinementSteps { get; set; } = 10;
+
+		/// <summary>Target normwise backward error |b - A x| / (|A| |x| + |b|) of the solution.</summary>
+		public double Tolerance { get; set; } = 1e-24;
+
+		/// <summary>Number of refinement steps performed by the last solve.</summary>
+		public int LastRefinementSteps { get; private set; }
+
+		/// <summary>Backward error of the solution returned by the last solve.</summary>
+		public double LastBackwardError { get; private set; }
+
+		/// <summary>Performs application-defined tasks associated with freeing, releasing, or resetting unmanaged resources.</summary>
+		public void Dispose()
+		{
+			ReleaseHandle();
+			GC.SuppressFinalize(this);
+		}
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern IntPtr refine_create_double(int size);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern int refine_solve_double(IntPtr solver, dd_real* mat, dd_real* b, dd_real* x,
+			int maxSteps, double tolerance, out int steps, out double backwardError);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void refine_free_double(IntPtr solver);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern IntPtr refine_create_float(int size);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern int refine_solve_float(IntPtr solver, dd_real* mat, dd_real* b, dd_real* x,
+			int maxSteps, double tolerance, out int steps, out double backwardError);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void refine_free_float(IntPtr solver);
+
+		/// <summary>
+		///   Solves system of linear equations in the form A*x=b. If the matrix is singular, the solution is filled with
+		///   NaN. Returns false if the target backward error was not reached, the solution is the best one found in that
+		///   case.
+		/// </summary>
+		/// <param name="a">The A matrix, it is not modified.</param>
+		/// <param name="b">The right hand side vector b, it is not modified.</param>
+		/// <param name="x">The output array for solution x.</param>
+		/// <returns></returns>
+		public bool Solve(Matrix<dd_real> a, dd_real[] b, dd_real[] x)
+		{
+			if (handle == IntPtr.Zero) throw new ObjectDisposedException(nameof(MixedPrecisionSolver));
+			if (a.Size != Size) throw new ArgumentException("The matrix is of different size.");
+
+			int status, steps;
+			double backwardError;
+			fixed (dd_real* mat = a.RawData)
+			fixed (dd_real* rhs = b)
+			fixed (dd_real* sol = x)
+			{
+				status = Precision == FactorPrecision.Double
+					? refine_solve_double(handle, mat, rhs, sol, MaxRefinementSteps, Tolerance, out steps,
+						out backwardError)
+					: refine_solve_float(handle, mat, rhs, sol, MaxRefinementSteps, Tolerance, out steps,
+						out backwardError);
+			}
+
+			LastRefinementSteps = steps;
+			LastBackwardError = backwardError;
+
+			if (status == StatusSingular)
+				for (var i = 0; i < x.Length; i++) x[i] = new dd_real(double.NaN);
+
+			return status == StatusConverged;
+		}
+
+		private void ReleaseHandle()
+		{
+			if (handle == IntPtr.Zero) return;
+			if (Precision == FactorPrecision.Double)
+				refine_free_double(handle);
+			else
+				refine_free_float(handle);
+			handle = IntPtr.Zero;
+		}
+
+		~MixedPrecisionSolver()
+		{
+			ReleaseHandle();
+		}
+	}
+#endif
+}
@@ -0,0 +1,118 @@
+using System;
+using System.Runtime.InteropServices;
+using System.Security;
+
+namespace NextGenSpice.Numerics
+{
+	/// <summary>
+	///   LU factorization of a dense matrix in double precision computed by multiple threads in native code. The
+	///   factorization is recomputed only when the matrix differs from the previously factored one.
+	/// </summary>
+	public unsafe class ParallelLuFactorization : IDisposable
+	{
+		private IntPtr handle;
+
+		/// <summary>Creates a new instance of the <see cref="ParallelLuFactorization" /> class.</summary>
+		/// <param name="size">Number of rows or columns of the factored matrix.</param>
+		/// <param name="threadCount">Number of threads used for the factorization, 0 means number of hardware threads.</param>
+		/// <param name="serialCutoff">Matrices smaller than this are factored by the calling thread only.</param>
+		public ParallelLuFactorization(int size, int threadCount = 0, int serialCutoff = 200)
+		{
+			if (size <= 0) throw new ArgumentOutOfRangeException(nameof(size));
+			if (threadCount < 0) throw new ArgumentOutOfRangeException(nameof(threadCount));
+			if (serialCutoff < 0) throw new ArgumentOutOfRangeException(nameof(serialCutoff));
+
+			Size = size;
+			SerialCutoff = serialCutoff;
+			handle = parallel_lu_create(size, threadCount, serialCutoff);
+			ThreadCount = parallel_lu_thread_count(handle);
+		}
+
+		/// <summary>Number of rows or columns of the factored matrix.</summary>
+		public int Size { get; }
+
+		/// <summary>Number of threads used for the factorization, including the calling thread.</summary>
+		public int ThreadCount { get; }
+
+		/// <summary>Matrices smaller than this are factored by the calling thread only.</summary>
+		public int SerialCutoff { get; }
+
+		/// <summary>How many times the factorization was actually computed.</summary>
+		public int FactorizationCount { get; private set; }
+
+		/// <summary>Performs application-defined tasks associated with freeing, releasing, or resetting unmanaged resources.</summary>
+		public void Dispose()
+		{
+			ReleaseHandle();
+			GC.SuppressFinalize(this);
+		}
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern IntPtr parallel_lu_create(int size, int threads, int serialCutoff);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern int parallel_lu_factor(IntPtr lu, double* mat);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void parallel_lu_solve_factored(IntPtr lu, double* b);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern int parallel_lu_thread_count(IntPtr lu);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void parallel_lu_free(IntPtr lu);
+
+		/// <summary>
+		///   Factorizes the matrix unless it is the same as the last factored one. Returns true if the factorization was
+		///   recomputed.
+		/// </summary>
+		/// <param name="m">The matrix to be factored, it is not modified.</param>
+		/// <returns></returns>
+		public bool Factor(Matrix<double> m)
+		{
+			if (handle == IntPtr.Zero) throw new ObjectDisposedException(nameof(ParallelLuFactorization));
+			if (m.Size != Size) throw new ArgumentException("The matrix is of different size.");
+
+			bool factored;
+			fixed (double* mat = m.RawData)
+			{
+				factored = parallel_lu_factor(handle, mat) != 0;
+			}
+
+			if (factored) FactorizationCount++;
+			return factored;
+		}
+
+		/// <summary>Solves system of linear equations in the form A*x=b using the last computed factorization.</summary>
+		/// <param name="b">The right hand side vector b.</param>
+		/// <param name="x">The output array for solution x.</param>
+		public void Solve(double[] b, double[] x)
+		{
+			if (handle == IntPtr.Zero) throw new ObjectDisposedException(nameof(ParallelLuFactorization));
+			if (FactorizationCount == 0) throw new InvalidOperationException("Matrix must be factored before solving.");
+
+			b.CopyTo(x, 0);
+			fixed (double* rhs = x)
+			{
+				parallel_lu_solve_factored(handle, rhs);
+			}
+		}
+
+		private void ReleaseHandle()
+		{
+			if (handle == IntPtr.Zero) return;
+			parallel_lu_free(handle);
+			handle = IntPtr.Zero;
+		}
+
+		~ParallelLuFactorization()
+		{
+			ReleaseHandle();
+		}
+	}
+}
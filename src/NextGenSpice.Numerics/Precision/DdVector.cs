@@ -0,0 +1,168 @@
+using System;
+using System.Runtime.InteropServices;
+using System.Security;
+
+namespace NextGenSpice.Numerics.Precision
+{
+#if dd_precision
+	/// <summary>
+	///   Class containing operations over contiguous arrays of <see cref="dd_real" /> values. Each method crosses the
+	///   managed/native boundary only once for the whole array.
+	/// </summary>
+	public static unsafe class DdVector
+	{
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.Cdecl)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void dd_array_axpy(ref dd_real a, dd_real* x, dd_real* y, int count);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.Cdecl)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void dd_array_dot(dd_real* x, dd_real* y, int count, out dd_real result);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.Cdecl)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void dd_array_add(dd_real* self, dd_real* val, int count);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.Cdecl)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void dd_array_mul(dd_real* self, dd_real* val, int count);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.Cdecl)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void dd_array_fma(dd_real* self, dd_real* x, dd_real* y, int count);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.Cdecl)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void dd_array_div(dd_real* self, dd_real* val, int count);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.Cdecl)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void dd_array_row_update(dd_real* row, dd_real* pivotRow, int count, out dd_real factor);
+
+		private static void CheckLength(int expected, int actual)
+		{
+			if (expected != actual) throw new ArgumentException("The arrays are of different size.");
+		}
+
+		/// <summary>Computes y += a * x.</summary>
+		/// <param name="a">The scalar multiplier.</param>
+		/// <param name="x">The added vector.</param>
+		/// <param name="y">The vector to be updated.</param>
+		public static void Axpy(dd_real a, ReadOnlySpan<dd_real> x, Span<dd_real> y)
+		{
+			CheckLength(x.Length, y.Length);
+			if (y.IsEmpty) return;
+
+			fixed (dd_real* px = x)
+			fixed (dd_real* py = y)
+			{
+				dd_array_axpy(ref a, px, py, y.Length);
+			}
+		}
+
+		/// <summary>Computes dot product of two vectors.</summary>
+		/// <param name="x">The first vector.</param>
+		/// <param name="y">The second vector.</param>
+		/// <returns></returns>
+		public static dd_real Dot(ReadOnlySpan<dd_real> x, ReadOnlySpan<dd_real> y)
+		{
+			CheckLength(x.Length, y.Length);
+			if (x.IsEmpty) return dd_real.Zero;
+
+			dd_real result;
+			fixed (dd_real* px = x)
+			fixed (dd_real* py = y)
+			{
+				dd_array_dot(px, py, x.Length, out result);
+			}
+
+			return result;
+		}
+
+		/// <summary>Adds values elementwise: self[i] += val[i].</summary>
+		/// <param name="self">The vector to be updated.</param>
+		/// <param name="val">The added values.</param>
+		public static void Add(Span<dd_real> self, ReadOnlySpan<dd_real> val)
+		{
+			CheckLength(self.Length, val.Length);
+			if (self.IsEmpty) return;
+
+			fixed (dd_real* ps = self)
+			fixed (dd_real* pv = val)
+			{
+				dd_array_add(ps, pv, self.Length);
+			}
+		}
+
+		/// <summary>Multiplies values elementwise: self[i] *= val[i].</summary>
+		/// <param name="self">The vector to be updated.</param>
+		/// <param name="val">The multipliers.</param>
+		public static void Multiply(Span<dd_real> self, ReadOnlySpan<dd_real> val)
+		{
+			CheckLength(self.Length, val.Length);
+			if (self.IsEmpty) return;
+
+			fixed (dd_real* ps = self)
+			fixed (dd_real* pv = val)
+			{
+				dd_array_mul(ps, pv, self.Length);
+			}
+		}
+
+		/// <summary>Adds elementwise products: self[i] += x[i] * y[i].</summary>
+		/// <param name="self">The vector to be updated.</param>
+		/// <param name="x">The first factors.</param>
+		/// <param name="y">The second factors.</param>
+		public static void MultiplyAdd(Span<dd_real> self, ReadOnlySpan<dd_real> x, ReadOnlySpan<dd_real> y)
+		{
+			CheckLength(self.Length, x.Length);
+			CheckLength(self.Length, y.Length);
+			if (self.IsEmpty) return;
+
+			fixed (dd_real* ps = self)
+			fixed (dd_real* px = x)
+			fixed (dd_real* py = y)
+			{
+				dd_array_fma(ps, px, py, self.Length);
+			}
+		}
+
+		/// <summary>Divides values elementwise: self[i] /= val[i].</summary>
+		/// <param name="self">The vector to be updated.</param>
+		/// <param name="val">The divisors.</param>
+		public static void Divide(Span<dd_real> self, ReadOnlySpan<dd_real> val)
+		{
+			CheckLength(self.Length, val.Length);
+			if (self.IsEmpty) return;
+
+			fixed (dd_real* ps = self)
+			fixed (dd_real* pv = val)
+			{
+				dd_array_div(ps, pv, self.Length);
+			}
+		}
+
+		/// <summary>
+		///   Eliminates the first entry of the row using the pivot row as in Gaussian elimination: row += factor *
+		///   pivotRow, where factor = -row[0] / pivotRow[0]. The first entry of the row is set to zero.
+		/// </summary>
+		/// <param name="row">The row to be updated.</param>
+		/// <param name="pivotRow">The pivot row, its first entry is the pivot.</param>
+		/// <returns>The factor used for the update.</returns>
+		public static dd_real RowUpdate(Span<dd_real> row, ReadOnlySpan<dd_real> pivotRow)
+		{
+			CheckLength(row.Length, pivotRow.Length);
+			if (row.IsEmpty) throw new ArgumentException("The row must not be empty.", nameof(row));
+
+			dd_real factor;
+			fixed (dd_real* pr = row)
+			fixed (dd_real* pp = pivotRow)
+			{
+				dd_array_row_update(pr, pp, row.Length, out factor);
+			}
+
+			return factor;
+		}
+	}
+#endif
+}
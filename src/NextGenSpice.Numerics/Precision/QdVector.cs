@@ -0,0 +1,168 @@
+using System;
+using System.Runtime.InteropServices;
+using System.Security;
+
+namespace NextGenSpice.Numerics.Precision
+{
+#if qd_precision
+	/// <summary>
+	///   Class containing operations over contiguous arrays of <see cref="qd_real" /> values. Each method crosses the
+	///   managed/native boundary only once for the whole array.
+	/// </summary>
+	public static unsafe class QdVector
+	{
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.Cdecl)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void qd_array_axpy(ref qd_real a, qd_real* x, qd_real* y, int count);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.Cdecl)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void qd_array_dot(qd_real* x, qd_real* y, int count, out qd_real result);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.Cdecl)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void qd_array_add(qd_real* self, qd_real* val, int count);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.Cdecl)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void qd_array_mul(qd_real* self, qd_real* val, int count);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.Cdecl)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void qd_array_fma(qd_real* self, qd_real* x, qd_real* y, int count);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.Cdecl)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void qd_array_div(qd_real* self, qd_real* val, int count);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.Cdecl)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void qd_array_row_update(qd_real* row, qd_real* pivotRow, int count, out qd_real factor);
+
+		private static void CheckLength(int expected, int actual)
+		{
+			if (expected != actual) throw new ArgumentException("The arrays are of different size.");
+		}
+
+		/// <summary>Computes y += a * x.</summary>
+		/// <param name="a">The scalar multiplier.</param>
+		/// <param name="x">The added vector.</param>
+		/// <param name="y">The vector to be updated.</param>
+		public static void Axpy(qd_real a, ReadOnlySpan<qd_real> x, Span<qd_real> y)
+		{
+			CheckLength(x.Length, y.Length);
+			if (y.IsEmpty) return;
+
+			fixed (qd_real* px = x)
+			fixed (qd_real* py = y)
+			{
+				qd_array_axpy(ref a, px, py, y.Length);
+			}
+		}
+
+		/// <summary>Computes dot product of two vectors.</summary>
+		/// <param name="x">The first vector.</param>
+		/// <param name="y">The second vector.</param>
+		/// <returns></returns>
+		public static qd_real Dot(ReadOnlySpan<qd_real> x, ReadOnlySpan<qd_real> y)
+		{
+			CheckLength(x.Length, y.Length);
+			if (x.IsEmpty) return qd_real.Zero;
+
+			qd_real result;
+			fixed (qd_real* px = x)
+			fixed (qd_real* py = y)
+			{
+				qd_array_dot(px, py, x.Length, out result);
+			}
+
+			return result;
+		}
+
+		/// <summary>Adds values elementwise: self[i] += val[i].</summary>
+		/// <param name="self">The vector to be updated.</param>
+		/// <param name="val">The added values.</param>
+		public static void Add(Span<qd_real> self, ReadOnlySpan<qd_real> val)
+		{
+			CheckLength(self.Length, val.Length);
+			if (self.IsEmpty) return;
+
+			fixed (qd_real* ps = self)
+			fixed (qd_real* pv = val)
+			{
+				qd_array_add(ps, pv, self.Length);
+			}
+		}
+
+		/// <summary>Multiplies values elementwise: self[i] *= val[i].</summary>
+		/// <param name="self">The vector to be updated.</param>
+		/// <param name="val">The multipliers.</param>
+		public static void Multiply(Span<qd_real> self, ReadOnlySpan<qd_real> val)
+		{
+			CheckLength(self.Length, val.Length);
+			if (self.IsEmpty) return;
+
+			fixed (qd_real* ps = self)
+			fixed (qd_real* pv = val)
+			{
+				qd_array_mul(ps, pv, self.Length);
+			}
+		}
+
+		/// <summary>Adds elementwise products: self[i] += x[i] * y[i].</summary>
+		/// <param name="self">The vector to be updated.</param>
+		/// <param name="x">The first factors.</param>
+		/// <param name="y">The second factors.</param>
+		public static void MultiplyAdd(Span<qd_real> self, ReadOnlySpan<qd_real> x, ReadOnlySpan<qd_real> y)
+		{
+			CheckLength(self.Length, x.Length);
+			CheckLength(self.Length, y.Length);
+			if (self.IsEmpty) return;
+
+			fixed (qd_real* ps = self)
+			fixed (qd_real* px = x)
+			fixed (qd_real* py = y)
+			{
+				qd_array_fma(ps, px, py, self.Length);
+			}
+		}
+
+		/// <summary>Divides values elementwise: self[i] /= val[i].</summary>
+		/// <param name="self">The vector to be updated.</param>
+		/// <param name="val">The divisors.</param>
+		public static void Divide(Span<qd_real> self, ReadOnlySpan<qd_real> val)
+		{
+			CheckLength(self.Length, val.Length);
+			if (self.IsEmpty) return;
+
+			fixed (qd_real* ps = self)
+			fixed (qd_real* pv = val)
+			{
+				qd_array_div(ps, pv, self.Length);
+			}
+		}
+
+		/// <summary>
+		///   Eliminates the first entry of the row using the pivot row as in Gaussian elimination: row += factor *
+		///   pivotRow, where factor = -row[0] / pivotRow[0]. The first entry of the row is set to zero.
+		/// </summary>
+		/// <param name="row">The row to be updated.</param>
+		/// <param name="pivotRow">The pivot row, its first entry is the pivot.</param>
+		/// <returns>The factor used for the update.</returns>
+		public static qd_real RowUpdate(Span<qd_real> row, ReadOnlySpan<qd_real> pivotRow)
+		{
+			CheckLength(row.Length, pivotRow.Length);
+			if (row.IsEmpty) throw new ArgumentException("The row must not be empty.", nameof(row));
+
+			qd_real factor;
+			fixed (qd_real* pr = row)
+			fixed (qd_real* pp = pivotRow)
+			{
+				qd_array_row_update(pr, pp, row.Length, out factor);
+			}
+
+			return factor;
+		}
+	}
+#endif
+}
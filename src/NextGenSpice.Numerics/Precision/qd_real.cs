@@ -187,6 +187,28 @@ namespace NextGenSpice.Numerics.Precision
 			return d;
 		}
 
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.Cdecl)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void qd_exp(ref qd_real self);
+
+		public qd_real Exp()
+		{
+			var d = this;
+			qd_exp(ref d);
+			return d;
+		}
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.Cdecl)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void qd_log(ref qd_real self);
+
+		public qd_real Log()
+		{
+			var d = this;
+			qd_log(ref d);
+			return d;
+		}
+
 		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.Cdecl)]
 		[return: MarshalAs(UnmanagedType.BStr)]
 		[SuppressUnmanagedCodeSecurity]
@@ -0,0 +1,76 @@
+using System;
+using System.Runtime.InteropServices;
+using System.Security;
+
+namespace NextGenSpice.Numerics
+{
+	/// <summary>Result of the <see cref="SolutionUpdate.Apply" /> method.</summary>
+	public enum SolutionStatus
+	{
+		/// <summary>Some of the values differ from the previous ones by more than the tolerance.</summary>
+		NotConverged = 0,
+
+		/// <summary>All values are within tolerance from the previous ones.</summary>
+		Converged = 1,
+
+		/// <summary>The solution contains NaN or infinity, e.g. because the equation matrix was singular.</summary>
+		NotFinite = -1
+	}
+
+	/// <summary>
+	///   Performs the check of the equation system solution and the update of the node values in a single native
+	///   pass over the solution.
+	/// </summary>
+	public static unsafe class SolutionUpdate
+	{
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern int solution_update(double* x, int count, double* nodes, int nodeCount, double abstol,
+			double reltol, double* updateNorm);
+
+		/// <summary>
+		///   Checks that the solution contains only finite values, copies the leading part of the solution into the
+		///   node values and returns whether the values are within tolerance from the previous node values. The node
+		///   values are not modified if the solution contains NaN or infinity.
+		/// </summary>
+		/// <param name="solution">Solution of the equation system.</param>
+		/// <param name="nodeValues">Values to be compared with and replaced by the leading part of the solution.</param>
+		/// <param name="abstol">Absolute tolerance.</param>
+		/// <param name="reltol">Relative tolerance.</param>
+		/// <returns></returns>
+		public static SolutionStatus Apply(double[] solution, double[] nodeValues, double abstol, double reltol)
+		{
+			return Apply(solution, nodeValues, abstol, reltol, out _);
+		}
+
+		/// <summary>
+		///   Checks that the solution contains only finite values, copies the leading part of the solution into the
+		///   node values and returns whether the values are within tolerance from the previous node values. The node
+		///   values are not modified if the solution contains NaN or infinity.
+		/// </summary>
+		/// <param name="solution">Solution of the equation system.</param>
+		/// <param name="nodeValues">Values to be compared with and replaced by the leading part of the solution.</param>
+		/// <param name="abstol">Absolute tolerance.</param>
+		/// <param name="reltol">Relative tolerance.</param>
+		/// <param name="updateNorm">Largest absolute change of the node values, NaN if the solution is not finite.</param>
+		/// <returns></returns>
+		public static SolutionStatus Apply(double[] solution, double[] nodeValues, double abstol, double reltol,
+			out double updateNorm)
+		{
+			if (nodeValues.Length > solution.Length)
+				throw new ArgumentException("The solution must contain values for all nodes.");
+
+			var norm = double.NaN;
+			SolutionStatus status;
+			fixed (double* x = solution)
+			fixed (double* nodes = nodeValues)
+			{
+				status = (SolutionStatus) solution_update(x, solution.Length, nodes, nodeValues.Length, abstol, reltol,
+					&norm);
+			}
+
+			updateNorm = norm;
+			return status;
+		}
+	}
+}
@@ -0,0 +1,226 @@
+﻿using System;
+using System.Linq;
+using System.Runtime.InteropServices;
+using System.Security;
+
+namespace NextGenSpice.Numerics
+{
+	/// <summary>
+	///   Sparse LU factorization of a matrix with fixed nonzero pattern. The symbolic analysis of the pattern is done once
+	///   on construction, subsequent factorizations reuse the ordering and, while the pivots stay acceptable, also the
+	///   pivot sequence and the pattern of the factors.
+	/// </summary>
+	public unsafe class SparseLuFactorization : IDisposable
+	{
+		// values of sparse_status enum in sparse_lu.h
+		private const int StatusOk = 0;
+
+		// values of sparse_format enum in sparse_lu.h
+		private const int FormatCsc = 0;
+
+		private readonly SparseMatrix<double> matrix;
+		private IntPtr handle;
+
+		/// <summary>Creates new factorization and analyzes the pattern of the matrix.</summary>
+		/// <param name="matrix">Matrix to be factored, only its values may change between factorizations.</param>
+		/// <param name="ordering">Column ordering used to reduce fill-in.</param>
+		/// <param name="pivotTolerance">
+		///   Diagonal entry is accepted as a pivot if its magnitude is at least this fraction of the largest entry in the
+		///   column. Must be in (0, 1].
+		/// </param>
+		public SparseLuFactorization(SparseMatrix<double> matrix, SparseOrdering ordering = SparseOrdering.MinimumDegree,
+			double pivotTolerance = 0.1)
+		{
+			this.matrix = matrix ?? throw new ArgumentNullException(nameof(matrix));
+			if (!(pivotTolerance > 0 && pivotTolerance <= 1)) throw new ArgumentOutOfRangeException(nameof(pivotTolerance));
+
+			fixed (int* ptr = matrix.ColumnPointers)
+			fixed (int* ind = matrix.RowIndices)
+			{
+				handle = sparse_analyze_double(matrix.Size, ptr, ind, FormatCsc, (int) ordering, pivotTolerance);
+			}
+
+			if (handle == IntPtr.Zero) throw new ArgumentException("Invalid sparse matrix structure.");
+
+			PredictedNonzeroCount = sparse_predicted_nonzeros_double(handle);
+		}
+
+		/// <summary>Whether the last call to <see cref="Factor" /> succeeded and the factors can be used for solving.</summary>
+		public bool IsFactored { get; private set; }
+
+		/// <summary>
+		///   Number of entries of L and U factors predicted by the symbolic analysis. The prediction is exact if all
+		///   diagonal pivots are accepted.
+		/// </summary>
+		public int PredictedNonzeroCount { get; }
+
+		/// <summary>Number of entries of L and U factors after the last factorization.</summary>
+		public int NonzeroCount => handle == IntPtr.Zero ? 0 : sparse_factor_nonzeros_double(handle);
+
+		/// <summary>Number of columns of the factors computed by the last factorization.</summary>
+		public int LastComputedColumnCount { get; private set; }
+
+		/// <summary>Total number of columns of the factors computed by all factorizations.</summary>
+		public long ComputedColumnCount { get; private set; }
+
+		/// <summary>
+		///   Total number of columns of the factors which were kept from the previous factorization because they did
+		///   not depend on any changed value.
+		/// </summary>
+		public long ReusedColumnCount { get; private set; }
+
+		/// <summary>Performs application-defined tasks associated with freeing, releasing, or resetting unmanaged resources.</summary>
+		public void Dispose()
+		{
+			ReleaseHandle();
+			GC.SuppressFinalize(this);
+		}
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern IntPtr sparse_analyze_double(int size, int* ptr, int* ind, int format, int ordering,
+			double pivotTolerance);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern int sparse_factor_double(IntPtr lu, double* values);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void sparse_solve_factored_double(IntPtr lu, double* b);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern int sparse_factor_partial_double(IntPtr lu, double* values, int* changed, int count);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern int sparse_computed_columns_double(IntPtr lu);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern int sparse_predicted_nonzeros_double(IntPtr lu);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern int sparse_factor_nonzeros_double(IntPtr lu);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void sparse_free_double(IntPtr lu);
+
+		/// <summary>Factorizes the current values of the matrix. Returns false if the matrix is singular.</summary>
+		/// <returns></returns>
+		public bool Factor()
+		{
+			if (handle == IntPtr.Zero) throw new ObjectDisposedException(nameof(SparseLuFactorization));
+
+			fixed (double* values = matrix.Values)
+			{
+				IsFactored = sparse_factor_double(handle, values) == StatusOk;
+			}
+
+			UpdateCounters();
+			return IsFactored;
+		}
+
+		/// <summary>
+		///   Factorizes the current values of the matrix, which differ from the values of the last successful
+		///   factorization only at given positions. Only the columns of the factors depending on these values are
+		///   recomputed while the pivot sequence stays acceptable. Returns false if the matrix is singular.
+		/// </summary>
+		/// <param name="changedSlots">Indices into <see cref="SparseMatrix{T}.Values" /> of the changed values.</param>
+		/// <returns></returns>
+		public bool Factor(int[] changedSlots)
+		{
+			if (handle == IntPtr.Zero) throw new ObjectDisposedException(nameof(SparseLuFactorization));
+			if (changedSlots.Any(i => i < 0 || i >= matrix.NonzeroCount))
+				throw new ArgumentOutOfRangeException(nameof(changedSlots));
+
+			fixed (double* values = matrix.Values)
+			fixed (int* changed = changedSlots)
+			{
+				return Factor(values, changed, changedSlots.Length);
+			}
+		}
+
+		/// <summary>
+		///   Factorizes matrix with the pattern given at construction and values stored in native memory. Returns false if
+		///   the matrix is singular.
+		/// </summary>
+		/// <param name="values">Values of the matrix entries in the order of the pattern.</param>
+		/// <returns></returns>
+		internal bool Factor(double* values)
+		{
+			if (handle == IntPtr.Zero) throw new ObjectDisposedException(nameof(SparseLuFactorization));
+
+			IsFactored = sparse_factor_double(handle, values) == StatusOk;
+			UpdateCounters();
+			return IsFactored;
+		}
+
+		/// <summary>
+		///   Factorizes matrix stored in native memory whose values differ from the last successfully factored ones only
+		///   at given positions. Returns false if the matrix is singular.
+		/// </summary>
+		/// <param name="values">Values of the matrix entries in the order of the pattern.</param>
+		/// <param name="changed">Indices of the changed values.</param>
+		/// <param name="count">Number of the changed values.</param>
+		/// <returns></returns>
+		internal bool Factor(double* values, int* changed, int count)
+		{
+			if (handle == IntPtr.Zero) throw new ObjectDisposedException(nameof(SparseLuFactorization));
+
+			IsFactored = sparse_factor_partial_double(handle, values, changed, count) == StatusOk;
+			UpdateCounters();
+			return IsFactored;
+		}
+
+		private void UpdateCounters()
+		{
+			LastComputedColumnCount = sparse_computed_columns_double(handle);
+			ComputedColumnCount += LastComputedColumnCount;
+			ReusedColumnCount += matrix.Size - LastComputedColumnCount;
+		}
+
+		/// <summary>Solves system of linear equations in the form A*x=b using the last computed factorization.</summary>
+		/// <param name="b">The right hand side vector b.</param>
+		/// <param name="x">The output array for solution x.</param>
+		public void Solve(double[] b, double[] x)
+		{
+			if (handle == IntPtr.Zero) throw new ObjectDisposedException(nameof(SparseLuFactorization));
+			if (!IsFactored) throw new InvalidOperationException("Matrix must be successfully factored before solving.");
+
+			b.CopyTo(x, 0);
+			fixed (double* rhs = x)
+			{
+				sparse_solve_factored_double(handle, rhs);
+			}
+		}
+
+		/// <summary>Solves the system using the last computed factorization, b is overwritten by the solution.</summary>
+		/// <param name="b">The right hand side vector b.</param>
+		internal void SolveInPlace(double[] b)
+		{
+			if (handle == IntPtr.Zero) throw new ObjectDisposedException(nameof(SparseLuFactorization));
+			if (!IsFactored) throw new InvalidOperationException("Matrix must be successfully factored before solving.");
+
+			fixed (double* rhs = b)
+			{
+				sparse_solve_factored_double(handle, rhs);
+			}
+		}
+
+		private void ReleaseHandle()
+		{
+			if (handle == IntPtr.Zero) return;
+			sparse_free_double(handle);
+			handle = IntPtr.Zero;
+		}
+
+		~SparseLuFactorization()
+		{
+			ReleaseHandle();
+		}
+	}
+}
@@ -0,0 +1,116 @@
+﻿using System;
+using System.Runtime.InteropServices;
+using System.Security;
+using NextGenSpice.Numerics.Precision;
+
+namespace NextGenSpice.Numerics
+{
+	/// <summary>Class containing static methods for solving sparse systems of linear equations using native sparse LU factorization.</summary>
+	public static unsafe class SparseLuSolver
+	{
+		// values of sparse_status enum in sparse_lu.h
+		private const int StatusOk = 0;
+		private const int StatusSingular = 1;
+
+		// values of sparse_format enum in sparse_lu.h
+		private const int FormatCsc = 0;
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern int sparse_solve_double(int size, int* ptr, int* ind, double* values, double* b,
+			int format);
+
+		/// <summary>
+		///   Solves system of linear equations in the form A*x=b. If the matrix is singular, the solution is filled with
+		///   NaN.
+		/// </summary>
+		/// <param name="a">The A matrix.</param>
+		/// <param name="b">The right hand side vector b.</param>
+		/// <param name="x">The output array for solution x.</param>
+		public static void Solve(SparseMatrix<double> a, double[] b, double[] x)
+		{
+			b.CopyTo(x, 0);
+
+			int status;
+			fixed (int* ptr = a.ColumnPointers)
+			fixed (int* ind = a.RowIndices)
+			fixed (double* values = a.Values)
+			fixed (double* rhs = x)
+			{
+				status = sparse_solve_double(a.Size, ptr, ind, values, rhs, FormatCsc);
+			}
+
+			if (IsSingular(status))
+				for (var i = 0; i < x.Length; i++) x[i] = double.NaN;
+		}
+
+		private static bool IsSingular(int status)
+		{
+			if (status != StatusOk && status != StatusSingular)
+				throw new ArgumentException("Invalid sparse matrix structure.");
+			return status == StatusSingular;
+		}
+
+#if dd_precision
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern int sparse_solve_dd(int size, int* ptr, int* ind, dd_real* values, dd_real* b,
+			int format);
+
+		/// <summary>
+		///   Solves system of linear equations in the form A*x=b. If the matrix is singular, the solution is filled with
+		///   NaN.
+		/// </summary>
+		/// <param name="a">The A matrix.</param>
+		/// <param name="b">The right hand side vector b.</param>
+		/// <param name="x">The output array for solution x.</param>
+		public static void Solve(SparseMatrix<dd_real> a, dd_real[] b, dd_real[] x)
+		{
+			b.CopyTo(x, 0);
+
+			int status;
+			fixed (int* ptr = a.ColumnPointers)
+			fixed (int* ind = a.RowIndices)
+			fixed (dd_real* values = a.Values)
+			fixed (dd_real* rhs = x)
+			{
+				status = sparse_solve_dd(a.Size, ptr, ind, values, rhs, FormatCsc);
+			}
+
+			if (IsSingular(status))
+				for (var i = 0; i < x.Length; i++) x[i] = new dd_real(double.NaN);
+		}
+#endif
+
+#if qd_precision
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern int sparse_solve_qd(int size, int* ptr, int* ind, qd_real* values, qd_real* b,
+			int format);
+
+		/// <summary>
+		///   Solves system of linear equations in the form A*x=b. If the matrix is singular, the solution is filled with
+		///   NaN.
+		/// </summary>
+		/// <param name="a">The A matrix.</param>
+		/// <param name="b">The right hand side vector b.</param>
+		/// <param name="x">The output array for solution x.</param>
+		public static void Solve(SparseMatrix<qd_real> a, qd_real[] b, qd_real[] x)
+		{
+			b.CopyTo(x, 0);
+
+			int status;
+			fixed (int* ptr = a.ColumnPointers)
+			fixed (int* ind = a.RowIndices)
+			fixed (qd_real* values = a.Values)
+			fixed (qd_real* rhs = x)
+			{
+				status = sparse_solve_qd(a.Size, ptr, ind, values, rhs, FormatCsc);
+			}
+
+			if (IsSingular(status))
+				for (var i = 0; i < x.Length; i++) x[i] = new qd_real(double.NaN);
+		}
+#endif
+	}
+}
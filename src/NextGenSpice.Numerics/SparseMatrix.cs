@@ -0,0 +1,92 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+
+namespace NextGenSpice.Numerics
+{
+	/// <summary>
+	///   Class that represents square sparse matrix of given size in compressed sparse column format. The nonzero pattern
+	///   is fixed at construction time, only values of the entries can change.
+	/// </summary>
+	/// <typeparam name="T">Type of the matrix entries.</typeparam>
+	public class SparseMatrix<T>
+	{
+		public SparseMatrix(int size, int[] columnPointers, int[] rowIndices)
+		{
+			if (size <= 0) throw new ArgumentOutOfRangeException(nameof(size));
+			if (columnPointers.Length != size + 1)
+				throw new ArgumentException("Column pointer array must have size + 1 elements.", nameof(columnPointers));
+			if (rowIndices.Length != columnPointers[size])
+				throw new ArgumentException("Row index array does not match the column pointers.", nameof(rowIndices));
+
+			Size = size;
+			ColumnPointers = columnPointers;
+			RowIndices = rowIndices;
+			Values = new T[rowIndices.Length];
+		}
+
+		/// <summary>Number of rows or columns in the matrix.</summary>
+		public int Size { get; }
+
+		/// <summary>Number of explicitly stored entries.</summary>
+		public int NonzeroCount => RowIndices.Length;
+
+		/// <summary>Entries of j-th column are stored on indices [ColumnPointers[j], ColumnPointers[j + 1]).</summary>
+		public int[] ColumnPointers { get; }
+
+		/// <summary>Row index of each stored entry, sorted within each column.</summary>
+		public int[] RowIndices { get; }
+
+		/// <summary>Values of the stored entries in the same order as <see cref="RowIndices" />.</summary>
+		public T[] Values { get; }
+
+		public T this[int row, int col]
+		{
+			get
+			{
+				var index = IndexOf(row, col);
+				return index < 0 ? default(T) : Values[index];
+			}
+			set
+			{
+				var index = IndexOf(row, col);
+				if (index < 0) throw new InvalidOperationException($"Entry [{row}, {col}] is not part of the pattern.");
+				Values[index] = value;
+			}
+		}
+
+		/// <summary>Returns index of the entry at given coordinates in the <see cref="Values" /> array or -1 if it is not stored.</summary>
+		/// <param name="row">Row coordinate.</param>
+		/// <param name="col">Column coordinate.</param>
+		/// <returns></returns>
+		public int IndexOf(int row, int col)
+		{
+			var start = ColumnPointers[col];
+			var index = Array.BinarySearch(RowIndices, start, ColumnPointers[col + 1] - start, row);
+			return index < 0 ? -1 : index;
+		}
+
+		/// <summary>Creates matrix of given size whose pattern consists of given entries, duplicates are ignored.</summary>
+		/// <param name="size">Number of rows or columns of the matrix.</param>
+		/// <param name="entries">Coordinates of the entries in the pattern.</param>
+		/// <returns></returns>
+		public static SparseMatrix<T> FromCoordinates(int size, IEnumerable<(int row, int col)> entries)
+		{
+			var columns = Enumerable.Range(0, size).Select(_ => new SortedSet<int>()).ToArray();
+			foreach (var (row, col) in entries)
+			{
+				if (row < 0 || row >= size) throw new ArgumentOutOfRangeException(nameof(entries));
+				if (col < 0 || col >= size) throw new ArgumentOutOfRangeException(nameof(entries));
+				columns[col].Add(row);
+			}
+
+			var columnPointers = new int[size + 1];
+			for (var j = 0; j < size; j++) columnPointers[j + 1] = columnPointers[j] + columns[j].Count;
+
+			var rowIndices = new int[columnPointers[size]];
+			for (var j = 0; j < size; j++) columns[j].CopyTo(rowIndices, columnPointers[j]);
+
+			return new SparseMatrix<T>(size, columnPointers, rowIndices);
+		}
+	}
+}
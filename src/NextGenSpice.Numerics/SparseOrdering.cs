@@ -0,0 +1,12 @@
+﻿namespace NextGenSpice.Numerics
+{
+	/// <summary>Column ordering used by the sparse LU factorization.</summary>
+	public enum SparseOrdering
+	{
+		/// <summary>Variables are eliminated in their natural order.</summary>
+		Natural = 0,
+
+		/// <summary>Minimum degree ordering of the pattern of A + A^T, reduces the fill-in of the factors.</summary>
+		MinimumDegree = 1
+	}
+}
@@ -0,0 +1,130 @@
+using System;
+using System.Runtime.InteropServices;
+using System.Security;
+using NextGenSpice.Numerics.Equations;
+
+namespace NextGenSpice.Numerics
+{
+	/// <summary>
+	///   Flat natively allocated array of equation system values with fixed slot for each coefficient. The matrix
+	///   entries are stored in the same order as the values of the sparse matrix pattern so that the native solver can
+	///   use them in place, the right hand side follows on the next cache line boundary.
+	/// </summary>
+	public unsafe class StampMap : IDisposable
+	{
+		// both parts of the array start at 64-byte boundary
+		private const int Alignment = 64 / sizeof(double);
+
+		private readonly int[] columnPointers;
+		private readonly int[] rowIndices;
+		private readonly int rhsOffset;
+		private double* values;
+
+		/// <summary>Creates value array for given pattern of the equation matrix.</summary>
+		/// <param name="pattern">Pattern of the equation matrix, its values are not used.</param>
+		public StampMap(SparseMatrix<double> pattern)
+		{
+			if (pattern == null) throw new ArgumentNullException(nameof(pattern));
+
+			Size = pattern.Size;
+			NonzeroCount = pattern.NonzeroCount;
+			columnPointers = pattern.ColumnPointers;
+			rowIndices = pattern.RowIndices;
+
+			rhsOffset = (NonzeroCount + Alignment - 1) / Alignment * Alignment;
+			Length = rhsOffset + Size;
+			values = stamp_values_create(Length);
+			if (values == null) throw new OutOfMemoryException();
+		}
+
+		/// <summary>Number of variables of the equation system.</summary>
+		public int Size { get; }
+
+		/// <summary>Number of entries in the matrix part.</summary>
+		public int NonzeroCount { get; }
+
+		/// <summary>Total number of values including the padding between matrix and right hand side.</summary>
+		public int Length { get; }
+
+		/// <summary>Pointer to the matrix values in the order of the sparse pattern.</summary>
+		public double* MatrixValues => values;
+
+		/// <summary>Pointer to the right hand side values.</summary>
+		public double* RightHandSide => values + rhsOffset;
+
+		/// <summary>Performs application-defined tasks associated with freeing, releasing, or resetting unmanaged resources.</summary>
+		public void Dispose()
+		{
+			ReleaseValues();
+			GC.SuppressFinalize(this);
+		}
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern double* stamp_values_create(int count);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern int stamp_values_all_finite(double* values, int count);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void stamp_values_free(double* values);
+
+		/// <summary>Returns index of the matrix entry at given coordinates or -1 if it is not part of the pattern.</summary>
+		/// <param name="row">Row coordinate.</param>
+		/// <param name="col">Column coordinate.</param>
+		/// <returns></returns>
+		public int IndexOf(int row, int col)
+		{
+			var start = columnPointers[col];
+			var index = Array.BinarySearch(rowIndices, start, columnPointers[col + 1] - start, row);
+			return index < 0 ? -1 : index;
+		}
+
+		/// <summary>Binds the slot to the matrix entry at given coordinates.</summary>
+		/// <param name="slot">The slot to be bound.</param>
+		/// <param name="row">Row coordinate.</param>
+		/// <param name="col">Column coordinate.</param>
+		public void BindMatrixSlot(CoefficientSlot slot, int row, int col)
+		{
+			var index = IndexOf(row, col);
+			if (index < 0) throw new InvalidOperationException($"Entry [{row}, {col}] is not part of the pattern.");
+			slot.target = values + index;
+		}
+
+		/// <summary>Binds the slot to the right hand side entry at given row.</summary>
+		/// <param name="slot">The slot to be bound.</param>
+		/// <param name="row">Row coordinate.</param>
+		public void BindRightHandSideSlot(CoefficientSlot slot, int row)
+		{
+			if (row < 0 || row >= Size) throw new ArgumentOutOfRangeException(nameof(row));
+			slot.target = RightHandSide + row;
+		}
+
+		/// <summary>Sets all values to zero.</summary>
+		public void Clear()
+		{
+			new Span<double>(values, Length).Clear();
+		}
+
+		/// <summary>Returns false if any of the values is NaN or infinity.</summary>
+		/// <returns></returns>
+		public bool AllFinite()
+		{
+			return stamp_values_all_finite(values, Length) != 0;
+		}
+
+		private void ReleaseValues()
+		{
+			if (values == null) return;
+			stamp_values_free(values);
+			values = null;
+		}
+
+		~StampMap()
+		{
+			ReleaseValues();
+		}
+	}
+}
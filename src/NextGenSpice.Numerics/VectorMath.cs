@@ -0,0 +1,83 @@
+using System;
+using System.Runtime.InteropServices;
+using System.Security;
+
+namespace NextGenSpice.Numerics
+{
+	/// <summary>
+	///   Elementary functions evaluated natively for whole arrays of values. When the processor supports AVX2, the
+	///   results of <see cref="Exp" /> and <see cref="Log" /> are within 1 ulp of the exact value and the results of
+	///   <see cref="Pow" /> are within 2 ulp for exponents up to 64 in absolute value. Otherwise the C runtime
+	///   functions are used.
+	/// </summary>
+	public static unsafe class VectorMath
+	{
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void math_exp(double* x, double* result, int count);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void math_log(double* x, double* result, int count);
+
+		[DllImport(Constants.DllPath, CallingConvention = CallingConvention.StdCall)]
+		[SuppressUnmanagedCodeSecurity]
+		private static extern void math_pow(double* x, double* y, double* result, int count);
+
+		private static void CheckLength(int expected, int actual)
+		{
+			if (expected != actual) throw new ArgumentException("The arrays are of different size.");
+		}
+
+		/// <summary>Computes result[i] = exp(x[i]), the spans may be the same.</summary>
+		/// <param name="x">The exponents.</param>
+		/// <param name="result">Span to which the results are stored.</param>
+		public static void Exp(ReadOnlySpan<double> x, Span<double> result)
+		{
+			CheckLength(x.Length, result.Length);
+			if (result.IsEmpty) return;
+
+			fixed (double* px = x)
+			fixed (double* pr = result)
+			{
+				math_exp(px, pr, result.Length);
+			}
+		}
+
+		/// <summary>Computes result[i] = log(x[i]), the spans may be the same.</summary>
+		/// <param name="x">The arguments of the natural logarithm.</param>
+		/// <param name="result">Span to which the results are stored.</param>
+		public static void Log(ReadOnlySpan<double> x, Span<double> result)
+		{
+			CheckLength(x.Length, result.Length);
+			if (result.IsEmpty) return;
+
+			fixed (double* px = x)
+			fixed (double* pr = result)
+			{
+				math_log(px, pr, result.Length);
+			}
+		}
+
+		/// <summary>
+		///   Computes result[i] = pow(x[i], y[i]), the result may be the same span as one of the arguments. Negative
+		///   bases are handled like by <see cref="Math.Pow" />, i.e. they give NaN only for non-integral exponents.
+		/// </summary>
+		/// <param name="x">The bases.</param>
+		/// <param name="y">The exponents.</param>
+		/// <param name="result">Span to which the results are stored.</param>
+		public static void Pow(ReadOnlySpan<double> x, ReadOnlySpan<double> y, Span<double> result)
+		{
+			CheckLength(x.Length, y.Length);
+			CheckLength(x.Length, result.Length);
+			if (result.IsEmpty) return;
+
+			fixed (double* px = x)
+			fixed (double* py = y)
+			fixed (double* pr = result)
+			{
+				math_pow(px, py, pr, result.Length);
+			}
+		}
+	}
+}
@@ -1,5 +1,4 @@
 ﻿using System.Collections.Generic;
-using System.IO;
 using System.Linq;
 using NextGenSpice.Core.Representation;
 using NextGenSpice.LargeSignal;
@@ -26,11 +25,11 @@ namespace NextGenSpice.Printing
 		/// <summary>Information about what kind of data are handled by this print statement.</summary>
 		public override string Header => $"{stat}({name})";
 
-		/// <summary>Prints value of handled by this print statement into given TextWriter.</summary>
-		/// <param name="output">Output TextWriter where to write.</param>
-		public override void PrintValue(TextWriter output)
+		/// <summary>Gets the current value handled by this print statement.</summary>
+		/// <returns>Value of the printed quantity.</returns>
+		public override double GetValue()
 		{
-			output.Write(provider.GetValue());
+			return provider.GetValue();
 		}
 
 		/// <summary>Initializes print statement for given circuit model and returns set of errors that occured (if any).</summary>
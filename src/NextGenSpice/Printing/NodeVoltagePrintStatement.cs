@@ -1,5 +1,4 @@
 ﻿using System.Collections.Generic;
-using System.IO;
 using System.Linq;
 using NextGenSpice.LargeSignal;
 using NextGenSpice.Parser.Utils;
@@ -22,11 +21,11 @@ namespace NextGenSpice.Printing
 		/// <summary>Information about what kind of data are handled by this print statement.</summary>
 		public override string Header => $"V({nodeName})";
 
-		/// <summary>Prints value of handled by this print statement into given TextWriter.</summary>
-		/// <param name="output">Output TextWriter where to write.</param>
-		public override void PrintValue(TextWriter output)
+		/// <summary>Gets the current value handled by this print statement.</summary>
+		/// <returns>Value of the printed quantity.</returns>
+		public override double GetValue()
 		{
-			output.Write(model.NodeVoltages[index]);
+			return model.NodeVoltages[index];
 		}
 
 		/// <summary>Initializes print statement for given circuit model and returns set of errors that occured (if any).</summary>
@@ -57,11 +56,11 @@ namespace NextGenSpice.Printing
 		/// <summary>Information about what kind of data are handled by this print statement.</summary>
 		public override string Header => $"V({nodeNames})";
 
-		/// <summary>Prints value of handled by this print statement into given TextWriter.</summary>
-		/// <param name="output">Output TextWriter where to write.</param>
-		public override void PrintValue(TextWriter output)
+		/// <summary>Gets the current value handled by this print statement.</summary>
+		/// <returns>Value of the printed quantity.</returns>
+		public override double GetValue()
 		{
-			output.Write(model.NodeVoltages[i1] - model.NodeVoltages[i2]);
+			return model.NodeVoltages[i1] - model.NodeVoltages[i2];
 		}
 
 		/// <summary>Initializes print statement for given circuit model and returns set of errors that occured (if any).</summary>
@@ -19,9 +19,16 @@ namespace NextGenSpice.Printing
 		/// <returns>Set of errors that errored (if any).</returns>
 		public abstract IEnumerable<SpiceParserError> Initialize(object circuitModel);
 
+		/// <summary>Gets the current value handled by this print statement.</summary>
+		/// <returns>Value of the printed quantity.</returns>
+		public abstract double GetValue();
+
 		/// <summary>Prints value of handled by this print statement into given TextWriter.</summary>
 		/// <param name="output">Output TextWriter where to write.</param>
-		public abstract void PrintValue(TextWriter output);
+		public virtual void PrintValue(TextWriter output)
+		{
+			output.Write(GetValue());
+		}
 	}
 
 
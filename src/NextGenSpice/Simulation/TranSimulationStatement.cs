@@ -44,18 +44,58 @@ namespace NextGenSpice.Simulation
 
 			model.EstablishDcBias();
 
-			var time = param.StartTime;
+			// the timestep is chosen by the truncation error control and the values are interpolated to the print grid
+			var maxTimeStep = param.MaximumTimeStep > 0
+				? param.MaximumTimeStep
+				: Math.Max(param.StopTime - param.StartTime, param.TimeStep) / 50;
+			model.NextTimeStep = Math.Min(param.TimeStep, maxTimeStep) / 10;
+
+			// tolerance for rounding errors in the timepoints
+			var eps = param.TimeStep * 1e-6;
+
+			var previousValues = new double[printers.Count];
+			var values = new double[printers.Count];
+			GetValues(printers, values);
+
 			PrintHeader(model, printers, output);
-			PrintValues(model, printers, output);
-			while (time < param.StopTime)
+			if (!(0 < param.StartTime)) PrintValues(0, values, output);
+
+			var printIndex = 1;
+			while (param.StopTime - model.CurrentTimePoint > eps)
 			{
-				model.AdvanceInTime(param.TimeStep);
-				time += param.TimeStep;
-				if (!(time < param.StartTime))
-					PrintValues(model, printers, output);
+				var previousTime = model.CurrentTimePoint;
+				var tmp = previousValues;
+				previousValues = values;
+				values = tmp;
+
+				model.AdvanceInTimeAdaptively(Math.Min(maxTimeStep, param.StopTime - previousTime));
+				GetValues(printers, values);
+
+				var time = model.CurrentTimePoint;
+				for (var printTime = printIndex * param.TimeStep;
+					printTime < time + eps && printTime < param.StopTime + eps;
+					printTime = ++printIndex * param.TimeStep)
+				{
+					if (printTime < param.StartTime) continue;
+
+					// linear interpolation between the two accepted timepoints around the print time
+					var t = Math.Min((printTime - previousTime) / (time - previousTime), 1);
+					for (var i = 0; i < values.Length; i++)
+						previousValues[i] += t * (values[i] - previousValues[i]);
+					PrintValues(printTime, previousValues, output);
+
+					// the interpolation continues from the printed timepoint
+					previousTime = printTime;
+				}
 			}
 		}
 
+		private static void GetValues(List<PrintStatement<LargeSignalCircuitModel>> printers, double[] values)
+		{
+			for (var i = 0; i < printers.Count; i++)
+				values[i] = printers[i].GetValue();
+		}
+
 		private void GetPrintersForAll(LargeSignalCircuitModel model,
 			List<PrintStatement<LargeSignalCircuitModel>> printers)
 		{
@@ -82,14 +122,13 @@ namespace NextGenSpice.Simulation
 			output.WriteLine();
 		}
 
-		private void PrintValues(LargeSignalCircuitModel model, List<PrintStatement<LargeSignalCircuitModel>> printers,
-			TextWriter output)
+		private void PrintValues(double time, double[] values, TextWriter output)
 		{
-			output.Write(model.CurrentTimePoint);
-			foreach (var printer in printers)
+			output.Write(time);
+			foreach (var value in values)
 			{
 				output.Write(" ");
-				printer.PrintValue(output);
+				output.Write(value);
 			}
 
 			output.WriteLine();
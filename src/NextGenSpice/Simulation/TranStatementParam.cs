@@ -12,10 +12,9 @@
 		/// <summary>Suggested time step for numerical integration. Simulator may reduce or increase this value as needed.</summary>
 		public double TimeStep { get; set; }
 
-		// this option is not yet supported
-//        /// <summary>
-//        /// Maximmum allowed time step for numerical integration.
-//        /// </summary>
-//        public double MaximmumTimestep { get; set; }
+		/// <summary>
+		///   Maximum allowed time step for numerical integration, 0 means max(StopTime - StartTime, TimeStep) / 50.
+		/// </summary>
+		public double MaximumTimeStep { get; set; }
 	}
 }
\ No newline at end of file
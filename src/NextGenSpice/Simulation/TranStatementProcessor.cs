@@ -16,9 +16,7 @@ namespace NextGenSpice.Simulation
 			Mapper.Map(c => c.TimeStep, 0);
 			Mapper.Map(c => c.StopTime, 1);
 			Mapper.Map(c => c.StartTime, 2);
-
-			// not supported yet, the timestep is constant and equal to TimeStep parameter
-//            Mapper.Map(c => c.MaximmumTimestep, 3);
+			Mapper.Map(c => c.MaximumTimeStep, 3);
 		}
 
 		/// <summary>Statement discriminator, that this class can handle.</summary>
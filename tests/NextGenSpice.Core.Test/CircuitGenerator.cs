@@ -109,5 +109,31 @@ namespace NextGenSpice.Core.Test
 				.AddResistor(3, 0, 1)
 				.BuildCircuit();
 		}
+
+		/// <summary>
+		///   Creates square mesh of resistors driven by a voltage source in one corner, the nodes on the opposite edge are
+		///   connected to the ground through diodes. The equation system has size * size + 1 variables.
+		/// </summary>
+		/// <param name="size">Number of nodes on the side of the mesh.</param>
+		/// <returns></returns>
+		public static CircuitDefinition GetMeshCircuit(int size)
+		{
+			int Node(int row, int col)
+			{
+				return row * size + col + 1;
+			}
+
+			var builder = new CircuitBuilder().AddVoltageSource(Node(0, 0), 0, 5);
+			for (var row = 0; row < size; row++)
+			for (var col = 0; col < size; col++)
+			{
+				if (col + 1 < size) builder.AddResistor(Node(row, col), Node(row, col + 1), 100);
+				if (row + 1 < size) builder.AddResistor(Node(row, col), Node(row + 1, col), 100);
+			}
+
+			for (var col = 0; col < size; col++) builder.AddDiode(Node(size - 1, col), 0, DiodeParams.Default);
+
+			return builder.BuildCircuit();
+		}
 	}
 }
\ No newline at end of file
@@ -0,0 +1,131 @@
+using System;
+using NextGenSpice.Core.Representation;
+using NextGenSpice.Core.Test;
+using NextGenSpice.Numerics;
+using NextGenSpice.Numerics.Equations;
+using NextGenSpice.Numerics.Precision;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace NextGenSpice.LargeSignal.Test
+{
+	public class AdaptivePrecisionTests : TracedTestBase
+	{
+		public AdaptivePrecisionTests(ITestOutputHelper output) : base(output)
+		{
+			creator = new AnalysisModelCreator();
+		}
+
+		private readonly IAnalysisModelCreator creator;
+
+		public override void Dispose()
+		{
+			EquationSystemAdapterFactory.SetFactory(() => new DdEquationSystemAdapter());
+			base.Dispose();
+		}
+
+		private static void SetHilbertSystem(AdaptivePrecisionEquationSystem system)
+		{
+			var size = system.VariablesCount;
+			for (var i = 0; i < size; i++)
+			for (var j = 0; j < size; j++)
+			{
+				system.Matrix[i, j] = new dd_real(1) / (i + j + 1);
+				system.RightHandSide[i] += system.Matrix[i, j]; // solution is vector of ones
+			}
+		}
+
+		[Fact]
+		public void EstimatesConditionNumberFromFactors()
+		{
+			// 1-norm condition number of 6x6 Hilbert matrix
+			const double expected = 2.907027900294e7;
+
+			var a = new Matrix<double>(6);
+			for (var i = 0; i < 6; i++)
+			for (var j = 0; j < 6; j++)
+				a[i, j] = 1.0 / (i + j + 1);
+
+			using (var lu = new DenseLuFactorization(6))
+			{
+				lu.Factor(a);
+				var estimate = lu.EstimateConditionNumber();
+				Output.WriteLine($"Condition number estimate: {estimate}");
+
+				// the estimate is a lower bound which is usually within a factor of 3
+				Assert.InRange(estimate, expected / 3, expected * (1 + 1e-6));
+			}
+		}
+
+		[Fact]
+		public void ReturnsInfinityForSingularMatrix()
+		{
+			var a = new Matrix<double>(2);
+			a[0, 0] = 1;
+			a[0, 1] = 2;
+			a[1, 0] = 2;
+			a[1, 1] = 4;
+
+			using (var lu = new DenseLuFactorization(2))
+			{
+				lu.Factor(a);
+				Assert.True(double.IsPositiveInfinity(lu.EstimateConditionNumber()));
+			}
+		}
+
+		[Fact]
+		public void SolvesWellConditionedSystemInDoublePrecision()
+		{
+			var system = new AdaptivePrecisionEquationSystem(3);
+			system.Matrix[0, 0] = 4;
+			system.Matrix[1, 1] = 4;
+			system.Matrix[2, 2] = 4;
+			system.Matrix[0, 1] = system.Matrix[1, 0] = -1;
+			system.Matrix[1, 2] = system.Matrix[2, 1] = -1;
+			system.RightHandSide[0] = 3;
+			system.RightHandSide[1] = 2;
+			system.RightHandSide[2] = 3;
+
+			system.Solve();
+
+			Assert.Equal(SolvePrecision.Double, system.LastPrecision);
+			Assert.All(system.Solution, v => Assert.Equal(1, v.x0, 14));
+		}
+
+		[Fact]
+		public void EscalatesIllConditionedSystem()
+		{
+			var system = new AdaptivePrecisionEquationSystem(10);
+			SetHilbertSystem(system);
+
+			system.Solve();
+			Output.WriteLine($"Condition number estimate: {system.LastConditionEstimate}");
+
+			Assert.Equal(SolvePrecision.DoubleDouble, system.LastPrecision);
+			Assert.All(system.Solution, v => Assert.True(Math.Abs((double) (v - 1)) < 1e-16));
+
+			system.QdConditionThreshold = 1e10;
+			system.Solve();
+
+			Assert.Equal(SolvePrecision.QuadDouble, system.LastPrecision);
+			Assert.All(system.Solution, v => Assert.True(Math.Abs((double) (v - 1)) < 1e-16));
+		}
+
+		[Fact]
+		public void GivesSameResultsAsDoubleDoubleSolverForNonlinearCircuit()
+		{
+			var reference = creator.Create<LargeSignalCircuitModel>(CircuitGenerator.GetNonlinearCircuit());
+			reference.EstablishDcBias();
+
+			var adapter = new AdaptivePrecisionEquationSystemAdapter();
+			EquationSystemAdapterFactory.SetFactory(() => adapter);
+			var model = creator.Create<LargeSignalCircuitModel>(CircuitGenerator.GetNonlinearCircuit());
+			model.EstablishDcBias();
+
+			Output.WriteLine(
+				$"Double: {adapter.DoubleSolveCount}, dd: {adapter.DdSolveCount}, qd: {adapter.QdSolveCount}");
+			Assert.True(adapter.DoubleSolveCount + adapter.DdSolveCount + adapter.QdSolveCount > 0);
+			Assert.Equal(reference.NodeVoltages, model.NodeVoltages, new DoubleComparer(1e-9));
+		}
+	}
+}
@@ -1,4 +1,5 @@
-﻿using Xunit;
+﻿using NextGenSpice.Core.Test;
+using Xunit;
 using Xunit.Abstractions;
 
 namespace NextGenSpice.LargeSignal.Test
@@ -32,6 +33,60 @@ vcc 3 0 5
 			AssertEqual(5, v3);
 		}
 
+		[Fact]
+		public void SimpleNpnWithDeviceBypass()
+		{
+			Parse(@"
+q1 1 2 0 qmod
+rc 2 3 200k
+rb 1 3 1k
+vcc 3 0 5
+
+.Model qmod npn is=1e-16 bf=100
+
+.end");
+			Model.SimulationParameters.UseDeviceBypass = true;
+			Model.EstablishDcBias();
+
+			AssertEqual(2.89653326135722, Model.NodeVoltages[Result.NodeIds["1"]]);
+			AssertEqual(0.79306652271697, Model.NodeVoltages[Result.NodeIds["2"]]);
+			Assert.True(Model.TotalDeviceBypassCount > 0);
+		}
+
+		[Fact]
+		public void NativeGroupEvaluationMatchesDeviceEvaluation()
+		{
+			Parse(@"
+.Model mybjt pnp cjc=1p cjs=1p tf=1n
+.Model mydiode D(Is=1e-14 N=1.5 Cjo=4p M=.4 tt=20n)
+
+rc 1 2 5kOhm
+vcc 1 0  6V
+vin 3 0  sin(0.705 50mV 1kHz 0 0)
+q1 2 3 0 mybjt
+q2 2 3 0 mybjt
+d1 2 4 mydiode
+r1 4 0 1k
+
+.end");
+			var expected = Result.CircuitDefinition.GetLargeSignalModel();
+			expected.SimulationParameters.UseNativeDeviceEvaluation = false;
+			Model.SimulationParameters.UseNativeDeviceEvaluation = true;
+
+			expected.EstablishDcBias();
+			Model.EstablishDcBias();
+			Assert.Equal(expected.NodeVoltages, Model.NodeVoltages, new DoubleComparer(1e-12));
+
+			for (var i = 0; i < 20; i++)
+			{
+				expected.AdvanceInTime(1e-5);
+				Model.AdvanceInTime(1e-5);
+				Assert.Equal(expected.NodeVoltages, Model.NodeVoltages, new DoubleComparer(1e-12));
+			}
+
+			Assert.Equal(expected.TotalNonLinearIterationCount, Model.TotalNonLinearIterationCount);
+		}
+
 		[Fact]
 		public void SimplePnp()
 		{
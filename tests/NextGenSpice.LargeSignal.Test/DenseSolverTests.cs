@@ -0,0 +1,239 @@
+﻿using System;
+using System.Linq;
+using NextGenSpice.Core.Test;
+using NextGenSpice.Numerics;
+using NextGenSpice.Numerics.Equations;
+using Xunit;
+
+namespace NextGenSpice.LargeSignal.Test
+{
+	public class DenseSolverTests
+	{
+		private static (Matrix<double> a, double[] b) GetRandomSystem(int size, int seed)
+		{
+			var random = new Random(seed);
+			var a = new Matrix<double>(size);
+			var b = new double[size];
+
+			// large entries on a random permutation make the matrix nonsingular, but require pivoting
+			var permutation = Enumerable.Range(0, size).OrderBy(_ => random.Next()).ToArray();
+			for (var i = 0; i < size; i++)
+			{
+				for (var j = 0; j < size; j++)
+					// keep the matrix sparse like the circuit equations
+					if (random.NextDouble() < 0.2)
+						a[i, j] = random.NextDouble() * 2 - 1;
+				a[i, permutation[i]] += size;
+				b[i] = random.NextDouble() * 10 - 5;
+			}
+
+			return (a, b);
+		}
+
+		private static Matrix<double> Copy(Matrix<double> m)
+		{
+			var copy = new Matrix<double>(m.Size);
+			m.RawData.CopyTo(copy.RawData, 0);
+			return copy;
+		}
+
+		[Theory]
+		[InlineData(1)]
+		[InlineData(7)]
+		[InlineData(33)]
+		[InlineData(100)]
+		public void VectorizedSolverMatchesScalarSolver(int size)
+		{
+			var (a, b) = GetRandomSystem(size, size);
+			var expected = new double[size];
+			var actual = new double[size];
+
+			GaussJordanElimination.Solve_NativeScalar_double(Copy(a), (double[]) b.Clone(), expected);
+			GaussJordanElimination.Solve_Native_double(Copy(a), (double[]) b.Clone(), actual);
+
+			Assert.Equal(expected, actual, new DoubleComparer(1e-12));
+		}
+
+		[Fact]
+		public void FactorizationIsReusedForSameMatrix()
+		{
+			var (a, b) = GetRandomSystem(40, 1);
+			var expected = new double[40];
+			var actual = new double[40];
+
+			using (var lu = new DenseLuFactorization(a.Size))
+			{
+				Assert.True(lu.Factor(a));
+				lu.Solve(b, actual);
+				GaussJordanElimination.Solve(Copy(a), (double[]) b.Clone(), expected);
+				Assert.Equal(expected, actual, new DoubleComparer(1e-12));
+
+				// only the right hand side changes
+				b[3] += 1;
+				Assert.False(lu.Factor(a));
+				lu.Solve(b, actual);
+				GaussJordanElimination.Solve(Copy(a), (double[]) b.Clone(), expected);
+				Assert.Equal(expected, actual, new DoubleComparer(1e-12));
+
+				a[5, 5] += 1;
+				Assert.True(lu.Factor(a));
+				lu.Solve(b, actual);
+				GaussJordanElimination.Solve(Copy(a), (double[]) b.Clone(), expected);
+				Assert.Equal(expected, actual, new DoubleComparer(1e-12));
+
+				Assert.Equal(2, lu.FactorizationCount);
+			}
+		}
+
+		[Theory]
+		[InlineData(1, 4)]
+		[InlineData(31, 4)]
+		[InlineData(100, 1)]
+		[InlineData(100, 3)]
+		[InlineData(257, 8)]
+		public void ParallelFactorizationMatchesSerialFactorization(int size, int threads)
+		{
+			var (a, b) = GetRandomSystem(size, size);
+			var expected = new double[size];
+			var actual = new double[size];
+
+			using (var serial = new DenseLuFactorization(size))
+			using (var parallel = new ParallelLuFactorization(size, threads, 0))
+			{
+				Assert.Equal(threads, parallel.ThreadCount);
+
+				serial.Factor(a);
+				serial.Solve(b, expected);
+				Assert.True(parallel.Factor(a));
+				parallel.Solve(b, actual);
+				Assert.False(parallel.Factor(a));
+			}
+
+			Assert.Equal(expected, actual, new DoubleComparer(1e-12));
+		}
+
+		[Fact]
+		public void ParallelFactorizationSolvesMeshCircuit()
+		{
+			var reference = CircuitGenerator.GetMeshCircuit(12).GetLargeSignalModel();
+			reference.EstablishDcBias();
+
+			try
+			{
+				EquationSystemAdapterFactory.SetFactory(() =>
+					new EquationSystemAdapter {UseParallelFactorization = true, ThreadCount = 4, SerialCutoff = 0});
+				// disposing the model releases the threads of the parallel factorization
+				using (var model = CircuitGenerator.GetMeshCircuit(12).GetLargeSignalModel())
+				{
+					model.EstablishDcBias();
+					Assert.Equal(reference.NodeVoltages, model.NodeVoltages, new DoubleComparer(1e-9));
+				}
+			}
+			finally
+			{
+				EquationSystemAdapterFactory.SetFactory(() => new DdEquationSystemAdapter());
+			}
+		}
+
+		[Theory]
+		[InlineData(SolvePrecision.Double)]
+		[InlineData(SolvePrecision.DoubleDouble)]
+		[InlineData(SolvePrecision.QuadDouble)]
+		public void SparseAssemblySolvesMeshCircuit(SolvePrecision precision)
+		{
+			var reference = CircuitGenerator.GetMeshCircuit(8).GetLargeSignalModel();
+			reference.EstablishDcBias();
+
+			try
+			{
+				EquationSystemAdapterFactory.SetFactory(() =>
+				{
+					switch (precision)
+					{
+						case SolvePrecision.Double: return new EquationSystemAdapter {SparseAssembly = true};
+						case SolvePrecision.DoubleDouble: return new DdEquationSystemAdapter {SparseAssembly = true};
+						default: return new QdEquationSystemAdapter {SparseAssembly = true};
+					}
+				});
+				var model = CircuitGenerator.GetMeshCircuit(8).GetLargeSignalModel();
+				model.EstablishDcBias();
+
+				Assert.Equal(reference.NodeVoltages, model.NodeVoltages, new DoubleComparer(1e-9));
+			}
+			finally
+			{
+				EquationSystemAdapterFactory.SetFactory(() => new DdEquationSystemAdapter());
+			}
+		}
+
+		[Fact]
+		public void SparseAssemblyRemovesGroundAndClearsOnlyUsedCoefficients()
+		{
+			// two resistors in series between current source and ground
+			var adapter = new EquationSystemAdapter {SparseAssembly = true};
+			for (var i = 0; i < 3; i++) adapter.AddVariable();
+
+			var g00 = adapter.GetMatrixCoefficientProxy(0, 0);
+			var g01 = adapter.GetMatrixCoefficientProxy(0, 1);
+			var g11 = adapter.GetMatrixCoefficientProxy(1, 1);
+			var g12 = adapter.GetMatrixCoefficientProxy(1, 2);
+			var g21 = adapter.GetMatrixCoefficientProxy(2, 1);
+			var g22 = adapter.GetMatrixCoefficientProxy(2, 2);
+			var i0 = adapter.GetRightHandSideCoefficientProxy(0);
+			var i2 = adapter.GetRightHandSideCoefficientProxy(2);
+			var v0 = adapter.GetSolutionProxy(0);
+			var v2 = adapter.GetSolutionProxy(2);
+			adapter.Freeze();
+
+			var solution = new double[3];
+			for (var iteration = 0; iteration < 2; iteration++)
+			{
+				adapter.Clear();
+				g00.Add(1);
+				g01.Add(-1);
+				g11.Add(2);
+				g12.Add(-1);
+				g21.Add(-1);
+				g22.Add(1);
+				i0.Add(-1);
+				i2.Add(1);
+				adapter.Anullate(0);
+				adapter.Solve(solution);
+
+				Assert.Equal(new[] {0, 1.0, 2.0}, solution, new DoubleComparer(1e-12));
+				Assert.Equal(0, v0.GetValue());
+				Assert.Equal(2, v2.GetValue(), 12);
+			}
+		}
+
+		[Fact]
+		public void SolutionUpdateMatchesManagedToleranceCheck()
+		{
+			var random = new Random(5);
+			for (var iteration = 0; iteration < 100; iteration++)
+			{
+				var nodes = Enumerable.Range(0, 10).Select(_ => random.NextDouble()).ToArray();
+				var solution = nodes.Select(v => v + (random.NextDouble() - 0.5) * 1e-3).Concat(new[] {1.0, 2.0})
+					.ToArray();
+
+				var expected = nodes.Select((v, i) => MathHelper.InTollerance(v, solution[i], 1e-6, 1e-3)).All(b => b);
+				var status = SolutionUpdate.Apply(solution, nodes, 1e-6, 1e-3);
+
+				Assert.Equal(expected ? SolutionStatus.Converged : SolutionStatus.NotConverged, status);
+				Assert.Equal(solution.Take(nodes.Length), nodes);
+			}
+		}
+
+		[Theory]
+		[InlineData(double.NaN)]
+		[InlineData(double.PositiveInfinity)]
+		public void SolutionUpdateRejectsNonFiniteValues(double value)
+		{
+			var nodes = new[] {1.0, 2.0};
+
+			// the value is outside the nodes part of the solution, e.g. a branch current
+			Assert.Equal(SolutionStatus.NotFinite, SolutionUpdate.Apply(new[] {3.0, 4.0, value}, nodes, 1e-6, 1e-3));
+			Assert.Equal(new[] {1.0, 2.0}, nodes);
+		}
+	}
+}
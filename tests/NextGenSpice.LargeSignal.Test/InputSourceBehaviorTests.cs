@@ -130,5 +130,27 @@ namespace NextGenSpice.LargeSignal.Test
 
 			var voltages = SimulateFor(circuit, 30e-6, 1e-6);
 		}
+
+		[Fact]
+		public void TestPulseBreakpoints()
+		{
+			var behavior = new PulseBehavior
+			{
+				InitialLevel = 0,
+				PulseLevel = 1,
+				Delay = 1e-3,
+				TimeRise = 1e-6,
+				PulseWidth = 2e-3,
+				TimeFall = 1e-6,
+				Period = 5e-3
+			};
+
+			Assert.Equal(1e-3, behavior.GetNextBreakpoint(0));
+			Assert.Equal(1.001e-3, behavior.GetNextBreakpoint(1e-3), 15);
+			Assert.Equal(3.001e-3, behavior.GetNextBreakpoint(2e-3), 15);
+			Assert.Equal(6e-3, behavior.GetNextBreakpoint(3.5e-3), 15);
+			Assert.Equal(6e-3, behavior.GetNextBreakpoint(5.5e-3), 15);
+			Assert.Equal(6.001e-3, behavior.GetNextBreakpoint(6e-3), 15);
+		}
 	}
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
-﻿using NextGenSpice.Core.Test;
+﻿using System.Linq;
+using NextGenSpice.Core.Test;
 using NextGenSpice.LargeSignal.NumIntegration;
 using Xunit;
 
@@ -22,5 +23,24 @@ namespace NextGenSpice.LargeSignal.Test
 			Assert.Equal(new[] {12 / 25.0, 48 / 25.0, -36 / 25.0, 16 / 25.0, -3 / 25.0}, coeffs,
 				new DoubleComparer(1e-13));
 		}
+
+		[Fact]
+		public void GeneratesVariableStepBdfCoefficients()
+		{
+			// constant timestep gives the same coefficients as the fixed step Gear method
+			var coeffs = new BdfCoefficients(4);
+			coeffs.Update(new[] {1e-3, 1e-3, 1e-3, 1e-3, 1e-3}, 4);
+
+			Assert.Equal(4, coeffs.Order);
+			Assert.Equal(25 / 12.0, coeffs.DerivativeCoefficient, new DoubleComparer(1e-13));
+			Assert.Equal(new[] {48 / 25.0, -36 / 25.0, 16 / 25.0, -3 / 25.0},
+				new[] {1, 2, 3, 4}.Select(j => coeffs.GetWeight(j) / coeffs.DerivativeCoefficient),
+				new DoubleComparer(1e-13));
+
+			// the order is limited by the history after the operating point
+			coeffs.Update(new[] {1e-3, 2e-3, 0, 0, 0}, 4);
+			Assert.Equal(2, coeffs.Order);
+			Assert.Equal(1 / 1.0 + 1 / 3.0, coeffs.DerivativeCoefficient, new DoubleComparer(1e-13));
+		}
 	}
 }
\ No newline at end of file
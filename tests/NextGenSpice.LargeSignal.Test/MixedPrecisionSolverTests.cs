@@ -0,0 +1,121 @@
+using System;
+using System.Linq;
+using NextGenSpice.Core.Representation;
+using NextGenSpice.Core.Test;
+using NextGenSpice.Numerics;
+using NextGenSpice.Numerics.Equations;
+using NextGenSpice.Numerics.Precision;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace NextGenSpice.LargeSignal.Test
+{
+	public class MixedPrecisionSolverTests : TracedTestBase
+	{
+		public MixedPrecisionSolverTests(ITestOutputHelper output) : base(output)
+		{
+			creator = new AnalysisModelCreator();
+		}
+
+		private readonly IAnalysisModelCreator creator;
+
+		public override void Dispose()
+		{
+			EquationSystemAdapterFactory.SetFactory(() => new DdEquationSystemAdapter());
+			base.Dispose();
+		}
+
+		// Hilbert matrix is notoriously ill-conditioned, condition number of 8x8 one is about 1.5e10
+		private static (Matrix<dd_real> a, dd_real[] b) GetHilbertSystem(int size)
+		{
+			var a = new Matrix<dd_real>(size);
+			var b = new dd_real[size];
+			for (var i = 0; i < size; i++)
+			for (var j = 0; j < size; j++)
+			{
+				a[i, j] = new dd_real(1) / (i + j + 1);
+				b[i] += a[i, j]; // solution is vector of ones
+			}
+
+			return (a, b);
+		}
+
+		[Fact]
+		public void RefinementReachesDoubleDoubleAccuracy()
+		{
+			var (a, b) = GetHilbertSystem(8);
+			var x = new dd_real[8];
+
+			using (var solver = new MixedPrecisionSolver(8))
+			{
+				Assert.True(solver.Solve(a, b, x));
+				Output.WriteLine($"Refinement steps: {solver.LastRefinementSteps}, backward error: {solver.LastBackwardError}");
+
+				Assert.True(solver.LastRefinementSteps > 0);
+				Assert.True(solver.LastBackwardError <= solver.Tolerance);
+			}
+
+			// forward error is bounded by condition number times the backward error
+			Assert.All(x, v => Assert.True(Math.Abs((double) (v - 1)) < 1e-12));
+		}
+
+		[Fact]
+		public void SinglePrecisionFactorsConvergeOnWellConditionedSystem()
+		{
+			const int size = 20;
+			var a = new Matrix<dd_real>(size);
+			var b = new dd_real[size];
+			for (var i = 0; i < size; i++)
+			{
+				a[i, i] = new dd_real(4);
+				if (i > 0) a[i, i - 1] = new dd_real(-1);
+				if (i < size - 1) a[i, i + 1] = new dd_real(-1);
+				b[i] = new dd_real(i) / 3;
+			}
+
+			var expected = new dd_real[size];
+			GaussJordanElimination.Solve(a.Clone(), (dd_real[]) b.Clone(), expected);
+
+			var actual = new dd_real[size];
+			using (var solver = new MixedPrecisionSolver(size, FactorPrecision.Single))
+			{
+				Assert.True(solver.Solve(a, b, actual));
+			}
+
+			for (var i = 0; i < size; i++) Assert.True(Math.Abs((double) (expected[i] - actual[i])) < 1e-24);
+		}
+
+		[Fact]
+		public void FillsNaNForSingularMatrix()
+		{
+			var a = new Matrix<dd_real>(2);
+			a[0, 0] = 1;
+			a[0, 1] = 2;
+			a[1, 0] = 2;
+			a[1, 1] = 4;
+
+			var x = new dd_real[2];
+			using (var solver = new MixedPrecisionSolver(2))
+			{
+				Assert.False(solver.Solve(a, new dd_real[] {1, 1}, x));
+			}
+
+			Assert.All(x, v => Assert.True(double.IsNaN(v.x0)));
+		}
+
+		[Fact]
+		public void GivesSameResultsAsDoubleDoubleSolverForNonlinearCircuit()
+		{
+			var reference = creator.Create<LargeSignalCircuitModel>(CircuitGenerator.GetNonlinearCircuit());
+			reference.EstablishDcBias();
+
+			var adapter = new MixedPrecisionEquationSystemAdapter();
+			EquationSystemAdapterFactory.SetFactory(() => adapter);
+			var model = creator.Create<LargeSignalCircuitModel>(CircuitGenerator.GetNonlinearCircuit());
+			model.EstablishDcBias();
+
+			Output.WriteLine($"Refinement steps: {adapter.TotalRefinementSteps}, stagnated: {adapter.StagnatedSolveCount}");
+			Assert.Equal(reference.NodeVoltages, model.NodeVoltages, new DoubleComparer(1e-12));
+		}
+	}
+}
@@ -0,0 +1,109 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using NextGenSpice.Numerics;
+using NextGenSpice.Numerics.Precision;
+using Xunit;
+
+namespace NextGenSpice.LargeSignal.Test
+{
+	public class PrecisionVectorTests
+	{
+		private static dd_real[] GetRandomVector(Random random, int size)
+		{
+			return Enumerable.Range(0, size).Select(_ => new dd_real(random.NextDouble() * 2 - 1) / 3).ToArray();
+		}
+
+		// native code may evaluate the expressions in slightly different order, the results differ only in the last bits
+		private static void AssertClose(dd_real expected, dd_real actual, double tolerance = 1e-30)
+		{
+			Assert.True(Math.Abs((double) (expected - actual)) < tolerance);
+		}
+
+		private static void AssertClose(IEnumerable<dd_real> expected, dd_real[] actual)
+		{
+			var e = expected.ToArray();
+			Assert.Equal(e.Length, actual.Length);
+			for (var i = 0; i < e.Length; i++) AssertClose(e[i], actual[i]);
+		}
+
+		[Fact]
+		public void VectorOperationsMatchScalarOperations()
+		{
+			var random = new Random(42);
+			var x = GetRandomVector(random, 13);
+			var y = GetRandomVector(random, 13);
+			var a = new dd_real(0.7) / 3;
+
+			var expectedDot = dd_real.Zero;
+			for (var i = 0; i < x.Length; i++) expectedDot += x[i] * y[i];
+			AssertClose(expectedDot, DdVector.Dot(x, y));
+
+			var axpy = (dd_real[]) y.Clone();
+			DdVector.Axpy(a, x, axpy);
+			AssertClose(y.Zip(x, (yi, xi) => yi + a * xi), axpy);
+
+			var sum = (dd_real[]) y.Clone();
+			DdVector.Add(sum, x);
+			AssertClose(y.Zip(x, (yi, xi) => yi + xi), sum);
+
+			var product = (dd_real[]) y.Clone();
+			DdVector.Multiply(product, x);
+			AssertClose(y.Zip(x, (yi, xi) => yi * xi), product);
+
+			var fma = (dd_real[]) y.Clone();
+			DdVector.MultiplyAdd(fma, x, y);
+			AssertClose(y.Zip(x, (yi, xi) => yi + xi * yi), fma);
+
+			var quotient = (dd_real[]) y.Clone();
+			DdVector.Divide(quotient, x);
+			AssertClose(y.Zip(x, (yi, xi) => yi / xi), quotient);
+		}
+
+		[Fact]
+		public void RowUpdateEliminatesFirstEntry()
+		{
+			var random = new Random(42);
+			var row = GetRandomVector(random, 9);
+			var pivotRow = GetRandomVector(random, 9);
+			var expected = (dd_real[]) row.Clone();
+
+			var factor = DdVector.RowUpdate(row, pivotRow);
+
+			AssertClose(-expected[0] / pivotRow[0], factor);
+			Assert.True(row[0] == dd_real.Zero);
+			for (var i = 1; i < row.Length; i++) AssertClose(expected[i] + factor * pivotRow[i], row[i]);
+		}
+
+		[Fact]
+		public void ThrowsOnDifferentLengths()
+		{
+			Assert.Throws<ArgumentException>(() => DdVector.Dot(new dd_real[3], new dd_real[4]));
+		}
+
+		[Theory]
+		[InlineData(1)]
+		[InlineData(10)]
+		[InlineData(40)]
+		public void ManagedSolverMatchesNativeSolver(int size)
+		{
+			var random = new Random(size);
+			var m = new Matrix<dd_real>(size);
+			var b = GetRandomVector(random, size);
+			for (var i = 0; i < size; i++)
+			{
+				for (var j = 0; j < size; j++)
+					if (random.NextDouble() < 0.3)
+						m[i, j] = new dd_real(random.NextDouble() * 2 - 1);
+				m[i, size - i - 1] += size;
+			}
+
+			var expected = new dd_real[size];
+			var actual = new dd_real[size];
+			GaussJordanElimination.Solve_Native_dd(m.Clone(), (dd_real[]) b.Clone(), expected);
+			GaussJordanElimination.Solve_Managed_dd(m.Clone(), (dd_real[]) b.Clone(), actual);
+
+			for (var i = 0; i < size; i++) AssertClose(expected[i], actual[i], 1e-28);
+		}
+	}
+}
@@ -0,0 +1,278 @@
+﻿using System;
+using System.Linq;
+using NextGenSpice.Core.Representation;
+using NextGenSpice.Core.Test;
+using NextGenSpice.Numerics;
+using NextGenSpice.Numerics.Equations;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace NextGenSpice.LargeSignal.Test
+{
+	public class SparseSolverTests : TracedTestBase
+	{
+		public SparseSolverTests(ITestOutputHelper output) : base(output)
+		{
+			creator = new AnalysisModelCreator();
+		}
+
+		private readonly IAnalysisModelCreator creator;
+
+		public override void Dispose()
+		{
+			EquationSystemAdapterFactory.SetFactory(() => new DdEquationSystemAdapter());
+			base.Dispose();
+		}
+
+		private static double[] SolveWith(IEquationSystemAdapterWide adapter, (int row, int col, double value)[] entries,
+			double[] rhs)
+		{
+			for (var i = 0; i < rhs.Length; i++) adapter.AddVariable();
+
+			var matrixProxies = entries.Select(e => adapter.GetMatrixCoefficientProxy(e.row, e.col)).ToArray();
+			var rhsProxies = rhs.Select((_, i) => adapter.GetRightHandSideCoefficientProxy(i)).ToArray();
+			adapter.Freeze();
+
+			for (var i = 0; i < entries.Length; i++) matrixProxies[i].Add(entries[i].value);
+			for (var i = 0; i < rhs.Length; i++) rhsProxies[i].Add(rhs[i]);
+			adapter.Anullate(0);
+
+			var solution = new double[rhs.Length];
+			adapter.Solve(solution);
+			return solution;
+		}
+
+		private static (int, int, double)[] Conductance(int a, int b, double g)
+		{
+			return new[] {(a, a, g), (b, b, g), (a, b, -g), (b, a, -g)};
+		}
+
+		[Fact]
+		public void MatchesDenseSolverOnNodalEquations()
+		{
+			// ladder of resistors with a voltage source branch (variable 5) between node 1 and ground
+			var entries = Conductance(0, 1, 1)
+				.Concat(Conductance(1, 2, 0.5))
+				.Concat(Conductance(2, 3, 2))
+				.Concat(Conductance(3, 4, 0.1))
+				.Concat(Conductance(4, 0, 3))
+				.Concat(Conductance(2, 0, 1e-3))
+				.Concat(new[] {(1, 5, 1.0), (5, 1, 1.0)})
+				.ToArray();
+			var rhs = new[] {0, 0, 1e-3, 0, 0, 5.0};
+
+			var expected = SolveWith(new EquationSystemAdapter(), entries, rhs);
+			using (var adapter = new SparseEquationSystemAdapter())
+			{
+				var actual = SolveWith(adapter, entries, rhs);
+				Assert.Equal(expected, actual, new DoubleComparer(1e-12));
+			}
+		}
+
+		[Fact]
+		public void RequiresPivotingForZeroDiagonal()
+		{
+			var matrix = SparseMatrix<double>.FromCoordinates(3, new[] {(0, 1), (1, 0), (1, 2), (2, 1), (2, 2)});
+			matrix[0, 1] = 1;
+			matrix[1, 0] = 2;
+			matrix[1, 2] = 1;
+			matrix[2, 1] = 4;
+			matrix[2, 2] = 3;
+
+			var x = new double[3];
+			SparseLuSolver.Solve(matrix, new[] {1.0, 5, 10}, x);
+
+			Assert.Equal(new[] {1.5, 1, 2}, x, new DoubleComparer(1e-14));
+		}
+
+		[Fact]
+		public void FillsNaNForSingularMatrix()
+		{
+			var matrix = SparseMatrix<double>.FromCoordinates(2, new[] {(0, 0), (0, 1), (1, 0), (1, 1)});
+			matrix[0, 0] = 1;
+			matrix[0, 1] = 2;
+			matrix[1, 0] = 2;
+			matrix[1, 1] = 4;
+
+			var x = new double[2];
+			SparseLuSolver.Solve(matrix, new[] {1.0, 1}, x);
+
+			Assert.All(x, v => Assert.True(double.IsNaN(v)));
+		}
+
+		[Fact]
+		public void RefactorizationFollowsChangedValues()
+		{
+			var matrix = SparseMatrix<double>.FromCoordinates(3, new[] {(0, 0), (1, 0), (0, 1), (1, 1), (2, 1), (1, 2), (2, 2)});
+			using (var lu = new SparseLuFactorization(matrix))
+			{
+				var x = new double[3];
+				for (var i = 1; i <= 5; i++)
+				{
+					// diagonally dominant tridiagonal matrix with solution [1, 2, 3]
+					matrix[0, 0] = 4 * i;
+					matrix[1, 0] = matrix[0, 1] = matrix[1, 2] = matrix[2, 1] = -i;
+					matrix[1, 1] = 4 * i;
+					matrix[2, 2] = 4 * i;
+
+					Assert.True(lu.Factor());
+					lu.Solve(new[] {2.0 * i, 4.0 * i, 10.0 * i}, x);
+					Assert.Equal(new[] {1, 2, 3.0}, x, new DoubleComparer(1e-14));
+				}
+			}
+		}
+
+		[Fact]
+		public void MinimumDegreeOrderingReducesFill()
+		{
+			// star network with the center node first, natural order fills in the whole matrix
+			const int size = 20;
+			var entries = Enumerable.Range(1, size - 1).SelectMany(i => Conductance(0, i, i)).ToArray();
+			var matrix = SparseMatrix<double>.FromCoordinates(size, entries.Select(e => (e.Item1, e.Item2)));
+			foreach (var (row, col, value) in entries) matrix[row, col] += value;
+			for (var i = 1; i < size; i++) matrix[i, i] += 1;
+
+			using (var natural = new SparseLuFactorization(matrix, SparseOrdering.Natural))
+			using (var minimumDegree = new SparseLuFactorization(matrix))
+			{
+				Assert.True(natural.Factor());
+				Assert.True(minimumDegree.Factor());
+
+				Assert.Equal(size * size, natural.NonzeroCount);
+				Assert.Equal(3 * size - 2, minimumDegree.NonzeroCount);
+				Assert.Equal(minimumDegree.NonzeroCount, minimumDegree.PredictedNonzeroCount);
+			}
+		}
+
+		[Fact]
+		public void GivesSameResultsAsDenseSolverForNonlinearCircuit()
+		{
+			var dense = creator.Create<LargeSignalCircuitModel>(CircuitGenerator.GetNonlinearCircuit());
+			dense.EstablishDcBias();
+
+			EquationSystemAdapterFactory.SetFactory(() => new SparseEquationSystemAdapter());
+			using (var sparse = creator.Create<LargeSignalCircuitModel>(CircuitGenerator.GetNonlinearCircuit()))
+			{
+				sparse.EstablishDcBias();
+				Assert.Equal(dense.NodeVoltages, sparse.NodeVoltages, new DoubleComparer(1e-9));
+			}
+		}
+
+		[Fact]
+		public unsafe void CompiledAdapterStoresValuesInSparseOrder()
+		{
+			var entries = Conductance(0, 1, 1)
+				.Concat(Conductance(1, 2, 0.5))
+				.Concat(Conductance(2, 0, 2))
+				.ToArray();
+			var rhs = new[] {0, 1.0, 0};
+
+			var expected = SolveWith(new EquationSystemAdapter(), entries, rhs);
+			using (var adapter = new CompiledEquationSystemAdapter())
+			{
+				var actual = SolveWith(adapter, entries, rhs);
+				Assert.Equal(expected, actual, new DoubleComparer(1e-12));
+
+				var map = adapter.StampMap;
+				Assert.Equal(0, (long) map.MatrixValues % 64);
+				Assert.Equal(0, (long) map.RightHandSide % 64);
+
+				// variable 0 was anullated, other diagonal entries are sums of the conductances
+				Assert.Equal(1.5, map.MatrixValues[map.IndexOf(1, 1)]);
+				Assert.Equal(-0.5, map.MatrixValues[map.IndexOf(2, 1)]);
+				Assert.Equal(1, map.RightHandSide[1]);
+			}
+		}
+
+		[Fact]
+		public void CompiledAdapterFillsNaNForSingularMatrix()
+		{
+			var entries = Conductance(1, 2, 1);
+			using (var adapter = new CompiledEquationSystemAdapter())
+			{
+				var actual = SolveWith(adapter, entries, new[] {0, 1.0, 0});
+				Assert.All(actual, v => Assert.True(double.IsNaN(v)));
+			}
+		}
+
+		[Fact]
+		public void CompiledAdapterGivesSameResultsAsDenseSolverForNonlinearCircuit()
+		{
+			var dense = creator.Create<LargeSignalCircuitModel>(CircuitGenerator.GetNonlinearCircuit());
+			dense.EstablishDcBias();
+
+			EquationSystemAdapterFactory.SetFactory(() => new CompiledEquationSystemAdapter());
+			var compiled = creator.Create<LargeSignalCircuitModel>(CircuitGenerator.GetNonlinearCircuit());
+			compiled.EstablishDcBias();
+
+			Assert.Equal(dense.NodeVoltages, compiled.NodeVoltages, new DoubleComparer(1e-9));
+		}
+
+		[Fact]
+		public void PartialRefactorizationMatchesFullRefactorization()
+		{
+			const int size = 20;
+			var coordinates = Enumerable.Range(0, size)
+				.SelectMany(i => new[] {(i, i), (i, (i + 1) % size), ((i + 1) % size, i)});
+			var matrix = SparseMatrix<double>.FromCoordinates(size, coordinates);
+			var b = Enumerable.Range(0, size).Select(i => (double) i).ToArray();
+
+			void SetValues(double scale)
+			{
+				for (var i = 0; i < size; i++)
+				{
+					matrix[i, i] = 4 * scale;
+					matrix[i, (i + 1) % size] = matrix[(i + 1) % size, i] = -1;
+				}
+			}
+
+			using (var full = new SparseLuFactorization(matrix, SparseOrdering.Natural))
+			using (var partial = new SparseLuFactorization(matrix, SparseOrdering.Natural))
+			{
+				SetValues(1);
+				Assert.True(full.Factor());
+				Assert.True(partial.Factor());
+				Assert.Equal(size, partial.LastComputedColumnCount);
+
+				// only the last column changed, the cyclic entries make it depend on all previous columns
+				matrix[size - 1, size - 1] = 5;
+				Assert.True(full.Factor());
+				Assert.True(partial.Factor(new[] {matrix.IndexOf(size - 1, size - 1)}));
+				Assert.Equal(1, partial.LastComputedColumnCount);
+
+				var expected = new double[size];
+				var actual = new double[size];
+				full.Solve(b, expected);
+				partial.Solve(b, actual);
+				Assert.Equal(expected, actual);
+
+				// change in the first column propagates to all columns using it
+				matrix[0, 0] = 6;
+				Assert.True(full.Factor());
+				Assert.True(partial.Factor(new[] {matrix.IndexOf(0, 0)}));
+				Assert.Equal(size, partial.LastComputedColumnCount);
+
+				full.Solve(b, expected);
+				partial.Solve(b, actual);
+				Assert.Equal(expected, actual);
+				Assert.Equal(size - 1, partial.ReusedColumnCount);
+			}
+		}
+
+		[Fact]
+		public void CompiledAdapterWithPartialRefactorizationReusesLinearColumns()
+		{
+			var dense = creator.Create<LargeSignalCircuitModel>(CircuitGenerator.GetMeshCircuit(6));
+			dense.EstablishDcBias();
+
+			CompiledEquationSystemAdapter adapter = null;
+			EquationSystemAdapterFactory.SetFactory(() =>
+				adapter = new CompiledEquationSystemAdapter {PartialRefactorization = true});
+			var compiled = creator.Create<LargeSignalCircuitModel>(CircuitGenerator.GetMeshCircuit(6));
+			compiled.EstablishDcBias();
+
+			Assert.Equal(dense.NodeVoltages, compiled.NodeVoltages, new DoubleComparer(1e-9));
+			Assert.True(adapter.ReusedColumnCount > 0);
+		}
+	}
+}
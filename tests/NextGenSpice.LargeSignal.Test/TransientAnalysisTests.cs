@@ -1,5 +1,15 @@
-﻿using System.Linq;
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using NextGenSpice.Core.BehaviorParams;
+using NextGenSpice.Core.Circuit;
+using NextGenSpice.Core.Devices.Parameters;
+using NextGenSpice.Core.Exceptions;
+using NextGenSpice.Core.Extensions;
 using NextGenSpice.Core.Test;
+using NextGenSpice.LargeSignal.Devices;
+using NextGenSpice.LargeSignal.NumIntegration;
+using NextGenSpice.Numerics.Equations;
 using Xunit;
 using Xunit.Abstractions;
 
@@ -44,5 +54,382 @@ namespace NextGenSpice.LargeSignal.Test
 
 			Assert.Equal(expected, model.NodeVoltages, new DoubleComparer(1e-4));
 		}
+
+		// runs the same transient analysis on both models and compares the node voltages at each timepoint
+		private static void AssertSameTransientResult(LargeSignalCircuitModel expected, LargeSignalCircuitModel model,
+			double tolerance)
+		{
+			expected.EstablishDcBias();
+			model.EstablishDcBias();
+			Assert.Equal(expected.NodeVoltages, model.NodeVoltages, new DoubleComparer(tolerance));
+
+			AssertSameTimePoints(expected, model, tolerance);
+		}
+
+		private static void AssertSameTimePoints(LargeSignalCircuitModel expected, LargeSignalCircuitModel model,
+			double tolerance)
+		{
+			for (var i = 0; i < 20; i++)
+			{
+				expected.AdvanceInTime(1e-6);
+				model.AdvanceInTime(1e-6);
+				Assert.Equal(expected.NodeVoltages, model.NodeVoltages, new DoubleComparer(tolerance));
+			}
+		}
+
+		[Fact]
+		public void TestLinearStampCacheDoesNotChangeResult()
+		{
+			var expected = CircuitGenerator.GetCircuitWithBasicDevices().GetLargeSignalModel();
+			expected.SimulationParameters.CacheLinearStamps = false;
+			var model = CircuitGenerator.GetCircuitWithBasicDevices().GetLargeSignalModel();
+
+			AssertSameTransientResult(expected, model, 1e-12);
+			Assert.Equal(expected.TotalNonLinearIterationCount, model.TotalNonLinearIterationCount);
+		}
+
+		[Fact]
+		public void TestModifiedNewtonConvergesToSameResult()
+		{
+			var expected = CircuitGenerator.GetCircuitWithBasicDevices().GetLargeSignalModel();
+			var model = CircuitGenerator.GetCircuitWithBasicDevices().GetLargeSignalModel();
+			model.SimulationParameters.UseModifiedNewton = true;
+
+			AssertSameTransientResult(expected, model, 1e-6);
+			Assert.True(model.TotalModifiedNewtonIterationCount > 0);
+			Assert.Equal(0, expected.TotalModifiedNewtonIterationCount);
+		}
+
+		[Fact]
+		public void TestDeviceBypassDoesNotChangeResult()
+		{
+			var expected = CircuitGenerator.GetCircuitWithBasicDevices().GetLargeSignalModel();
+			var model = CircuitGenerator.GetCircuitWithBasicDevices().GetLargeSignalModel();
+			model.SimulationParameters.UseDeviceBypass = true;
+
+			AssertSameTransientResult(expected, model, 1e-6);
+			var diode = model.Devices.OfType<LargeSignalDiode>().Single();
+			Assert.True(diode.BypassCount > 0);
+			Assert.Equal(diode.BypassCount, model.TotalDeviceBypassCount);
+			Assert.Equal(0, expected.TotalDeviceBypassCount);
+		}
+
+		private static LargeSignalCircuitModel GetMultiRectifierModel()
+		{
+			// four half-wave rectifiers with different loads driven by the same source
+			var builder = new CircuitBuilder()
+				.AddResistor(1, 0, 1e3)
+				.AddVoltageSource(1, 0, new SinusoidalBehavior {DcOffset = 1, Amplitude = 5, Frequency = 1e5});
+			for (var i = 0; i < 4; i++)
+				builder
+					.AddResistor(1, 2 + i, 100)
+					.AddDiode(2 + i, 6 + i, DiodeParams.D1N4148)
+					.AddCapacitor(6 + i, 0, 1e-7 * (i + 1))
+					.AddResistor(6 + i, 0, 1e3 * (i + 1));
+			return builder.BuildCircuit().GetLargeSignalModel();
+		}
+
+		[Theory]
+		[InlineData(true, 2)]
+		[InlineData(false, 2)]
+		[InlineData(false, 5)]
+		public void TestParallelAssemblyGivesSameResult(bool cacheLinearStamps, int threadCount)
+		{
+			// there are enough stamped devices for each thread even if the linear stamps are cached
+			var expected = GetMultiRectifierModel();
+			expected.SimulationParameters.CacheLinearStamps = cacheLinearStamps;
+			var model = GetMultiRectifierModel();
+			model.SimulationParameters.CacheLinearStamps = cacheLinearStamps;
+			model.SimulationParameters.UseParallelAssembly = true;
+			model.SimulationParameters.AssemblyThreadCount = threadCount;
+
+			// the stamps may be summed in different order than in the serial evaluation
+			AssertSameTransientResult(expected, model, 1e-12);
+			Assert.Equal(expected.TotalNonLinearIterationCount, model.TotalNonLinearIterationCount);
+		}
+
+		[Fact]
+		public void TestParallelAssemblyRecoversFromNaNStamp()
+		{
+			try
+			{
+				// unlike the dense adapters, the sparse adapter refuses NaN already when the stamps are added
+				EquationSystemAdapterFactory.SetFactory(() => new SparseEquationSystemAdapter());
+				using (var expected = GetMultiRectifierModel())
+				using (var model = GetMultiRectifierModel())
+				{
+					// the cached stamps would keep the NaN
+					expected.SimulationParameters.CacheLinearStamps = false;
+					model.SimulationParameters.CacheLinearStamps = false;
+					model.SimulationParameters.UseParallelAssembly = true;
+					model.SimulationParameters.AssemblyThreadCount = 2;
+
+					// the serial assembly discards the stamps of the failed timepoint with the equation system,
+					// the parallel assembly must not leave them in the buffer either
+					foreach (var m in new[] {expected, model})
+					{
+						m.EstablishDcBias();
+						// series resistor of the second rectifier
+						var resistor = m.Devices.OfType<LargeSignalResistor>().ElementAt(3).DefinitionDevice;
+						resistor.Resistance = double.NaN;
+						Assert.Throws<NaNInEquationSystemSolutionException>(() => m.AdvanceInTime(1e-6));
+						resistor.Resistance = 100;
+					}
+
+					// the serial assembly stops at the failing device, so the other devices may have linearized
+					// their models differently and the solutions agree only within the Newton-Raphson tolerance
+					AssertSameTimePoints(expected, model, 1e-6);
+				}
+			}
+			finally
+			{
+				EquationSystemAdapterFactory.SetFactory(() => new DdEquationSystemAdapter());
+			}
+		}
+
+		private static LargeSignalCircuitModel GetRcDischargeModel()
+		{
+			// capacitor charged to 1V discharging with time constant 1ms
+			return new CircuitBuilder()
+				.AddCapacitor(1, 0, 1e-6, 1)
+				.AddResistor(1, 0, 1e3)
+				.BuildCircuit()
+				.GetLargeSignalModel();
+		}
+
+		[Theory]
+		[InlineData(0)]
+		[InlineData(1)]
+		[InlineData(2)]
+		[InlineData(3)]
+		public void TestAdaptiveTimeStepFollowsExactSolution(int method)
+		{
+			var model = GetRcDischargeModel();
+			var methods = new IIntegrationMethodFactory[]
+			{
+				new SimpleIntegrationMethodFactory(() => new BackwardEulerIntegrationMethod()),
+				new SimpleIntegrationMethodFactory(() => new TrapezoidalIntegrationMethod()),
+				new SimpleIntegrationMethodFactory(() => new GearIntegrationMethod(2)),
+				new BdfIntegrationMethodFactory(BdfCoefficients.MaxSupportedOrder)
+			};
+			model.SimulationParameters.IntegrationMethodFactory = methods[method];
+
+			model.EstablishDcBias();
+			model.NextTimeStep = 1e-6;
+			var initialVoltage = model.NodeVoltages[1];
+
+			var steps = 0;
+			while (model.CurrentTimePoint < 5e-3)
+			{
+				model.AdvanceInTimeAdaptively(5e-3 - model.CurrentTimePoint);
+				steps++;
+
+				Assert.Equal(initialVoltage * Math.Exp(-model.CurrentTimePoint / 1e-3), model.NodeVoltages[1],
+					new DoubleComparer(2e-2));
+			}
+
+			// fixed timestep would need 500 steps for similar accuracy
+			Assert.True(steps < 100, $"{steps} steps");
+			Assert.Equal(5e-3, model.CurrentTimePoint, 12);
+		}
+
+		[Fact]
+		public void TestVariableOrderBdfRaisesOrder()
+		{
+			var model = GetRcDischargeModel();
+			var factory = new BdfIntegrationMethodFactory(BdfCoefficients.MaxSupportedOrder);
+			model.SimulationParameters.IntegrationMethodFactory = factory;
+
+			model.EstablishDcBias();
+			model.NextTimeStep = 1e-6;
+
+			var maxOrder = 0;
+			var steps = 0;
+			while (model.CurrentTimePoint < 5e-3)
+			{
+				model.AdvanceInTimeAdaptively(5e-3 - model.CurrentTimePoint);
+				maxOrder = Math.Max(maxOrder, factory.Coefficients.Order);
+				steps++;
+			}
+
+			// higher order allows longer steps than the second order Gear method
+			Assert.True(maxOrder > 2, $"order {maxOrder}");
+			Assert.True(steps < 26, $"{steps} steps");
+		}
+
+		[Fact]
+		public void TestRejectedTimeStepIsRolledBack()
+		{
+			var model = GetRcDischargeModel();
+			model.EstablishDcBias();
+			model.NextTimeStep = 1e-6;
+			var initialVoltage = model.NodeVoltages[1];
+
+			for (var i = 0; i < 10; i++)
+				model.AdvanceInTimeAdaptively(1);
+			Assert.Equal(0, model.RejectedTimeStepCount);
+
+			// far too long step is rejected and shortened
+			var timePoint = model.CurrentTimePoint;
+			model.NextTimeStep = 1e-3;
+			var timestep = model.AdvanceInTimeAdaptively(1);
+
+			Assert.True(model.RejectedTimeStepCount > 0);
+			Assert.True(timestep < 1e-3);
+			Assert.Equal(timePoint + timestep, model.CurrentTimePoint);
+			Assert.Equal(initialVoltage * Math.Exp(-model.CurrentTimePoint / 1e-3), model.NodeVoltages[1],
+				new DoubleComparer(1e-2));
+		}
+
+		[Fact]
+		public void TestAdaptiveTimeStepLandsOnBreakpoints()
+		{
+			// RC circuit charged by 1V pulse with 1us edges
+			var model = new CircuitBuilder()
+				.AddVoltageSource(1, 0, new PulseBehavior
+				{
+					InitialLevel = 0,
+					PulseLevel = 1,
+					Delay = 1e-3,
+					TimeRise = 1e-6,
+					PulseWidth = 2e-3,
+					TimeFall = 1e-6
+				})
+				.AddResistor(1, 2, 1e3)
+				.AddCapacitor(2, 0, 1e-6)
+				.BuildCircuit()
+				.GetLargeSignalModel();
+
+			model.EstablishDcBias();
+			model.NextTimeStep = 1e-6;
+
+			var timePoints = new List<double>();
+			var voltages = new List<double>();
+			while (model.CurrentTimePoint < 4e-3)
+			{
+				model.AdvanceInTimeAdaptively(4e-3 - model.CurrentTimePoint);
+				timePoints.Add(model.CurrentTimePoint);
+				voltages.Add(model.NodeVoltages[2]);
+			}
+
+			foreach (var corner in new[] {1e-3, 1.001e-3, 3.001e-3, 3.002e-3})
+				Assert.True(timePoints.Any(t => Math.Abs(t - corner) < 1e-15), $"{corner} not found");
+
+			// the edge is not stepped over, the capacitor is charged from the middle of the rising edge
+			var end = timePoints.FindIndex(t => Math.Abs(t - 3.001e-3) < 1e-15);
+			Assert.Equal(1 - Math.Exp(-2.0005), voltages[end], new DoubleComparer(1e-2));
+		}
+
+		private static LargeSignalCircuitModel GetRectifierModel()
+		{
+			// half-wave rectifier with RC load driven by 1kHz sine
+			return new CircuitBuilder()
+				.AddVoltageSource(1, 0, new SinusoidalBehavior {Amplitude = 5, Frequency = 1e3})
+				.AddResistor(1, 2, 100)
+				.AddDiode(2, 3, DiodeParams.D1N4148)
+				.AddCapacitor(3, 0, 1e-6)
+				.AddResistor(3, 0, 1e4)
+				.BuildCircuit()
+				.GetLargeSignalModel();
+		}
+
+		[Fact]
+		public void TestNewtonPredictorReducesIterationCount()
+		{
+			var models = new[] {GetRectifierModel(), GetRectifierModel()};
+			models[1].SimulationParameters.UseNewtonPredictor = true;
+
+			foreach (var model in models) model.EstablishDcBias();
+			var iterations = new int[models.Length];
+
+			for (var i = 0; i < 3000; i++)
+			for (var j = 0; j < models.Length; j++)
+			{
+				models[j].AdvanceInTime(1e-6);
+				iterations[j] += models[j].LastNonLinearIterationCount;
+
+				Assert.Equal(models[0].NodeVoltages[3], models[j].NodeVoltages[3], new DoubleComparer(1e-4));
+			}
+
+			Assert.True(double.IsNaN(models[0].LastPredictorDistance));
+			Assert.False(double.IsNaN(models[1].LastPredictorDistance));
+
+			// starting from the extrapolated solution, most timepoints need only single solution
+			Output.WriteLine($"Iterations without predictor: {iterations[0]}, with predictor: {iterations[1]}");
+			Assert.True(iterations[1] < 0.6 * iterations[0]);
+		}
+
+		[Fact]
+		public void TestCapacitorCompanionModelMatchesBranchCurrentModel()
+		{
+			var models = new[] {GetRectifierModel(), GetRectifierModel()};
+			models[0].SimulationParameters.UseCapacitorBranchCurrents = true;
+
+			foreach (var model in models) model.EstablishDcBias();
+			var capacitors = models.Select(m => m.Devices.OfType<LargeSignalCapacitor>().Single()).ToArray();
+
+			for (var i = 0; i < 1000; i++)
+			{
+				foreach (var model in models) model.AdvanceInTime(1e-6);
+
+				Assert.Equal(models[0].NodeVoltages[3], models[1].NodeVoltages[3], new DoubleComparer(1e-9));
+				Assert.Equal(capacitors[0].Current, capacitors[1].Current, new DoubleComparer(1e-9));
+			}
+
+			// the capacitor discharges into the load resistor
+			Assert.True(capacitors[1].Current < -1e-4);
+		}
+
+		[Fact]
+		public void TestBjtCapacitorCompanionModelMatchesBranchCurrentModel()
+		{
+			var adapters = new List<IEquationSystemAdapterWide>();
+			var models = new LargeSignalCircuitModel[2];
+
+			try
+			{
+				EquationSystemAdapterFactory.SetFactory(() =>
+				{
+					var adapter = new DdEquationSystemAdapter();
+					adapters.Add(adapter);
+					return adapter;
+				});
+
+				for (var i = 0; i < models.Length; i++)
+				{
+					// common emitter amplifier, the substrate is connected to the ground
+					models[i] = new CircuitBuilder()
+						.AddVoltageSource(1, 0, 6)
+						.AddResistor(1, 2, 5e3)
+						.AddVoltageSource(3, 0, new SinusoidalBehavior {DcOffset = 0.7, Amplitude = 0.05, Frequency = 1e6})
+						.AddBjt(2, 3, 0, p =>
+						{
+							p.CollectorCapacitance = 1e-12;
+							p.SubstrateCapacitance = 1e-12;
+							p.ForwardTransitTime = 1e-9;
+						})
+						.BuildCircuit()
+						.GetLargeSignalModel();
+					models[i].SimulationParameters.UseCapacitorBranchCurrents = i == 0;
+					models[i].EstablishDcBias();
+				}
+			}
+			finally
+			{
+				EquationSystemAdapterFactory.SetFactory(() => new DdEquationSystemAdapter());
+			}
+
+			// the companion model needs no branch variables for the BE, BC and CS capacitances
+			Assert.Equal(adapters[0].VariableCount - 3, adapters[1].VariableCount);
+
+			var bjts = models.Select(m => m.Devices.OfType<LargeSignalBjt>().Single()).ToArray();
+			for (var i = 0; i < 1000; i++)
+			{
+				foreach (var model in models) model.AdvanceInTime(1e-9);
+
+				Assert.Equal(models[0].NodeVoltages[2], models[1].NodeVoltages[2], new DoubleComparer(1e-9));
+				Assert.Equal(bjts[0].CurrentCollector, bjts[1].CurrentCollector, new DoubleComparer(1e-9));
+			}
+		}
 	}
 }
\ No newline at end of file
@@ -0,0 +1,117 @@
+using System;
+using System.Linq;
+using NextGenSpice.Numerics;
+using NextGenSpice.Numerics.Precision;
+using Xunit;
+
+namespace NextGenSpice.LargeSignal.Test
+{
+	public class VectorMathTests
+	{
+		// odd count so that the tail of the arrays is processed separately from the vectorized part
+		private const int count = 2001;
+
+		private static double[] GetRandomVector(Random random, double min, double max)
+		{
+			return Enumerable.Range(0, count).Select(_ => min + random.NextDouble() * (max - min)).ToArray();
+		}
+
+		// distance of the result from the exactly computed value in units in the last place of the result
+		private static double GetUlpError(double actual, qd_real expected)
+		{
+			var rounded = Math.Abs((double) expected);
+			var ulp = BitConverter.Int64BitsToDouble(BitConverter.DoubleToInt64Bits(rounded) + 1) - rounded;
+			return Math.Abs((double) (new qd_real(actual) - expected)) / ulp;
+		}
+
+		[Fact]
+		public void ExpIsWithinOneUlp()
+		{
+			// qd_real exp underflows below -708
+			var x = GetRandomVector(new Random(42), -700, 700);
+			var result = new double[count];
+			VectorMath.Exp(x, result);
+
+			for (var i = 0; i < count; i++)
+				Assert.True(GetUlpError(result[i], new qd_real(x[i]).Exp()) <= 1, $"exp({x[i]:R}) = {result[i]:R}");
+		}
+
+		[Fact]
+		public void LogIsWithinOneUlp()
+		{
+			var random = new Random(42);
+			// qd_real log overflows for huge arguments
+			var x = GetRandomVector(random, -990, 990).Select(e => Math.Pow(2, e)).Concat(GetRandomVector(random, 0.5, 2))
+				.ToArray();
+			var result = new double[x.Length];
+			VectorMath.Log(x, result);
+
+			for (var i = 0; i < x.Length; i++)
+				Assert.True(GetUlpError(result[i], new qd_real(x[i]).Log()) <= 1, $"log({x[i]:R}) = {result[i]:R}");
+		}
+
+		[Theory]
+		[InlineData(1)]
+		[InlineData(16)]
+		[InlineData(64)]
+		public void PowIsWithinTwoUlp(double maxExponent)
+		{
+			var random = new Random(42);
+			var x = GetRandomVector(random, -1, 1).Select(e => Math.Pow(2, e * 600 / maxExponent)).ToArray();
+			var y = GetRandomVector(random, -maxExponent, maxExponent);
+			var result = new double[count];
+			VectorMath.Pow(x, y, result);
+
+			for (var i = 0; i < count; i++)
+				Assert.True(GetUlpError(result[i], (new qd_real(x[i]).Log() * y[i]).Exp()) <= 2,
+					$"pow({x[i]:R}, {y[i]:R}) = {result[i]:R}");
+		}
+
+		[Fact]
+		public void PowSaturatesForLargeExponents()
+		{
+			// |y * log(x)| is far beyond the range of exp, the results are exactly 0 or infinity
+			var random = new Random(42);
+			var x = GetRandomVector(random, 0.01, 8).Select(e => Math.Pow(2, random.Next(2) == 0 ? e : -e))
+				.Concat(new[] {3, 6.89, 0.0509, -3, -0.5}).ToArray();
+			var y = GetRandomVector(random, 10, 22).Select(e => Math.Pow(10, e) * (random.Next(2) == 0 ? 1 : -1))
+				.Concat(new[] {1e20, -4.66e20, 3.2e19, 1e20, -1e20}).ToArray();
+			var result = new double[x.Length];
+			VectorMath.Pow(x, y, result);
+
+			Assert.Equal(x.Zip(y, Math.Pow), result);
+		}
+
+		[Fact]
+		public void SpecialValuesMatchMathFunctions()
+		{
+			var x = new[]
+			{
+				0, -0.0, -1, 1, double.PositiveInfinity, double.NegativeInfinity, double.NaN, double.Epsilon,
+				709.782712893384, 709.79, -745.1, -745.2, -740
+			};
+
+			var exp = x.ToArray();
+			VectorMath.Exp(exp, exp);
+			Assert.Equal(x.Select(v => Math.Exp(v)), exp);
+
+			var log = x.ToArray();
+			VectorMath.Log(log, log);
+			Assert.Equal(x.Select(v => Math.Log(v)), log);
+
+			var bases = new[]
+			{
+				0, 0, 0, double.PositiveInfinity, double.PositiveInfinity, 1, double.NaN, 2, 2, -2, -2, -2, -2, -1, -1,
+				-0.0, -0.0, -0.0, double.NegativeInfinity, double.NegativeInfinity, -0.5, -2
+			};
+			var exponents = new[]
+			{
+				2, -2, 0, 2, -2, double.NaN, 0, 1024, -1074, 3, 2, -3, 0.5, 7, double.PositiveInfinity, 3, -3, 0.5, 3,
+				0.5, double.NegativeInfinity, double.NaN
+			};
+			var pow = new double[bases.Length];
+			VectorMath.Pow(bases, exponents, pow);
+			Assert.Equal(bases.Zip(exponents, Math.Pow), pow);
+		}
+	}
+}
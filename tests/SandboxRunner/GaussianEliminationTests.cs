@@ -189,5 +189,11 @@ namespace SandboxRunner
 		{
 			GaussJordanElimination.Solve_Native_double(system.Matrix, system.RightHandSide, system.Solution);
 		}
+
+		[Benchmark]
+		public void Native_Scalar()
+		{
+			GaussJordanElimination.Solve_NativeScalar_double(system.Matrix, system.RightHandSide, system.Solution);
+		}
 	}
 }
\ No newline at end of file
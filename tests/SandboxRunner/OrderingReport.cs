@@ -0,0 +1,56 @@
+﻿using System;
+using System.IO;
+using NextGenSpice.Core.Exceptions;
+using NextGenSpice.LargeSignal;
+using NextGenSpice.Numerics;
+using NextGenSpice.Numerics.Equations;
+using NextGenSpice.Parser;
+
+namespace SandboxRunner
+{
+	/// <summary>
+	///   Compares fill-in of the sparse LU factors for different column orderings on the profiling circuits. Only a few
+	///   Newton iterations of the operating point are run, the factors are taken from the last one.
+	/// </summary>
+	public static class OrderingReport
+	{
+		private const int iterations = 5;
+
+		private const string path = "..\\..\\..\\..\\..\\SandboxRunner\\ProfileCircuits\\";
+
+		public static void Run()
+		{
+			Run(path);
+		}
+
+		public static void Run(string directory)
+		{
+			Console.WriteLine(
+				$"{"circuit",-12}{"ordering",-15}{"vars",6}{"nnz(A)",8}{"predicted",11}{"nnz(L+U)",10}");
+
+			foreach (var file in Directory.GetFiles(directory, "*.sp"))
+			foreach (SparseOrdering ordering in Enum.GetValues(typeof(SparseOrdering)))
+			{
+				SparseEquationSystemAdapter adapter = null;
+				EquationSystemAdapterFactory.SetFactory(() => adapter = new SparseEquationSystemAdapter(ordering));
+
+				var result = SpiceNetlistParser.WithDefaults().Parse(new StreamReader(file));
+				var model = result.CircuitDefinition.GetLargeSignalModel();
+				model.MaxDcPointIterations = iterations;
+				try
+				{
+					model.EstablishDcBias();
+				}
+				catch (SimulationException)
+				{
+					// the operating point is not needed
+				}
+
+				Console.WriteLine(
+					$"{Path.GetFileNameWithoutExtension(file),-12}{ordering,-15}{adapter.VariableCount,6}{adapter.NonzeroCount,8}{adapter.PredictedFactorNonzeroCount,11}{adapter.FactorNonzeroCount,10}");
+			}
+
+			EquationSystemAdapterFactory.SetFactory(() => new DdEquationSystemAdapter());
+		}
+	}
+}
@@ -0,0 +1,52 @@
+using BenchmarkDotNet.Attributes;
+using BenchmarkDotNet.Attributes.Jobs;
+using NextGenSpice.Core.Test;
+using NextGenSpice.LargeSignal;
+using NextGenSpice.Numerics.Equations;
+
+namespace SandboxRunner
+{
+	/// <summary>
+	///   Measures scaling of the parallel LU factorization with number of threads on DC operating point of resistor
+	///   meshes. Each Newton iteration refactors the whole dense equation matrix.
+	/// </summary>
+	[CoreJob]
+	public class ParallelLuBenchmarks
+	{
+		private LargeSignalCircuitModel model;
+
+		[Params(20, 30, 40)] public int MeshSize;
+
+		/// <summary>Number of threads of the parallel factorization, 0 stands for the serial factorization.</summary>
+		[Params(0, 1, 2, 4, 8, 16, 32)] public int Threads;
+
+		[IterationSetup]
+		public void Setup()
+		{
+			if (Threads == 0)
+				EquationSystemAdapterFactory.SetFactory(() => new EquationSystemAdapter {ReuseFactorization = true});
+			else
+				EquationSystemAdapterFactory.SetFactory(() => new EquationSystemAdapter
+				{
+					UseParallelFactorization = true,
+					ThreadCount = Threads,
+					SerialCutoff = 0
+				});
+			model = CircuitGenerator.GetMeshCircuit(MeshSize).GetLargeSignalModel();
+		}
+
+		[IterationCleanup]
+		public void Cleanup()
+		{
+			// releases the threads of the parallel factorization
+			model.Dispose();
+		}
+
+		[Benchmark(Description = "LU factorization")]
+		public int EstablishDcBias()
+		{
+			model.EstablishDcBias();
+			return model.LastNonLinearIterationCount;
+		}
+	}
+}
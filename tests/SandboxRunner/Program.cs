@@ -22,9 +22,12 @@ namespace SandboxRunner
 //            PrintFileSizes(); return;
 //            Examples.ResistorSweep(); return;
 //            Examples.SimpleRlc(); return;
+//            OrderingReport.Run(); return;
 			var summary = BenchmarkRunner.Run<PrecisionBenchmarks>();
 //            var summary = BenchmarkRunner.Run<GaussianEliminationTests>(); return;
 //            var summary = BenchmarkRunner.Run<PInvokeOverheadTest>(); return;
+//            var summary = BenchmarkRunner.Run<ParallelLuBenchmarks>(); return;
+//            var summary = BenchmarkRunner.Run<VectorMathBenchmarks>(); return;
 			//            IntegrationTest.Run();
 
 //            Console.WriteLine(sw.Elapsed);
@@ -0,0 +1,74 @@
+using System;
+using System.Linq;
+using BenchmarkDotNet.Attributes;
+using BenchmarkDotNet.Attributes.Jobs;
+using NextGenSpice.Numerics;
+
+namespace SandboxRunner
+{
+	/// <summary>
+	///   Measures throughput of the native vectorized elementary functions compared to calling the
+	///   <see cref="Math" /> functions element by element.
+	/// </summary>
+	[CoreJob]
+	public class VectorMathBenchmarks
+	{
+		private double[] exponents;
+		private double[] result;
+		private double[] x;
+
+		[Params(16, 1024, 65536)] public int N;
+
+		[GlobalSetup]
+		public void Setup()
+		{
+			var random = new Random(42);
+			// typical range of junction voltages divided by thermal voltage
+			x = Enumerable.Range(0, N).Select(_ => random.NextDouble() * 60 - 30).ToArray();
+			exponents = Enumerable.Range(0, N).Select(_ => random.NextDouble()).ToArray();
+			result = new double[N];
+		}
+
+		[Benchmark(Description = "Math.Exp", Baseline = true)]
+		public double[] ManagedExp()
+		{
+			for (var i = 0; i < x.Length; i++) result[i] = Math.Exp(x[i]);
+			return result;
+		}
+
+		[Benchmark(Description = "VectorMath.Exp")]
+		public double[] NativeExp()
+		{
+			VectorMath.Exp(x, result);
+			return result;
+		}
+
+		[Benchmark(Description = "Math.Log")]
+		public double[] ManagedLog()
+		{
+			for (var i = 0; i < exponents.Length; i++) result[i] = Math.Log(exponents[i]);
+			return result;
+		}
+
+		[Benchmark(Description = "VectorMath.Log")]
+		public double[] NativeLog()
+		{
+			VectorMath.Log(exponents, result);
+			return result;
+		}
+
+		[Benchmark(Description = "Math.Pow")]
+		public double[] ManagedPow()
+		{
+			for (var i = 0; i < exponents.Length; i++) result[i] = Math.Pow(exponents[i], x[i]);
+			return result;
+		}
+
+		[Benchmark(Description = "VectorMath.Pow")]
+		public double[] NativePow()
+		{
+			VectorMath.Pow(exponents, x, result);
+			return result;
+		}
+	}
+}